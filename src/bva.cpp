@@ -71,7 +71,7 @@ bool BVA::bounded_var_addition()
     for(size_t i = 0; i < solver->nVars()*2; i++) {
         const Lit lit = Lit::toLit(i);
         if (solver->value(lit) != l_Undef
-            || solver->varData[lit.var()].removed != Removed::none
+            || solver->varFlags.removed(lit.var()) != Removed::none
         ) {
             continue;
         }
@@ -240,7 +240,7 @@ void BVA::remove_duplicates_from_m_cls()
 bool BVA::try_bva_on_lit(const Lit lit)
 {
     assert(solver->value(lit) == l_Undef);
-    assert(solver->varData[lit.var()].removed == Removed::none);
+    assert(solver->varFlags.removed(lit.var()) == Removed::none);
 
     m_cls.clear();
     m_lits.clear();
@@ -522,8 +522,14 @@ bool BVA::add_longer_clause(const Lit new_lit, const OccurClause& cl)
                     lits[i] = orig_cl[i];
                 }
             }
+            #ifdef STATS_NEEDED
+            const ClauseStatsExtra extra = solver->cl_alloc.extra_stats(orig_cl);
+            #endif
             Clause* newCl = solver->add_clause_int(lits, false, orig_cl.stats, false, &lits, true, new_lit);
             if (newCl != NULL) {
+                #ifdef STATS_NEEDED
+                solver->cl_alloc.extra_stats(*newCl) = extra;
+                #endif
                 simplifier->linkInClause(*newCl);
                 ClOffset offset = solver->cl_alloc.get_offset(newCl);
                 simplifier->clauses.push_back(offset);
@@ -117,9 +117,6 @@ struct ClauseStats
     ClauseStats()
     {
         memset(this, 0, sizeof(ClauseStats));
-        #ifdef STATS_NEEDED
-        ID = 1;
-        #endif
         which_red_array = 1;
         glue = 1000;
         activity = 0;
@@ -133,16 +130,6 @@ struct ClauseStats
     uint32_t ttl:2;
     uint32_t which_red_array:2;
     float   activity = 0.0;
-    #ifdef STATS_NEEDED
-    int64_t ID;
-    uint64_t introduced_at_conflict = 0; ///<At what conflict number the clause  was introduced
-    uint64_t conflicts_made = 0; ///<Number of times caused conflict
-    uint64_t sum_of_branch_depth_conflict = 0;
-    uint64_t propagations_made = 0; ///<Number of times caused propagation
-    uint64_t clause_looked_at = 0; ///<Number of times the clause has been deferenced during propagation
-    uint64_t used_for_uip_creation = 0; ///Number of times the claue was using during 1st UIP generation
-    AtecedentData<uint16_t> antec_data;
-    #endif
 
     static ClauseStats combineStats(const ClauseStats& first, const ClauseStats& second)
     {
@@ -152,14 +139,6 @@ struct ClauseStats
         //Combine stats
         ret.glue = std::min(first.glue, second.glue);
         ret.activity = std::max(first.activity, second.activity);
-        #ifdef STATS_NEEDED
-        ret.introduced_at_conflict = std::min(first.introduced_at_conflict, second.introduced_at_conflict);
-        ret.conflicts_made = first.conflicts_made + second.conflicts_made;
-        ret.sum_of_branch_depth_conflict = first.sum_of_branch_depth_conflict  + second.sum_of_branch_depth_conflict;
-        ret.propagations_made = first.propagations_made + second.propagations_made;
-        ret.clause_looked_at = first.clause_looked_at + second.clause_looked_at;
-        ret.used_for_uip_creation = first.used_for_uip_creation + second.used_for_uip_creation;
-        #endif
         ret.which_red_array = std::min(first.which_red_array, second.which_red_array);
 
         return ret;
@@ -170,16 +149,50 @@ inline std::ostream& operator<<(std::ostream& os, const ClauseStats& stats)
 {
 
     os << "glue " << stats.glue << " ";
-    #ifdef STATS_NEEDED
+
+    return os;
+}
+
+#ifdef STATS_NEEDED
+/**
+@brief Statistics of a clause only needed for data gathering
+
+These are not stored in the clause but in a side table of the ClauseAllocator,
+so the clause header stays small. See ClauseAllocator::extra_stats()
+*/
+struct ClauseStatsExtra
+{
+    int64_t ID = 1;
+    uint64_t introduced_at_conflict = 0; ///<At what conflict number the clause  was introduced
+    uint64_t conflicts_made = 0; ///<Number of times caused conflict
+    uint64_t sum_of_branch_depth_conflict = 0;
+    uint64_t propagations_made = 0; ///<Number of times caused propagation
+    uint64_t clause_looked_at = 0; ///<Number of times the clause has been deferenced during propagation
+    uint64_t used_for_uip_creation = 0; ///Number of times the claue was using during 1st UIP generation
+    AtecedentData<uint16_t> antec_data;
+
+    void combine(const ClauseStatsExtra& other)
+    {
+        introduced_at_conflict = std::min(introduced_at_conflict, other.introduced_at_conflict);
+        conflicts_made += other.conflicts_made;
+        sum_of_branch_depth_conflict += other.sum_of_branch_depth_conflict;
+        propagations_made += other.propagations_made;
+        clause_looked_at += other.clause_looked_at;
+        used_for_uip_creation += other.used_for_uip_creation;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const ClauseStatsExtra& stats)
+{
     os << "conflIntro " << stats.introduced_at_conflict<< " ";
     os << "numConfl " << stats.conflicts_made<< " ";
     os << "numProp " << stats.propagations_made<< " ";
     os << "numLook " << stats.clause_looked_at<< " ";
     os << "used_for_uip_creation" << stats.used_for_uip_creation << " ";
-    #endif
 
     return os;
 }
+#endif
 
 /**
 @brief Holds a clause. Does not allocate space for literals
@@ -217,21 +230,21 @@ public:
     cl_abst_type abst;
     ClauseStats stats;
     uint32_t mySize;
+    #ifdef STATS_NEEDED
+    uint32_t stats_slot; ///<Index of ClauseStatsExtra in the ClauseAllocator
+    #endif
 
     template<class V>
     Clause(const V& ps
         #ifdef STATS_NEEDED
-        , const uint32_t _introduced_at_conflict
-        , const int64_t _ID
+        , const uint32_t _stats_slot
         #endif
         )
     {
         //assert(ps.size() > 2);
 
         #ifdef STATS_NEEDED
-        stats.introduced_at_conflict = _introduced_at_conflict;
-        stats.ID = _ID;
-        assert(_ID >= 0);
+        stats_slot = _stats_slot;
         #endif
         stats.glue = std::min<uint32_t>(stats.glue, ps.size());
         isFreed = false;
@@ -429,7 +442,11 @@ public:
         occurLinked = toset;
     }
 
-    void print_extra_stats() const
+    void print_extra_stats(
+        #ifdef STATS_NEEDED
+        const ClauseStatsExtra& extra
+        #endif
+    ) const
     {
         cout
         << "Clause size " << std::setw(4) << size();
@@ -438,10 +455,10 @@ public:
         }
         #ifdef STATS_NEEDED
         cout
-        << " Confls: " << std::setw(10) << stats.conflicts_made
-        << " Props: " << std::setw(10) << stats.propagations_made
-        << " Looked at: " << std::setw(10)<< stats.clause_looked_at
-        << " UIP used: " << std::setw(10)<< stats.used_for_uip_creation;
+        << " Confls: " << std::setw(10) << extra.conflicts_made
+        << " Props: " << std::setw(10) << extra.propagations_made
+        << " Looked at: " << std::setw(10)<< extra.clause_looked_at
+        << " UIP used: " << std::setw(10)<< extra.used_for_uip_creation;
         #endif
         cout << endl;
     }
@@ -42,6 +42,12 @@ THE SOFTWARE.
 #include "valgrind/memcheck.h"
 #endif
 
+#ifdef USE_HUGEPAGES
+#include <sys/mman.h>
+#include <fstream>
+#include <sstream>
+#endif
+
 using namespace CMSat;
 
 using std::pair;
@@ -58,16 +64,111 @@ using std::endl;
 #define MIN_LIST_SIZE (50000 * (sizeof(Clause) + 4*sizeof(Lit))/sizeof(uint32_t))
 #define ALLOC_GROW_MULT 1.5
 //We shift stuff around in Watched, so not all of 32 bits are useable.
+//Offsets are scaled by CL_OFFSET_SHIFT, so the arena can have more words.
 #define EFFECTIVELY_USEABLE_BITS 30
-#define MAXSIZE ((1 << (EFFECTIVELY_USEABLE_BITS))-1)
+#define MAXSIZE ((1ULL << (EFFECTIVELY_USEABLE_BITS + CL_OFFSET_SHIFT))-1)
+
+#ifdef USE_HUGEPAGES
+#define HUGE_PAGE_SIZE (2ULL*1024ULL*1024ULL)
+
+static size_t mapped_bytes(const size_t bytes)
+{
+    return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+//Maps a region starting at a 2MB boundary. mmap only guarantees 4KB
+//alignment, so we map an extra huge page and unmap the slack at both ends
+static void* map_aligned(const size_t bytes)
+{
+    const size_t len = mapped_bytes(bytes);
+    void* raw = mmap(NULL, len + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE
+        , MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED) {
+        return MAP_FAILED;
+    }
+
+    const uintptr_t from = (uintptr_t)raw;
+    const uintptr_t start = (from + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    if (start > from) {
+        munmap(raw, start - from);
+    }
+    const uintptr_t slack_end = from + len + HUGE_PAGE_SIZE;
+    if (slack_end > start + len) {
+        munmap((void*)(start + len), slack_end - (start + len));
+    }
+
+    return (void*)start;
+}
+
+/**
+@brief Maps or re-maps the stack as anonymous memory backed by huge pages
+
+The mapping is always a multiple of 2MB and starts at a 2MB boundary, so that
+all of it can be backed by transparent huge pages. Growing is done with
+mremap, which does not need to copy the data. If it cannot grow in place, the
+pages are moved to a freshly mapped aligned region.
+*/
+static void* arena_realloc(void* ptr, const size_t old_bytes, const size_t new_bytes)
+{
+    void* mem;
+    if (ptr == NULL || old_bytes == 0) {
+        //An empty arena has nothing mapped
+        if (new_bytes == 0) {
+            return NULL;
+        }
+        mem = map_aligned(new_bytes);
+    } else {
+        mem = mremap(ptr, mapped_bytes(old_bytes), mapped_bytes(new_bytes), 0);
+        if (mem == MAP_FAILED) {
+            void* dest = map_aligned(new_bytes);
+            if (dest == MAP_FAILED) {
+                return NULL;
+            }
+            mem = mremap(ptr, mapped_bytes(old_bytes), mapped_bytes(new_bytes)
+                , MREMAP_MAYMOVE | MREMAP_FIXED, dest);
+            if (mem == MAP_FAILED) {
+                munmap(dest, mapped_bytes(new_bytes));
+            }
+        }
+    }
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+    assert(((uintptr_t)mem & (HUGE_PAGE_SIZE - 1)) == 0);
+    madvise(mem, mapped_bytes(new_bytes), MADV_HUGEPAGE);
+
+    return mem;
+}
+
+static void arena_free(void* ptr, const size_t bytes)
+{
+    if (ptr != NULL && bytes > 0) {
+        munmap(ptr, mapped_bytes(bytes));
+    }
+}
+
+#else
+static void* arena_realloc(void* ptr, const size_t /*old_bytes*/, const size_t new_bytes)
+{
+    return realloc(ptr, new_bytes);
+}
+
+static void arena_free(void* ptr, const size_t /*bytes*/)
+{
+    free(ptr);
+}
+#endif //USE_HUGEPAGES
 
 ClauseAllocator::ClauseAllocator() :
     dataStart(NULL)
     , size(0)
     , capacity(0)
     , currentlyUsedSize(0)
+    , alloc_at(0)
+    , alloc_end(0)
 {
     assert(MIN_LIST_SIZE < MAXSIZE);
+    assert(CL_CHUNK_BITS >= CL_OFFSET_SHIFT);
 }
 
 /**
@@ -75,17 +176,24 @@ ClauseAllocator::ClauseAllocator() :
 */
 ClauseAllocator::~ClauseAllocator()
 {
-    free(dataStart);
+    arena_free(dataStart, capacity*sizeof(BASE_DATA_TYPE));
 }
 
-void* ClauseAllocator::allocEnough(
-    uint32_t clauseSize
-) {
-    //Try to quickly find a place at the end of a dataStart
-    uint32_t neededbytes = (sizeof(Clause) + sizeof(Lit)*clauseSize);
-    uint32_t needed
+size_t ClauseAllocator::words_needed(const size_t num_lits)
+{
+    const size_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
+    size_t needed
         = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
 
+    //Round up so the next clause starts at an addressable offset
+    const size_t align = (size_t)1 << CL_OFFSET_SHIFT;
+    needed = (needed + align - 1) & ~(align - 1);
+
+    return needed;
+}
+
+size_t ClauseAllocator::alloc_at_end(const size_t needed)
+{
     if (size + needed > capacity) {
         //Grow by default, but don't go under or over the limits
         size_t newcapacity = capacity * ALLOC_GROW_MULT;
@@ -106,8 +214,9 @@ void* ClauseAllocator::allocEnough(
         }
 
         //Reallocate data
-        dataStart = (BASE_DATA_TYPE*)realloc(
+        dataStart = (BASE_DATA_TYPE*)arena_realloc(
             dataStart
+            , capacity*sizeof(BASE_DATA_TYPE)
             , newcapacity*sizeof(BASE_DATA_TYPE)
         );
 
@@ -124,23 +233,98 @@ void* ClauseAllocator::allocEnough(
         capacity = newcapacity;
     }
 
-    //Add clause to the set
-    Clause* pointer = (Clause*)(dataStart + size);
+    const size_t at = size;
     size += needed;
+    return at;
+}
+
+/**
+@brief Records that a clause of "needed" size has been put at position "at"
+
+Clauses at the end of the stack may cross chunk boundaries. The chunks they
+spill into must not be reused before the spilled part is reused, so we
+remember how much of the start of each such chunk is taken.
+*/
+void ClauseAllocator::note_placed(const size_t at, const size_t needed)
+{
+    const size_t first = chunk_of_word(at);
+    const size_t last = chunk_of_word(at + needed - 1);
+    if (chunk_used.size() <= last) {
+        chunk_used.resize(last+1, 0);
+        chunk_spill.resize(last+1, 0);
+        chunk_free.resize(last+1, 0);
+    }
+    chunk_used[first] += needed;
+    for(size_t c = first+1; c <= last; c++) {
+        chunk_spill[c] = std::min(CL_CHUNK_WORDS, at + needed - (c << CL_CHUNK_BITS));
+    }
+}
+
+void ClauseAllocator::clear_chunks()
+{
+    chunk_used.clear();
+    chunk_spill.clear();
+    chunk_free.clear();
+    free_chunks.clear();
+    alloc_at = 0;
+    alloc_end = 0;
+}
+
+size_t ClauseAllocator::num_free_chunks() const
+{
+    return free_chunks.size();
+}
+
+//Free chunks can only have been evacuated, so nothing spills out of them
+size_t ClauseAllocator::num_stale_spills() const
+{
+    size_t num = 0;
+    for(size_t c = 1; c < chunk_spill.size(); c++) {
+        num += chunk_spill[c] > 0 && chunk_free[c-1];
+    }
+    return num;
+}
+
+void* ClauseAllocator::allocEnough(
+    uint32_t clauseSize
+) {
+    const size_t needed = words_needed(clauseSize);
+
+    //Try to fit into the chunk being reused, or take a new one from the free
+    //list. Otherwise, put it at the end of the stack
+    size_t at;
+    if (alloc_at + needed > alloc_end
+        && needed <= CL_CHUNK_WORDS/2
+        && !free_chunks.empty()
+    ) {
+        const uint32_t c = free_chunks.back();
+        free_chunks.pop_back();
+        chunk_free[c] = false;
+        alloc_at = ((size_t)c << CL_CHUNK_BITS) + chunk_spill[c];
+        alloc_end = (size_t)(c+1) << CL_CHUNK_BITS;
+    }
+
+    if (alloc_at + needed <= alloc_end) {
+        at = alloc_at;
+        alloc_at += needed;
+    } else {
+        at = alloc_at_end(needed);
+    }
+    note_placed(at, needed);
     currentlyUsedSize += needed;
 
-    return pointer;
+    return dataStart + at;
 }
 
 /**
 @brief Given the pointer of the clause it finds a 32-bit offset for it
 
-Calculates the stack frame and the position of the pointer in the stack, and
-rerturns a 32-bit value that is a concatenation of these two
+Calculates the position of the pointer in the stack, in units of the
+clause alignment (see CL_OFFSET_SHIFT)
 */
 ClOffset ClauseAllocator::get_offset(const Clause* ptr) const
 {
-    return ((BASE_DATA_TYPE*)ptr - dataStart);
+    return ((BASE_DATA_TYPE*)ptr - dataStart) >> CL_OFFSET_SHIFT;
 }
 
 /**
@@ -159,17 +343,21 @@ of the clause. Therefore, the "currentlyUsedSizes" is an overestimation!!
 void ClauseAllocator::clauseFree(Clause* cl)
 {
     assert(!cl->freed());
+    #ifdef STATS_NEEDED
+    free_stats_slots.push_back(cl->stats_slot);
+    #endif
 
     bool quick_freed = false;
     #ifdef USE_GAUSS
     if (cl->gauss_temp_cl()) {
-        uint32_t neededbytes = (sizeof(Clause) + sizeof(Lit)*cl->size());
-        uint32_t needed
-            = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+        const size_t needed = words_needed(cl->size());
 
-        if ((uint32_t*)cl == (dataStart + size - needed)) {
+        if ((BASE_DATA_TYPE*)cl == (dataStart + size - needed)
+            && chunk_of_word(size - needed) == chunk_of_word(size - 1)
+        ) {
             size -= needed;
             currentlyUsedSize -= needed;
+            chunk_used[chunk_of_word(size)] -= needed;
             quick_freed = true;
         }
     }
@@ -179,9 +367,9 @@ void ClauseAllocator::clauseFree(Clause* cl)
         cl->setFreed();
         size_t est_sz = cl->size();
         est_sz = std::max(est_sz, (size_t)3); //we sometimes allow gauss to allocate 3-long clauses
-        size_t bytes_freed = (sizeof(Clause) + est_sz*sizeof(Lit));
-        size_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
+        const size_t elems_freed = words_needed(est_sz);
         currentlyUsedSize -= elems_freed;
+        chunk_used[chunk_of_word((BASE_DATA_TYPE*)cl - dataStart)] -= elems_freed;
     }
 
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
@@ -195,16 +383,16 @@ void ClauseAllocator::clauseFree(ClOffset offset)
     clauseFree(cl);
 }
 
-uint32_t ClauseAllocator::move_cl(
-    uint32_t* newDataStart
-    , uint32_t*& new_ptr
+ClOffset ClauseAllocator::move_cl(
+    BASE_DATA_TYPE* newDataStart
+    , BASE_DATA_TYPE*& new_ptr
     , Clause* old
-) const {
-    size_t bytesNeeded = sizeof(Clause) + old->size()*sizeof(Lit);
-    size_t sizeNeeded = bytesNeeded/sizeof(BASE_DATA_TYPE) + (bool)(bytesNeeded % sizeof(BASE_DATA_TYPE));
+) {
+    const size_t sizeNeeded = words_needed(old->size());
     memcpy(new_ptr, old, sizeNeeded*sizeof(BASE_DATA_TYPE));
+    note_placed(new_ptr-newDataStart, sizeNeeded);
 
-    uint32_t new_offset = new_ptr-newDataStart;
+    ClOffset new_offset = (new_ptr-newDataStart) >> CL_OFFSET_SHIFT;
     (*old)[0] = Lit::toLit(new_offset);
     old->reloced = true;
 
@@ -219,11 +407,19 @@ Firstly, the algorithm determines if the number of useless slots is large or
 small compared to the problem size. If it is small, it does nothing. If it is
 large, then it allocates new stacks, copies the non-freed clauses to these new
 stacks, updates all pointers and offsets, and frees the original stacks.
+
+Unless forced, with incremental consolidation only the sparsest chunks are
+evacuated, see consolidate_incremental()
 */
 void ClauseAllocator::consolidate(
     Solver* solver
     , const bool force
 ) {
+    if (!force && solver->conf.doIncrementalConsolidate) {
+        consolidate_incremental(solver);
+        return;
+    }
+
     //If re-allocation is not really neccessary, don't do it
     //Neccesities:
     //1) There is too much memory allocated. Re-allocation will save space
@@ -240,10 +436,19 @@ void ClauseAllocator::consolidate(
     const double myTime = cpuTime();
 
     //Pointers that will be moved along
-    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(currentlyUsedSize*sizeof(BASE_DATA_TYPE));
+    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)arena_realloc(
+        NULL, 0, currentlyUsedSize*sizeof(BASE_DATA_TYPE));
+    if (newDataStart == NULL && currentlyUsedSize > 0) {
+        std::cerr << "ERROR: while allocating space to consolidate clauses" << endl;
+        throw std::bad_alloc();
+    }
     BASE_DATA_TYPE * new_ptr = newDataStart;
+    clear_chunks();
 
     assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
+    if (solver->conf.doLocalityConsolidate) {
+        move_for_locality(solver, newDataStart, new_ptr);
+    }
     for(auto& ws: solver->watches) {
         for(Watched& w: ws) {
             if (w.isClause()) {
@@ -254,7 +459,7 @@ void ClauseAllocator::consolidate(
                     Lit newoffset = (*old)[0];
                     w = Watched(newoffset.toInt(), blocked);
                 } else {
-                    uint32_t new_offset = move_cl(newDataStart, new_ptr, old);
+                    ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
                     w = Watched(new_offset, blocked);
                 }
             }
@@ -287,7 +492,7 @@ void ClauseAllocator::consolidate(
     for (size_t i = 0; i < solver->nVars(); i++) {
         VarData& vdata = solver->varData[i];
         if (vdata.reason.isClause()) {
-            if (vdata.removed == Removed::none
+            if (solver->varFlags.removed(i) == Removed::none
                 && solver->decisionLevel() >= vdata.level
                 && vdata.level != 0
                 && solver->value(i) != l_Undef
@@ -303,11 +508,11 @@ void ClauseAllocator::consolidate(
     }
 
     //Update sizes
-    const uint32_t old_size = size;
+    const size_t old_size = size;
     size = new_ptr-newDataStart;
+    arena_free(dataStart, capacity*sizeof(BASE_DATA_TYPE));
     capacity = currentlyUsedSize;
     currentlyUsedSize = size;
-    free(dataStart);
     dataStart = newDataStart;
 
     const double time_used = cpuTime() - myTime;
@@ -327,6 +532,76 @@ void ClauseAllocator::consolidate(
     }
 }
 
+struct SortHotRedCls
+{
+    SortHotRedCls(const ClauseAllocator& _cl_alloc) :
+        cl_alloc(_cl_alloc)
+    {}
+    const ClauseAllocator& cl_alloc;
+
+    bool operator () (const ClOffset xOff, const ClOffset yOff) const
+    {
+        const Clause* x = cl_alloc.ptr(xOff);
+        const Clause* y = cl_alloc.ptr(yOff);
+        if (x->stats.glue != y->stats.glue) {
+            return x->stats.glue < y->stats.glue;
+        }
+        return x->stats.activity > y->stats.activity;
+    }
+};
+
+/**
+@brief Moves clauses in an order that helps propagation's memory locality
+
+Propagation walks watchlists, so the clauses of the same watchlist, and of
+variables that are propagated together, should be close to one another.
+First, the low-glue kept redundant clauses are put at the front of the new
+stack, best glue first. Then clauses are moved watchlist by watchlist, both
+literals of a variable after one another, in the order of variable activity.
+The caller then moves whatever is left, and fixes up all offsets.
+*/
+void ClauseAllocator::move_for_locality(
+    Solver* solver
+    , BASE_DATA_TYPE* newDataStart
+    , BASE_DATA_TYPE*& new_ptr
+) {
+    vector<ClOffset> hot(solver->longRedCls[0]);
+    std::sort(hot.begin(), hot.end(), SortHotRedCls(*this));
+    for(const ClOffset offs: hot) {
+        Clause* old = ptr(offs);
+        if (!old->reloced) {
+            move_cl(newDataStart, new_ptr, old);
+        }
+    }
+
+    vector<uint32_t> vars;
+    vars.reserve(solver->nVars());
+    for(uint32_t i = 0; i < solver->nVars(); i++) {
+        vars.push_back(i);
+    }
+    const vector<double>& act = solver->activ_glue;
+    if (act.size() >= solver->nVars()) {
+        std::stable_sort(vars.begin(), vars.end(),
+            [&](const uint32_t a, const uint32_t b) {return act[a] > act[b];}
+        );
+    }
+
+    for(const uint32_t var: vars) {
+        for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+            for(const Watched& w: solver->watches[lit]) {
+                if (!w.isClause()) {
+                    continue;
+                }
+                Clause* old = ptr(w.get_offset());
+                assert(!old->freed());
+                if (!old->reloced) {
+                    move_cl(newDataStart, new_ptr, old);
+                }
+            }
+        }
+    }
+}
+
 void ClauseAllocator::update_offsets(
     vector<ClOffset>& offsets
 ) {
@@ -338,10 +613,255 @@ void ClauseAllocator::update_offsets(
     }
 }
 
+void ClauseAllocator::update_offsets_evacuated(
+    vector<ClOffset>& offsets
+    , const vector<char>& evac
+) {
+    for(ClOffset& offs: offsets) {
+        if (evac[chunk_of(offs)]) {
+            Clause* cl = ptr(offs);
+            assert(cl->reloced);
+            offs = (*cl)[0].toInt();
+        }
+    }
+}
+
+/**
+@brief Moves a clause to a chunk that is not being evacuated
+
+The new place is taken from the free chunks or the end of the stack. The old
+place is marked as reloced and remembers the new offset, exactly like during
+full consolidation.
+*/
+ClOffset ClauseAllocator::relocate_in_place(const ClOffset offset)
+{
+    Clause* old = ptr(offset);
+    assert(!old->freed());
+    if (old->reloced) {
+        return (*old)[0].toInt();
+    }
+
+    //NOTE: this may realloc the stack, so "old" must be re-read
+    void* mem = allocEnough(old->size());
+    old = ptr(offset);
+    memcpy(mem, old, words_needed(old->size())*sizeof(BASE_DATA_TYPE));
+
+    const ClOffset new_offset = get_offset((Clause*)mem);
+    (*old)[0] = Lit::toLit(new_offset);
+    old->reloced = true;
+
+    return new_offset;
+}
+
+vector<uint32_t> ClauseAllocator::pick_chunks_to_evacuate(const Solver* solver) const
+{
+    //The chunks currently being filled cannot be evacuated
+    const size_t tail_chunk = size == 0 ? 0 : chunk_of_word(size-1);
+    const size_t reuse_chunk = alloc_end == 0 ? tail_chunk : chunk_of_word(alloc_end-1);
+    const size_t max_used = solver->conf.incremental_consolidate_max_used_ratio * CL_CHUNK_WORDS;
+
+    vector<std::pair<size_t, uint32_t> > sparse;
+    for(size_t c = 0; c < chunk_used.size(); c++) {
+        if (c == tail_chunk
+            || c == reuse_chunk
+            || chunk_free[c]
+            || chunk_spill[c] > CL_CHUNK_WORDS/2
+            || chunk_used[c] > max_used
+        ) {
+            continue;
+        }
+        sparse.push_back(std::make_pair(chunk_used[c], (uint32_t)c));
+    }
+
+    //Sparsest first
+    const size_t num = std::min<size_t>(sparse.size(), solver->conf.incremental_consolidate_max_chunks);
+    std::partial_sort(sparse.begin(), sparse.begin() + num, sparse.end());
+
+    vector<uint32_t> ret;
+    for(size_t i = 0; i < num; i++) {
+        ret.push_back(sparse[i].second);
+    }
+
+    return ret;
+}
+
+/**
+@brief Evacuates the sparsest chunks and puts them on the free list
+
+Clauses in the chosen chunks are moved to the free chunks or to the end of the
+stack, then all offsets pointing into these chunks are updated. The time
+needed is proportional to the size of the watchlists and to the clauses
+moved, not to the size of the whole clause database, and no second copy of
+the database is needed.
+*/
+void ClauseAllocator::consolidate_incremental(Solver* solver)
+{
+    const vector<uint32_t> to_evac = pick_chunks_to_evacuate(solver);
+    if (to_evac.empty()) {
+        if (solver->conf.verbosity >= 3) {
+            cout << "c Not consolidating memory, no sparse chunks." << endl;
+        }
+        return;
+    }
+    const double myTime = cpuTime();
+
+    vector<char> evac(chunk_used.size(), 0);
+    size_t freed_words = 0;
+    for(uint32_t c: to_evac) {
+        evac[c] = 1;
+        freed_words += chunk_used[c];
+    }
+
+    const size_t used_before = currentlyUsedSize;
+    for(auto& ws: solver->watches) {
+        for(Watched& w: ws) {
+            if (w.isClause() && evac[chunk_of(w.get_offset())]) {
+                const ClOffset new_offset = relocate_in_place(w.get_offset());
+                w.setNormOffset(new_offset);
+            }
+        }
+    }
+
+    #ifdef USE_GAUSS
+    for (Gaussian* gauss : solver->gauss_matrixes) {
+        for(GaussClauseToClear& gcl: gauss->clauses_toclear) {
+            if (evac[chunk_of(gcl.offs)]) {
+                gcl.offs = relocate_in_place(gcl.offs);
+            }
+        }
+    }
+    #endif //USE_GAUSS
+
+    update_offsets_evacuated(solver->longIrredCls, evac);
+    for(auto& lredcls: solver->longRedCls) {
+        update_offsets_evacuated(lredcls, evac);
+    }
+
+    //Fix up propBy
+    for (size_t i = 0; i < solver->nVars(); i++) {
+        VarData& vdata = solver->varData[i];
+        if (vdata.reason.isClause()
+            && evac[chunk_of(vdata.reason.get_offset())]
+        ) {
+            if (solver->varFlags.removed(i) == Removed::none
+                && solver->decisionLevel() >= vdata.level
+                && vdata.level != 0
+                && solver->value(i) != l_Undef
+            ) {
+                Clause* old = ptr(vdata.reason.get_offset());
+                assert(old->reloced);
+                vdata.reason = PropBy((*old)[0].toInt());
+            } else {
+                vdata.reason = PropBy();
+            }
+        }
+    }
+
+    //Evacuated chunks can now be reused. The clause spilling out of them
+    //has been moved, so the chunks after them are free from the start
+    for(uint32_t c: to_evac) {
+        currentlyUsedSize -= chunk_used[c];
+        chunk_used[c] = 0;
+        chunk_free[c] = true;
+        free_chunks.push_back(c);
+        for(size_t d = c+1; d < chunk_spill.size() && chunk_spill[d] > 0; d++) {
+            const bool whole = chunk_spill[d] == CL_CHUNK_WORDS;
+            chunk_spill[d] = 0;
+            if (!whole) {
+                break;
+            }
+        }
+    }
+    const size_t moved_words = currentlyUsedSize + freed_words - used_before;
+
+    const double time_used = cpuTime() - myTime;
+    if (solver->conf.verbosity) {
+        cout << "c [mem] Incrementally consolidated memory "
+        << " evacuated chunks: " << to_evac.size()
+        << " moved"; print_value_kilo_mega(moved_words);
+        cout << " free chunks: " << free_chunks.size()
+        << solver->conf.print_times(time_used)
+        << endl;
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed_min(
+            solver
+            , "consolidate incremental"
+            , time_used
+        );
+    }
+}
+
+/**
+@brief Returns how much of the stack is backed by huge pages
+
+Reads the AnonHugePages entries of /proc/self/smaps belonging to the stack's
+mapping. Returns 0 if huge pages are not used.
+*/
+size_t ClauseAllocator::mem_in_huge_pages() const
+{
+    size_t mem = 0;
+    #ifdef USE_HUGEPAGES
+    if (dataStart == NULL) {
+        return 0;
+    }
+    const uintptr_t start = (uintptr_t)dataStart;
+    const uintptr_t end = start + mapped_bytes(capacity*sizeof(BASE_DATA_TYPE));
+
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool inside = false;
+    while(std::getline(smaps, line)) {
+        uintptr_t from, to;
+        char dash;
+        std::istringstream ss(line);
+        if (line.find(':') == std::string::npos || line.find('-') < line.find(':')) {
+            ss >> std::hex >> from >> dash >> to;
+            if (ss && dash == '-') {
+                inside = from < end && to > start;
+                continue;
+            }
+        }
+
+        if (inside && line.compare(0, 14, "AnonHugePages:") == 0) {
+            size_t kb;
+            std::istringstream val(line.substr(14));
+            val >> kb;
+            mem += kb*1024ULL;
+        }
+    }
+    #endif
+
+    return mem;
+}
+
+#ifdef STATS_NEEDED
+uint32_t ClauseAllocator::new_stats_slot()
+{
+    if (free_stats_slots.empty()) {
+        stats_extra.push_back(ClauseStatsExtra());
+        return stats_extra.size()-1;
+    }
+
+    const uint32_t slot = free_stats_slots.back();
+    free_stats_slots.pop_back();
+    stats_extra[slot] = ClauseStatsExtra();
+    return slot;
+}
+#endif
+
 size_t ClauseAllocator::mem_used() const
 {
     uint64_t mem = 0;
     mem += capacity*sizeof(BASE_DATA_TYPE);
+    mem += chunk_used.capacity()*sizeof(size_t);
+    mem += chunk_spill.capacity()*sizeof(uint32_t);
+    mem += chunk_free.capacity()*sizeof(char);
+    mem += free_chunks.capacity()*sizeof(uint32_t);
+    #ifdef STATS_NEEDED
+    mem += stats_extra.capacity()*sizeof(ClauseStatsExtra);
+    mem += free_stats_slots.capacity()*sizeof(uint32_t);
+    #endif
 
     return mem;
 }
@@ -35,6 +35,13 @@ THE SOFTWARE.
 
 #define BASE_DATA_TYPE uint32_t
 
+//The arena is split into chunks of 2^CL_CHUNK_BITS BASE_DATA_TYPE elements.
+//Incremental consolidation evacuates and reuses whole chunks.
+#ifndef CL_CHUNK_BITS
+#define CL_CHUNK_BITS 18
+#endif
+#define CL_CHUNK_WORDS ((size_t)1 << CL_CHUNK_BITS)
+
 namespace CMSat {
 
 class Clause;
@@ -52,6 +59,12 @@ needed. When instructed, it consolidates the unused space (i.e. clauses free()-e
 Essentially, it is a stack-like allocator for clauses. It is useful to have
 this, because this way, we can address clauses according to their number,
 which is 32-bit, instead of their address, which might be 64-bit
+
+The stack is logically split into chunks. For every chunk we keep track of the
+(estimated) space used by clauses starting in it. Incremental consolidation
+only evacuates the sparsest chunks and puts them on a free list, from where
+they are reused for new clauses. This way, there is no need to hold two full
+copies of the clause database, and the time spent is bounded per call.
 */
 class ClauseAllocator {
     public:
@@ -67,21 +80,38 @@ class ClauseAllocator {
             #endif
         ) {
             void* mem = allocEnough(ps.size());
+            #ifdef STATS_NEEDED
+            assert(ID >= 0);
+            const uint32_t slot = new_stats_slot();
+            stats_extra[slot].introduced_at_conflict = conflictNum;
+            stats_extra[slot].ID = ID;
+            #endif
             Clause* real= new (mem) Clause(ps
             #ifdef STATS_NEEDED
-            , conflictNum
-            , ID
+            , slot
             #endif
             );
 
             return real;
         }
 
+        #ifdef STATS_NEEDED
+        ClauseStatsExtra& extra_stats(const Clause& cl)
+        {
+            return stats_extra[cl.stats_slot];
+        }
+
+        const ClauseStatsExtra& extra_stats(const Clause& cl) const
+        {
+            return stats_extra[cl.stats_slot];
+        }
+        #endif
+
         ClOffset get_offset(const Clause* ptr) const;
 
-        inline Clause* ptr(const uint32_t offset) const
+        inline Clause* ptr(const ClOffset offset) const
         {
-            return (Clause*)(&dataStart[offset]);
+            return (Clause*)(&dataStart[(size_t)offset << CL_OFFSET_SHIFT]);
         }
 
         void clauseFree(Clause* c); ///Frees memory and associated clause number
@@ -91,17 +121,50 @@ class ClauseAllocator {
             Solver* solver
             , const bool force = false
         );
+        void consolidate_incremental(Solver* solver);
 
         size_t mem_used() const;
+        size_t mem_in_huge_pages() const;
+        size_t num_free_chunks() const;
+        size_t num_stale_spills() const;
 
     private:
         void update_offsets(vector<ClOffset>& offsets);
+        void update_offsets_evacuated(
+            vector<ClOffset>& offsets
+            , const vector<char>& evac
+        );
+        ClOffset relocate_in_place(const ClOffset offset);
+        vector<uint32_t> pick_chunks_to_evacuate(const Solver* solver) const;
 
-        uint32_t move_cl(
-            uint32_t* newDataStart
-            , uint32_t*& new_ptr
+        ClOffset move_cl(
+            BASE_DATA_TYPE* newDataStart
+            , BASE_DATA_TYPE*& new_ptr
             , Clause* old
-        ) const;
+        );
+        void move_for_locality(
+            Solver* solver
+            , BASE_DATA_TYPE* newDataStart
+            , BASE_DATA_TYPE*& new_ptr
+        );
+
+        ///Number of BASE_DATA_TYPE elements a clause of this size occupies
+        static size_t words_needed(const size_t num_lits);
+
+        static size_t chunk_of_word(const size_t at)
+        {
+            return at >> CL_CHUNK_BITS;
+        }
+
+        static size_t chunk_of(const ClOffset offset)
+        {
+            return chunk_of_word((size_t)offset << CL_OFFSET_SHIFT);
+        }
+
+        ///Grows the stack at the end, returns position of new space
+        size_t alloc_at_end(const size_t needed);
+        void note_placed(const size_t at, const size_t needed);
+        void clear_chunks();
 
         BASE_DATA_TYPE* dataStart; ///<Stack starts at these positions
         size_t size; ///<The number of BASE_DATA_TYPE datapieces currently used in each stack
@@ -121,7 +184,21 @@ class ClauseAllocator {
         */
         size_t currentlyUsedSize;
 
+        //Chunk data
+        vector<size_t> chunk_used; ///<Words used by clauses starting in chunk
+        vector<uint32_t> chunk_spill; ///<Words at start of chunk used by a clause from earlier chunk
+        vector<char> chunk_free; ///<Chunk is in free_chunks
+        vector<uint32_t> free_chunks;
+        size_t alloc_at; ///<Next free position in the reused chunk
+        size_t alloc_end; ///<End of the reused chunk
+
         void* allocEnough(const uint32_t size);
+
+        #ifdef STATS_NEEDED
+        uint32_t new_stats_slot();
+        vector<ClauseStatsExtra> stats_extra; ///<Indexed by Clause::stats_slot
+        vector<uint32_t> free_stats_slots;
+        #endif
 };
 
 } //end namespace
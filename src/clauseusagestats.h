@@ -55,15 +55,15 @@ struct ClauseUsageStats
 
     void addStat(const Clause&
     #ifdef STATS_NEEDED
-    cl
+    , const ClauseStatsExtra& extra
     #endif
     ) {
         num++;
         #ifdef STATS_NEEDED
-        sumConfl += cl.stats.conflicts_made;
-        sumProp += cl.stats.propagations_made;
-        sumLookedAt += cl.stats.clause_looked_at;
-        sumUsedUIP += cl.stats.used_for_uip_creation;
+        sumConfl += extra.conflicts_made;
+        sumProp += extra.propagations_made;
+        sumLookedAt += extra.clause_looked_at;
+        sumUsedUIP += extra.used_for_uip_creation;
         #endif
     }
     void print() const;
@@ -73,9 +73,10 @@ struct CleaningStats
         uint64_t numLookedAt = 0;
         #endif
 
-        void incorporate(const Clause* cl, size_t 
+        void incorporate(const Clause* cl, size_t
             #ifdef STATS_NEEDED
             sumConfl
+            , const ClauseStatsExtra& extra
             #endif
         ) {
             num ++;
@@ -83,12 +84,12 @@ struct CleaningStats
             glue += cl->stats.glue;
 
             #ifdef STATS_NEEDED
-            numConfl += cl->stats.conflicts_made;
-            numLookedAt += cl->stats.clause_looked_at;
-            numProp += cl->stats.propagations_made;
-            age += sumConfl - cl->stats.introduced_at_conflict;
-            used_for_uip_creation += cl->stats.used_for_uip_creation;
-            antec_data += cl->stats.antec_data;
+            numConfl += extra.conflicts_made;
+            numLookedAt += extra.clause_looked_at;
+            numProp += extra.propagations_made;
+            age += sumConfl - extra.introduced_at_conflict;
+            used_for_uip_creation += extra.used_for_uip_creation;
+            antec_data += extra.antec_data;
             #endif
         }
 
@@ -28,6 +28,23 @@ THE SOFTWARE.
 
 namespace CMSat {
 
+/**
+@brief Offsets address the clause arena in units of 2^CL_OFFSET_SHIFT words
+
+Offsets are stored in 30 bits inside Watched. With LARGE_OFFSETS, every clause
+is aligned to 2^CL_OFFSET_SHIFT arena words, and offsets count such aligned
+units, not words. This lifts the arena limit from 4GB to 4GB*2^CL_OFFSET_SHIFT
+while keeping Watched and PropBy at their current size.
+*/
+#ifdef LARGE_OFFSETS
+#ifndef CL_OFFSET_SHIFT
+#define CL_OFFSET_SHIFT 3
+#endif
+#else
+#undef CL_OFFSET_SHIFT
+#define CL_OFFSET_SHIFT 0
+#endif
+
 typedef uint32_t ClOffset;
 #define CL_OFFSET_MAX (std::numeric_limits<ClOffset>::max())
 
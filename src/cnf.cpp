@@ -65,7 +65,7 @@ void CNF::new_var(const bool bva, const uint32_t orig_outer)
         outerToInterMain[x] = maxVar;
 
         swapVars(nVarsOuter()-1);
-        varData[nVars()-1].is_bva = bva;
+        varFlags.set_is_bva(nVars()-1, bva);
         if (bva) {
             num_bva_vars ++;
         } else {
@@ -131,7 +131,7 @@ void CNF::new_vars(const size_t n)
         outerToInterMain[x] = maxVar;
 
         swapVars(nVarsOuter()-i-1, i);
-        varData[nVars()-i-1].is_bva = false;
+        varFlags.set_is_bva(nVars()-i-1, false);
         outer_to_with_bva_map.push_back(nVarsOuter()-i-1);
     }
 
@@ -144,12 +144,14 @@ void CNF::swapVars(const uint32_t which, const int off_by)
 {
     std::swap(assigns[nVars()-off_by-1], assigns[which]);
     std::swap(varData[nVars()-off_by-1], varData[which]);
+    varFlags.swap(nVars()-off_by-1, which);
 }
 
 void CNF::enlarge_nonminimial_datastructs(size_t n)
 {
     assigns.resize(assigns.size() + n, l_Undef);
     varData.resize(varData.size() + n, VarData());
+    varFlags.resize(varFlags.size() + n);
     depth.resize(depth.size() + n);
 }
 
@@ -163,7 +165,7 @@ void CNF::enlarge_minimal_datastructs(size_t n)
 
 void CNF::save_on_var_memory()
 {
-    //never resize varData --> contains info about what is replaced/etc.
+    //never resize varFlags --> contains info about what is replaced/etc.
     //never resize assigns --> contains 0-level assigns
     //never resize interToOuterMain, outerToInterMain
 
@@ -234,6 +236,16 @@ uint64_t CNF::print_mem_used_longclauses(const size_t totalMem) const
         , "%"
     );
 
+    #ifdef USE_HUGEPAGES
+    const uint64_t huge = cl_alloc.mem_in_huge_pages();
+    print_stats_line("c Mem for longcl hugepages"
+        , huge/(1024UL*1024UL)
+        , "MB"
+        , stats_line_percent(huge, totalMem)
+        , "%"
+    );
+    #endif
+
     return mem;
 }
 
@@ -318,7 +330,7 @@ vector<lbool> CNF::map_back_to_without_bva(const vector<lbool>& val) const
     assert(val.size() == nVarsOuter());
     ret.reserve(nVarsOutside());
     for(size_t i = 0; i < nVarsOuter(); i++) {
-        if (!varData[map_outer_to_inter(i)].is_bva) {
+        if (!varFlags.is_bva(map_outer_to_inter(i))) {
             ret.push_back(val[i]);
         }
     }
@@ -331,7 +343,7 @@ vector<uint32_t> CNF::build_outer_to_without_bva_map() const
     vector<uint32_t> ret;
     size_t at = 0;
     for(size_t i = 0; i < nVarsOuter(); i++) {
-        if (!varData[map_outer_to_inter(i)].is_bva) {
+        if (!varFlags.is_bva(map_outer_to_inter(i))) {
             ret.push_back(at);
             at++;
         } else {
@@ -365,6 +377,7 @@ void CNF::save_state(SimpleOutFile& f) const
 
     f.put_vector(assigns);
     f.put_vector(varData);
+    varFlags.save_state(f);
     f.put_uint32_t(minNumVars);
     f.put_uint32_t(num_bva_vars);
     f.put_uint32_t(ok);
@@ -374,6 +387,7 @@ void CNF::load_state(SimpleInFile& f)
 {
     assert(seen.empty());
     assert(varData.empty());
+    assert(varFlags.empty());
     assert(watches.size() == 0);
 
     f.get_vector(interToOuterMain);
@@ -382,6 +396,7 @@ void CNF::load_state(SimpleInFile& f)
 
     f.get_vector(assigns);
     f.get_vector(varData);
+    varFlags.load_state(f);
     minNumVars = f.get_uint32_t();
     num_bva_vars = f.get_uint32_t();
     ok = f.get_uint32_t();
@@ -49,6 +49,7 @@ struct BinTriStats
     uint64_t irredBins = 0;
     uint64_t redBins = 0;
     uint64_t numNewBinsSinceSCC = 0;
+    uint64_t numNewBinsSinceStamp = 0;
 };
 
 struct LitStats
@@ -91,6 +92,7 @@ public:
     bool ok = true;
     watch_array watches;  ///< 'watches[lit]' is a list of constraints watching 'lit'
     vector<VarData> varData;
+    VarFlags varFlags;
     vector<uint32_t> depth;
     Stamp stamp;
     ImplCache implCache;
@@ -316,11 +316,11 @@ void CompHandler::check_local_vardata_sanity()
     for (uint32_t outerVar = 0; outerVar < solver->nVarsOuter(); ++outerVar) {
         const uint32_t interVar = solver->map_outer_to_inter(outerVar);
         if (savedState[outerVar] != l_Undef) {
-            assert(solver->varData[interVar].removed == Removed::decomposed);
+            assert(solver->varFlags.removed(interVar) == Removed::decomposed);
             assert(solver->value(interVar) == l_Undef || solver->varData[interVar].level == 0);
         }
 
-        if (solver->varData[interVar].removed == Removed::decomposed) {
+        if (solver->varFlags.removed(interVar) == Removed::decomposed) {
             num_vars_removed_check++;
         }
     }
@@ -368,8 +368,8 @@ void CompHandler::move_decision_level_zero_vars_here(
         lit = Lit(smallsolver_to_bigsolver[lit.var()], lit.sign());
         assert(solver->value(lit) == l_Undef);
 
-        assert(solver->varData[lit.var()].removed == Removed::decomposed);
-        solver->varData[lit.var()].removed = Removed::none;
+        assert(solver->varFlags.removed(lit.var()) == Removed::decomposed);
+        solver->varFlags.set_removed(lit.var(), Removed::none);
         solver->set_decision_var(lit.var());
         num_vars_removed--;
 
@@ -435,8 +435,8 @@ void CompHandler::moveVariablesBetweenSolvers(
         assert(compFinder->getVarComp(var) == comp);
         assert(solver->value(var) == l_Undef);
 
-        assert(solver->varData[var].removed == Removed::none);
-        solver->varData[var].removed = Removed::decomposed;
+        assert(solver->varFlags.removed(var) == Removed::none);
+        solver->varFlags.set_removed(var, Removed::decomposed);
         num_vars_removed++;
     }
 }
@@ -506,7 +506,7 @@ void CompHandler::moveClausesLong(
         //Add 'tmp' to the new solver
         if (cl.red()) {
             #ifdef STATS_NEEDED
-            cl.stats.introduced_at_conflict = 0;
+            solver->cl_alloc.extra_stats(cl).introduced_at_conflict = 0;
             #endif
             //newSolver->addRedClause(tmp, cl.stats);
         } else {
@@ -643,14 +643,14 @@ void CompHandler::addSavedState(vector<lbool>& solution)
     for (size_t var = 0; var < savedState.size(); ++var) {
         if (savedState[var] != l_Undef) {
             const uint32_t interVar = solver->map_outer_to_inter(var);
-            assert(solver->varData[interVar].removed == Removed::decomposed);
+            assert(solver->varFlags.removed(interVar) == Removed::decomposed);
 
             const lbool val = savedState[var];
             assert(solution[var] == l_Undef);
             solution[var] = val;
             //cout << "Solution to var " << var + 1 << " has been added: " << val << endl;
 
-            solver->varData[interVar].polarity = (val == l_True);
+            solver->varFlags.set_polarity(interVar, (val == l_True));
         }
     }
 }
@@ -676,9 +676,8 @@ void CompHandler::readdRemovedClauses()
     //Avoid recursion, clear 'removed' status
     for(size_t outer = 0; outer < solver->nVarsOuter(); ++outer) {
         const uint32_t inter = solver->map_outer_to_inter(outer);
-        VarData& dat = solver->varData[inter];
-        if (dat.removed == Removed::decomposed) {
-            dat.removed = Removed::none;
+        if (solver->varFlags.removed(inter) == Removed::decomposed) {
+            solver->varFlags.set_removed(inter, Removed::none);
             num_vars_removed--;
         }
     }
@@ -713,8 +712,7 @@ void CompHandler::readdRemovedClauses()
     //-> set them decision
     for(size_t outer = 0; outer < solver->nVarsOuter(); ++outer) {
         const uint32_t inter = solver->map_outer_to_inter(outer);
-        VarData& dat = solver->varData[inter];
-        if (dat.removed == Removed::none
+        if (solver->varFlags.removed(inter) == Removed::none
             && solver->value(inter) == l_Undef
         ) {
             solver->set_decision_var(inter);
@@ -381,6 +381,16 @@ DLL_PUBLIC void SATSolver::set_max_confl(int64_t max_confl)
   }
 }
 
+DLL_PUBLIC void SATSolver::set_max_memory(uint64_t max_mem_mb)
+{
+    //The budget is shared between the threads
+    const uint64_t per_solver = std::max<uint64_t>(max_mem_mb/data->solvers.size(), 1);
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.maxMemMB = per_solver;
+    }
+}
+
 DLL_PUBLIC void SATSolver::set_default_polarity(bool polarity)
 {
     for (size_t i = 0; i < data->solvers.size(); ++i) {
@@ -757,6 +767,9 @@ DLL_PUBLIC void SATSolver::set_drat(std::ostream* os, bool add_ID)
         drat = new DratFile<false>;
     }
     drat->setFile(os);
+    #ifdef STATS_NEEDED
+    drat->set_cl_alloc(&data->solvers[0]->cl_alloc);
+    #endif
     if (data->solvers[0]->drat)
         delete data->solvers[0]->drat;
 
@@ -161,7 +161,7 @@ bool DataSync::syncBinFromOthers()
         lit1 = solver->map_to_with_bva(lit1);
         lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
         lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->varData[lit1.var()].removed != Removed::none
+        if (solver->varFlags.removed(lit1.var()) != Removed::none
             || solver->value(lit1.var()) != l_Undef
         ) {
             continue;
@@ -188,7 +188,7 @@ bool DataSync::syncBinFromOthers(
     , watch_subarray ws
 ) {
     assert(solver->varReplacer->get_lit_replaced_with(lit) == lit);
-    assert(solver->varData[lit.var()].removed == Removed::none);
+    assert(solver->varFlags.removed(lit.var()) == Removed::none);
 
     assert(toClear.empty());
     for (const Watched& w: ws) {
@@ -205,7 +205,7 @@ bool DataSync::syncBinFromOthers(
         otherLit = solver->map_to_with_bva(otherLit);
         otherLit = solver->varReplacer->get_lit_replaced_with_outer(otherLit);
         otherLit = solver->map_outer_to_inter(otherLit);
-        if (solver->varData[otherLit.var()].removed != Removed::none
+        if (solver->varFlags.removed(otherLit.var()) != Removed::none
             || solver->value(otherLit) != l_Undef
         ) {
             continue;
@@ -292,7 +292,7 @@ bool DataSync::shareUnitData()
         if (otherVal != l_Undef) {
             assert(thisVal == l_Undef);
             Lit litToEnqueue = thisLit ^ (otherVal == l_False);
-            if (solver->varData[litToEnqueue.var()].removed != Removed::none) {
+            if (solver->varFlags.removed(litToEnqueue.var()) != Removed::none) {
                 continue;
             }
 
@@ -339,9 +339,9 @@ void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
         must_rebuild_bva_map = false;
     }
 
-    if (solver->varData[lit1.var()].is_bva)
+    if (solver->varFlags.is_bva(lit1.var()))
         return;
-    if (solver->varData[lit2.var()].is_bva)
+    if (solver->varFlags.is_bva(lit2.var()))
         return;
 
     lit1 = solver->map_inter_to_outer(lit1);
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "watchalgos.h"
 #include "clauseallocator.h"
 #include "sqlstats.h"
+#include "occsimplifier.h"
 
 #include <iomanip>
 using namespace CMSat;
@@ -69,6 +70,25 @@ end:
     return solver->ok;
 }
 
+bool DistillerAllWithAll::distill_red(uint32_t queueByBy)
+{
+    assert(solver->ok);
+
+    for(auto& lredcls: solver->longRedCls) {
+        solver->clauseCleaner->clean_clauses(lredcls);
+    }
+
+    distill_long_red_cls(queueByBy);
+
+    globalStats += runStats;
+    if (solver->conf.verbosity >= 3) {
+        runStats.print(solver->nVars());
+    }
+    runStats.clear();
+
+    return solver->ok;
+}
+
 struct ClauseSizeSorter
 {
     ClauseSizeSorter(const ClauseAllocator& _cl_alloc, const bool _invert = false) :
@@ -91,6 +111,23 @@ struct ClauseSizeSorter
     }
 };
 
+//Without dirty-tracking, everything counts as changed
+bool DistillerAllWithAll::cl_changed_since_occ(const Clause& cl) const
+{
+    if (!solver->conf.occ_only_dirty
+        || solver->occsimplifier == NULL
+    ) {
+        return true;
+    }
+
+    for(const Lit lit: cl) {
+        if (solver->occsimplifier->var_dirty(lit.var())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool DistillerAllWithAll::distill_long_irred_cls(uint32_t queueByBy)
 {
     assert(solver->ok);
@@ -197,7 +234,8 @@ bool DistillerAllWithAll::distill_long_irred_cls(uint32_t queueByBy)
     }
     solver->longIrredCls.resize(solver->longIrredCls.size()- (i-j));
 
-    //Didn't time out, so it went through the whole list. Reset distill for all.
+    //Didn't time out, so it went through the whole list. Reset distill for
+    //all, or only for those that have changed if we track that
     if (!time_out) {
         for (vector<ClOffset>::const_iterator
             it = solver->longIrredCls.begin(), end = solver->longIrredCls.end()
@@ -205,7 +243,9 @@ bool DistillerAllWithAll::distill_long_irred_cls(uint32_t queueByBy)
             ; ++it
         ) {
             Clause* cl = solver->cl_alloc.ptr(*it);
-            cl->set_distilled(false);
+            if (cl_changed_since_occ(*cl)) {
+                cl->set_distilled(false);
+            }
         }
     }
 
@@ -236,6 +276,167 @@ bool DistillerAllWithAll::distill_long_irred_cls(uint32_t queueByBy)
     return solver->ok;
 }
 
+struct RedClsVivifyOrder
+{
+    RedClsVivifyOrder(const ClauseAllocator& _cl_alloc) :
+        cl_alloc(_cl_alloc)
+    {}
+
+    const ClauseAllocator& cl_alloc;
+
+    //Lowest glue first, then most active first
+    bool operator()(const ClOffset off1, const ClOffset off2) const
+    {
+        const Clause* cl1 = cl_alloc.ptr(off1);
+        const Clause* cl2 = cl_alloc.ptr(off2);
+
+        if (cl1->stats.glue != cl2->stats.glue) {
+            return cl1->stats.glue < cl2->stats.glue;
+        }
+        return cl1->stats.activity > cl2->stats.activity;
+    }
+};
+
+bool DistillerAllWithAll::distill_long_red_cls(uint32_t queueByBy)
+{
+    assert(solver->ok);
+    if (solver->conf.verbosity >= 6) {
+        cout
+        << "c Doing distillation branch for long red clauses"
+        << endl;
+    }
+
+    double myTime = cpuTime();
+    const size_t origTrailSize = solver->trail_size();
+
+    //Time-limiting
+    const uint64_t maxNumProps =
+        solver->conf.distill_red_cls_time_limitM*1000LL*1000ULL
+        *solver->conf.global_timeout_multiplier;
+
+    extraTime = 0;
+    uint64_t oldBogoProps = solver->propStats.bogoProps;
+    bool time_out = false;
+    runStats.numCalled = 1;
+
+    //Kept tier first, then the rest. Each tier best-first, so whatever is
+    //left when we run out of time is the least useful. The tier lists keep
+    //their own order, which is by age, so we go through an index
+    const RedClsVivifyOrder better(solver->cl_alloc);
+    for(vector<ClOffset>& lredcls: solver->longRedCls) {
+        runStats.potentialClauses += lredcls.size();
+        order.clear();
+        for(uint32_t at = 0; at < lredcls.size(); at++) {
+            order.push_back(at);
+        }
+        std::sort(order.begin(), order.end(),
+            [&](const uint32_t a, const uint32_t b) {return better(lredcls[a], lredcls[b]);}
+        );
+
+        bool removed_any = false;
+        for(const uint32_t at: order) {
+            if (time_out || !solver->ok) {
+                break;
+            }
+
+            //if done enough, stop doing it
+            if (solver->propStats.bogoProps-oldBogoProps + extraTime >= maxNumProps
+                || solver->must_interrupt_asap()
+            ) {
+                if (solver->conf.verbosity >= 3) {
+                    cout
+                    << "c Need to finish distillation of red cls -- ran out of prop (=allocated time)"
+                    << endl;
+                }
+                runStats.timeOut++;
+                time_out = true;
+                break;
+            }
+
+            ClOffset offset = lredcls[at];
+            Clause& cl = *solver->cl_alloc.ptr(offset);
+            extraTime += 5;
+
+            if (cl.getdistilled()) {
+                continue;
+            }
+            cl.set_distilled(true);
+
+            extraTime += cl.size();
+            runStats.checkedClauses++;
+            assert(cl.size() > 2);
+            assert(cl.red());
+
+            uselessLits.clear();
+            lits.resize(cl.size());
+            std::copy(cl.begin(), cl.end(), lits.begin());
+
+            const ClauseStats stats = cl.stats;
+            lredcls[at] = try_distill_clause_and_return_new(
+                offset
+                , true
+                , &stats
+                , queueByBy
+            );
+            removed_any |= lredcls[at] == CL_OFFSET_MAX;
+        }
+
+        if (removed_any) {
+            lredcls.erase(
+                std::remove(lredcls.begin(), lredcls.end(), CL_OFFSET_MAX)
+                , lredcls.end()
+            );
+        }
+    }
+
+    //Went through all of them, so next time start again
+    if (!time_out) {
+        for(const vector<ClOffset>& lredcls: solver->longRedCls) {
+            for(ClOffset offset: lredcls) {
+                solver->cl_alloc.ptr(offset)->set_distilled(false);
+            }
+        }
+    }
+
+    const double time_used = cpuTime() - myTime;
+    const double time_remain = float_div(solver->propStats.bogoProps-oldBogoProps + extraTime, maxNumProps);
+    if (solver->conf.verbosity) {
+        cout << "c [distill] longred"
+        << " tried: " << runStats.checkedClauses << "/" << runStats.potentialClauses
+        << " cl-r:" << runStats.numClShorten
+        << " lit-r:" << runStats.numLitsRem
+        << " cl-implied:" << runStats.numClImplied
+        << solver->conf.print_times(time_used, time_out, time_remain)
+        << endl;
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "distill long red"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+
+    runStats.time_used = time_used;
+    runStats.zeroDepthAssigns = solver->trail_size() - origTrailSize;
+
+    return solver->ok;
+}
+
+//Whether a literal, true at the current point of distillation, was set by
+//something other than the clause being distilled
+bool DistillerAllWithAll::implied_by_other_cl(const Lit lit, const ClOffset offset) const
+{
+    const VarData& vdata = solver->varData[lit.var()];
+    if (vdata.level == 0) {
+        return true;
+    }
+
+    return !(vdata.reason.isClause() && vdata.reason.get_offset() == offset);
+}
+
 ClOffset DistillerAllWithAll::try_distill_clause_and_return_new(
     ClOffset offset
     , const bool red
@@ -250,9 +451,10 @@ ClOffset DistillerAllWithAll::try_distill_clause_and_return_new(
 
     //Try to enqueue the literals in 'queueByBy' amounts and see if we fail
     bool failed = false;
+    bool implied = false;
     uint32_t done = 0;
     solver->new_decision_level();
-    for (; done < lits.size();) {
+    for (; done < lits.size() && !implied;) {
         uint32_t i2 = 0;
         for (; (i2 < queueByBy) && ((done+i2) < lits.size()); i2++) {
             lbool val = solver->value(lits[done+i2]);
@@ -261,10 +463,20 @@ ClOffset DistillerAllWithAll::try_distill_clause_and_return_new(
             } else if (val == l_False) {
                 //Record that there is no use for this literal
                 uselessLits.push_back(lits[done+i2]);
+            } else if (red
+                && offset != CL_OFFSET_MAX
+                && implied_by_other_cl(lits[done+i2], offset)
+            ) {
+                //The rest of the clause database propagates this clause
+                implied = true;
+                break;
             }
         }
         done += i2;
         extraTime += 5;
+        if (implied) {
+            break;
+        }
         failed = (!solver->propagate<true>().isNULL());
         if (failed) {
             break;
@@ -273,6 +485,14 @@ ClOffset DistillerAllWithAll::try_distill_clause_and_return_new(
     solver->cancelUntil<false>(0);
     assert(solver->ok);
 
+    //A learnt clause that propagation derives anyway is of no use
+    if (implied) {
+        runStats.numClImplied++;
+        solver->detachClause(offset);
+        solver->cl_alloc.clauseFree(offset);
+        return CL_OFFSET_MAX;
+    }
+
     if (uselessLits.size() > 0 || (failed && done < lits.size())) {
         //Stats
         runStats.numClShorten++;
@@ -286,12 +506,27 @@ ClOffset DistillerAllWithAll::try_distill_clause_and_return_new(
         }
 
         //Make new clause
+        #ifdef STATS_NEEDED
+        ClauseStatsExtra extra;
+        if (offset != CL_OFFSET_MAX) {
+            extra = solver->cl_alloc.extra_stats(*solver->cl_alloc.ptr(offset));
+        }
+        #endif
         Clause *cl2;
         if (stats) {
-            cl2 = solver->add_clause_int(lits, red, *stats);
+            ClauseStats new_stats = *stats;
+            if (red) {
+                new_stats.glue = std::min<uint32_t>(new_stats.glue, lits.size());
+            }
+            cl2 = solver->add_clause_int(lits, red, new_stats);
         } else {
             cl2 = solver->add_clause_int(lits, red);
         }
+        #ifdef STATS_NEEDED
+        if (cl2 != NULL && offset != CL_OFFSET_MAX) {
+            solver->cl_alloc.extra_stats(*cl2) = extra;
+        }
+        #endif
 
         //Print results
         if (solver->conf.verbosity >= 5) {
@@ -341,6 +576,7 @@ DistillerAllWithAll::Stats& DistillerAllWithAll::Stats::operator+=(const Stats&
     zeroDepthAssigns += other.zeroDepthAssigns;
     numClShorten += other.numClShorten;
     numLitsRem += other.numLitsRem;
+    numClImplied += other.numClImplied;
     checkedClauses += other.checkedClauses;
     potentialClauses += other.potentialClauses;
     numCalled += other.numCalled;
@@ -384,6 +620,9 @@ void DistillerAllWithAll::Stats::print(const size_t nVars) const
     print_stats_line("c lits-rem",
         numLitsRem
     );
+    print_stats_line("c red cls implied",
+        numClImplied
+    );
     print_stats_line("c 0-depth-assigns",
         zeroDepthAssigns
         , stats_line_percent(zeroDepthAssigns, nVars)
@@ -397,5 +636,6 @@ double DistillerAllWithAll::mem_used() const
     double mem_used = sizeof(DistillerAllWithAll);
     mem_used += lits.size()*sizeof(Lit);
     mem_used += uselessLits.size()*sizeof(Lit);
+    mem_used += order.capacity()*sizeof(uint32_t);
     return mem_used;
 }
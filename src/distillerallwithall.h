@@ -41,6 +41,7 @@ class DistillerAllWithAll {
     public:
         DistillerAllWithAll(Solver* solver);
         bool distill(uint32_t queueByBy = 2);
+        bool distill_red(uint32_t queueByBy = 2);
 
         struct Stats
         {
@@ -59,6 +60,7 @@ class DistillerAllWithAll {
             uint64_t zeroDepthAssigns = 0;
             uint64_t numClShorten = 0;
             uint64_t numLitsRem = 0;
+            uint64_t numClImplied = 0;
             uint64_t checkedClauses = 0;
             uint64_t potentialClauses = 0;
             uint64_t numCalled = 0;
@@ -78,11 +80,15 @@ class DistillerAllWithAll {
 
         //Actual algorithms used
         bool distill_long_irred_cls(uint32_t queueByBy);
+        bool distill_long_red_cls(uint32_t queueByBy);
+        bool implied_by_other_cl(const Lit lit, const ClOffset offset) const;
+        bool cl_changed_since_occ(const Clause& cl) const;
         Solver* solver;
 
         //For distill
         vector<Lit> lits;
         vector<Lit> uselessLits;
+        vector<uint32_t> order;
         uint64_t extraTime;
 
         //Global status
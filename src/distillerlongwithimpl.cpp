@@ -145,8 +145,8 @@ bool DistillerLongWithImpl::str_and_sub_clause_with_cache(const Lit lit, const b
     if (solver->conf.doCache
         && seen[lit.toInt()] //We haven't yet removed this literal from the clause
      ) {
-        timeAvailable -= (1+(int)alsoStrengthen)*(long)solver->implCache[lit].lits.size();
-        for (const LitExtra elit: solver->implCache[lit].lits) {
+        timeAvailable -= (1+(int)alsoStrengthen)*(long)solver->implCache[lit].size();
+        for (const LitExtra elit: solver->implCache[lit]) {
              if (alsoStrengthen
                 && seen[(~(elit.getLit())).toInt()]
             ) {
@@ -333,8 +333,14 @@ bool DistillerLongWithImpl::remove_or_shrink_clause(Clause& cl, ClOffset& offset
     cache_based_data.remLitBin += thisremLitBin;
     tmpStats.shrinked++;
     timeAvailable -= (long)lits.size()*2 + 50;
+    #ifdef STATS_NEEDED
+    const ClauseStatsExtra extra = solver->cl_alloc.extra_stats(cl);
+    #endif
     Clause* c2 = solver->add_clause_int(lits, cl.red(), cl.stats);
     if (c2 != NULL) {
+        #ifdef STATS_NEEDED
+        solver->cl_alloc.extra_stats(*c2) = extra;
+        #endif
         solver->detachClause(offset);
         solver->cl_alloc.clauseFree(offset);
         offset = solver->cl_alloc.get_offset(c2);
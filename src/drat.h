@@ -24,6 +24,7 @@ THE SOFTWARE.
 #define __DRAT_H__
 
 #include "clause.h"
+#include "clauseallocator.h"
 #include <iostream>
 
 namespace CMSat {
@@ -79,6 +80,12 @@ struct Drat
     virtual void setFile(std::ostream*)
     {
     }
+
+    #ifdef STATS_NEEDED
+    virtual void set_cl_alloc(const ClauseAllocator*)
+    {
+    }
+    #endif
 };
 
 template<bool add_ID>
@@ -130,7 +137,7 @@ struct DratFile: public Drat
         }
         #ifdef STATS_NEEDED
         if (add_ID) {
-            ID = cl.stats.ID;
+            ID = cl_alloc->extra_stats(cl).ID;
             assert(ID != 0);
         }
         #endif
@@ -200,6 +207,14 @@ struct DratFile: public Drat
         return *this;
     }
 
+    #ifdef STATS_NEEDED
+    void set_cl_alloc(const ClauseAllocator* _cl_alloc) override
+    {
+        cl_alloc = _cl_alloc;
+    }
+    const ClauseAllocator* cl_alloc = NULL;
+    #endif
+
     std::ostream* file = NULL;
     int64_t ID = 1;
 };
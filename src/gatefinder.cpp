@@ -334,7 +334,7 @@ void GateFinder::find_or_gates_in_sweep_mode(const Lit lit)
     }
 
     if (solver->conf.doCache && solver->conf.otfHyperbin) {
-        const vector<LitExtra>& cache = solver->implCache[lit].lits;
+        const CacheLits cache = solver->implCache[lit];
         *simplifier->limit_to_decrease -= cache.size();
         for(const LitExtra l: cache) {
              if (l.getOnlyIrredBin()) {
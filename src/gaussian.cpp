@@ -297,7 +297,7 @@ void Gaussian::fill_matrix(matrixset& origMat)
         #ifdef DEBUG_GAUSS
         for(const Xor& x: xors) {
             for(uint32_t v: x) {
-                assert(solver->varData[v].removed == Removed::none);
+                assert(solver->varFlags.removed(v) == Removed::none);
             }
         }
         #endif
@@ -949,11 +949,11 @@ Gaussian::gaussian_ret Gaussian::handle_matrix_prop(matrixset& m, const uint32_t
     cout << "(" << matrix_no << ") prop clause: "
     << tmp_clause << " , "
     << "rhs:" << m.matrix.getVarsetAt(row).rhs() << endl;
-    cout << "varData [0]:" << removed_type_to_string(solver->varData[tmp_clause[0].var()].removed) << endl;
+    cout << "varData [0]:" << removed_type_to_string(solver->varFlags.removed(tmp_clause[0].var())) << endl;
     #endif
     #ifdef DEBUG_GAUSS
     for(Lit l: tmp_clause) {
-        assert(solver->varData[l.var()].removed == Removed::none);
+        assert(solver->varFlags.removed(l.var()) == Removed::none);
     }
     #endif
 
@@ -1004,7 +1004,7 @@ PropResult HyperEngine::prop_normal_cl_with_ancestor_info(
 
     //Update stats
     #ifdef STATS_NEEDED
-    c.stats.propagations_made++;
+    cl_alloc.extra_stats(c).propagations_made++;
     if (c.red())
         propStats.propsLongRed++;
     else
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "solver.h"
 #include "varreplacer.h"
+#include "sccfinder.h"
 #include "varupdatehelper.h"
 #include "time_mem.h"
 #include "sqlstats.h"
@@ -38,31 +39,93 @@ using std::endl;
 //Make all literals as if propagated only by redundant
 void ImplCache::makeAllRed()
 {
-    for(vector<TransCache>::iterator
-        it = implCache.begin(), end = implCache.end()
-        ; it != end
-        ; ++it
-    ) {
-        it->makeAllRed();
+    for(size_t i = 0; i < slots.size(); i++) {
+        const Lit lit = Lit::toLit(i);
+        decode(lit, tmp_lits);
+        for(LitExtra& l: tmp_lits) {
+            l = LitExtra(l.getLit(), false);
+        }
+        store(lit, tmp_lits);
     }
 }
 
 size_t ImplCache::mem_used() const
 {
-    double numBytes = 0;
-    for(vector<TransCache>::const_iterator
-        it = implCache.begin(), end = implCache.end()
-        ; it != end
-        ; ++it
-    ) {
-        //1.2 is overhead
-        numBytes += (double)it->lits.capacity()*(double)sizeof(LitExtra)*1.2;
-    }
-    numBytes += implCache.capacity()*sizeof(vector<TransCache>);
+    size_t numBytes = 0;
+    numBytes += arena.capacity();
+    numBytes += slots.capacity()*sizeof(Slot);
+    numBytes += tmp_lits.capacity()*sizeof(LitExtra);
+    numBytes += tmp_bytes.capacity();
 
     return numBytes;
 }
 
+void ImplCache::decode(const Lit at, vector<LitExtra>& out) const
+{
+    out.clear();
+    for(const LitExtra l: (*this)[at]) {
+        out.push_back(l);
+    }
+}
+
+//Replaces the list of 'at' with 'lits', of which the first 'sorted' are
+//already in order. The list is written in place if it fits, otherwise at
+//the end of the arena. Views into the arena are invalidated
+void ImplCache::store(const Lit at, vector<LitExtra>& lits, const size_t sorted)
+{
+    const auto lt = [](const LitExtra a, const LitExtra b) {
+        return a.toInt() < b.toInt();
+    };
+    std::sort(lits.begin() + sorted, lits.end(), lt);
+    std::inplace_merge(lits.begin(), lits.begin() + sorted, lits.end(), lt);
+
+    tmp_bytes.clear();
+    uint32_t prev = 0;
+    for(const LitExtra l: lits) {
+        assert(tmp_bytes.empty() || l.toInt() > prev);
+        uint32_t delta = l.toInt() - prev;
+        prev = l.toInt();
+        while(delta >= 0x80) {
+            tmp_bytes.push_back((delta & 0x7f) | 0x80);
+            delta >>= 7;
+        }
+        tmp_bytes.push_back(delta);
+    }
+
+    Slot& slot = slots[at.toInt()];
+    if (tmp_bytes.size() <= slot.bytes) {
+        unused += slot.bytes - tmp_bytes.size();
+    } else if (slot.at + slot.bytes == arena.size()) {
+        arena.resize(slot.at + tmp_bytes.size());
+    } else {
+        unused += slot.bytes;
+        slot.at = arena.size();
+        arena.resize(arena.size() + tmp_bytes.size());
+    }
+    std::copy(tmp_bytes.begin(), tmp_bytes.end(), arena.begin() + slot.at);
+    slot.bytes = tmp_bytes.size();
+    slot.num = lits.size();
+
+    if (unused > 64*1024 && unused*2 > arena.size()) {
+        compact();
+    }
+}
+
+void ImplCache::compact()
+{
+    vector<uint8_t> newArena;
+    newArena.reserve(arena.size() - unused);
+    for(Slot& slot: slots) {
+        const uint64_t newAt = newArena.size();
+        newArena.insert(newArena.end()
+            , arena.begin() + slot.at
+            , arena.begin() + slot.at + slot.bytes);
+        slot.at = newAt;
+    }
+    arena.swap(newArena);
+    unused = 0;
+}
+
 void ImplCache::print_stats(const Solver* solver) const
 {
     cout
@@ -82,16 +145,24 @@ void ImplCache::print_statsSort(const Solver* solver) const
     size_t totalElems = 0;
     size_t activeLits = 0;
 
-    for(size_t i = 0; i < implCache.size(); i++) {
+    for(size_t i = 0; i < slots.size(); i++) {
         Lit lit = Lit::toLit(i);
 
-        if (solver->varData[lit.var()].removed == Removed::none) {
+        if (solver->varFlags.removed(lit.var()) == Removed::none) {
             activeLits++;
-            totalElems += implCache[i].lits.size();
-            numHasElems += !implCache[i].lits.empty();
+            totalElems += slots[i].num;
+            numHasElems += slots[i].num != 0;
         }
     }
 
+    print_stats_line(
+        "c cache compressed size"
+        , (double)(arena.size() - unused)/(1024.0*1024.0)
+        , "MB"
+        , stats_line_percent(arena.size() - unused, totalElems*sizeof(LitExtra))
+        , "% of uncompressed"
+    );
+
     print_stats_line(
         "c lits having cache"
         , stats_line_percent(numHasElems, activeLits)
@@ -120,19 +191,21 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
     for (uint32_t var = 0; var < solver->nVars(); var++) {
 
         //If replaced, merge it into the one that replaced it
-        if (solver->varData[var].removed == Removed::replaced) {
+        if (solver->varFlags.removed(var) == Removed::replaced) {
             for(int i = 0; i < 2; i++) {
                 const Lit litOrig = Lit(var, i);
-                if (implCache[litOrig.toInt()].lits.empty())
+                if (slots[litOrig.toInt()].num == 0)
                     continue;
 
                 const Lit lit = solver->varReplacer->get_lit_replaced_with(litOrig);
 
                 //Updated literal must be normal, otherwise, biig problems e.g
                 //implCache is not even large enough, etc.
-                if (solver->varData[lit.var()].removed == Removed::none) {
-                    bool taut = implCache.at(lit.toInt()).merge(
-                        implCache[litOrig.toInt()].lits
+                if (solver->varFlags.removed(lit.var()) == Removed::none) {
+                    solver->varReplacer->get_scc_finder()->mark_dirty(lit.var());
+                    bool taut = merge(
+                        lit
+                        , (*this)[litOrig]
                         , lit_Undef //nothing to add
                         , false //replaced, so 'irred'
                         , lit.var() //exclude the literal itself
@@ -149,34 +222,29 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
 
         //Free it
         if (solver->value(var) != l_Undef
-            || solver->varData[var].removed != Removed::none
+            || solver->varFlags.removed(var) != Removed::none
         ) {
-            vector<LitExtra> tmp1;
-            numFreed += implCache[Lit(var, false).toInt()].lits.capacity();
-            implCache[Lit(var, false).toInt()].lits.swap(tmp1);
-
-            vector<LitExtra> tmp2;
-            numFreed += implCache[Lit(var, true).toInt()].lits.capacity();
-            implCache[Lit(var, true).toInt()].lits.swap(tmp2);
+            for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+                Slot& slot = slots[lit.toInt()];
+                numFreed += slot.num;
+                unused += slot.bytes;
+                slot = Slot();
+            }
         }
     }
 
     vector<uint16_t>& inside = solver->seen;
     vector<uint8_t>& irred = solver->seen2;
-    size_t wsLit = 0;
-    for(vector<TransCache>::iterator
-        trans = implCache.begin(), transEnd = implCache.end()
-        ; trans != transEnd
-        ; trans++, wsLit++
-    ) {
+    for(size_t wsLit = 0; wsLit < slots.size(); wsLit++) {
         //Stats
-        size_t origSize = trans->lits.size();
+        Lit vertLit = Lit::toLit(wsLit);
+        decode(vertLit, tmp_lits);
+        size_t origSize = tmp_lits.size();
         size_t newSize = 0;
 
         //Update to replaced vars, remove vars already set or eliminated
-        Lit vertLit = Lit::toLit(wsLit);
-        for (vector<LitExtra>::iterator end = trans->lits.end(),
-            it=trans->lits.begin(), it2 = trans->lits.begin()
+        for (vector<LitExtra>::iterator end = tmp_lits.end(),
+            it=tmp_lits.begin(), it2 = tmp_lits.begin()
             ; it != end
             ; ++it
         ) {
@@ -188,7 +256,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
                 continue;
 
             //Update to its replaced version
-            if (solver->varData[lit.var()].removed == Removed::replaced) {
+            if (solver->varFlags.removed(lit.var()) == Removed::replaced) {
                 lit = solver->varReplacer->get_lit_replaced_with(lit);
 
                 //This would be tautological (and incorrect), so skip
@@ -203,7 +271,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
                 continue;
 
             //If updated version is eliminated/decomposed, skip
-            if (solver->varData[lit.var()].removed != Removed::none)
+            if (solver->varFlags.removed(lit.var()) != Removed::none)
                 continue;
 
             //Mark irred
@@ -218,14 +286,14 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
             *it2++ = LitExtra(lit, it->getOnlyIrredBin());
             newSize++;
         }
-        trans->lits.resize(newSize);
+        tmp_lits.resize(newSize);
 
         //Now that we have gone through the list, go through once more to:
         //1) set irred right (above we might have it set later)
         //2) clear 'inside'
         //3) clear 'irred'
         for (vector<LitExtra>::iterator
-            it2 = trans->lits.begin(), end2 = trans->lits.end()
+            it2 = tmp_lits.begin(), end2 = tmp_lits.end()
             ;it2 != end2
             ; it2++
         ) {
@@ -240,10 +308,11 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
 
             //Set non-leartness correctly
             *it2 = LitExtra(lit, nRed);
-            assert(solver->varData[it2->getLit().var()].removed == Removed::none);
+            assert(solver->varFlags.removed(it2->getLit().var()) == Removed::none);
             assert(solver->value(it2->getLit()) == l_Undef);
         }
-        numCleaned += origSize-trans->lits.size();
+        numCleaned += origSize-tmp_lits.size();
+        store(vertLit, tmp_lits);
     }
 
     size_t origTrailDepth = solver->trail_size();
@@ -314,7 +383,7 @@ bool ImplCache::addDelayedClauses(Solver* solver)
                 ; it2 != end2
                 ; it2++
             ) {
-                if (solver->varData[it2->var()].removed != Removed::none) {
+                if (solver->varFlags.removed(it2->var()) != Removed::none) {
                     //Var has been eliminated one way or another. Don't add this clause
                     OK = false;
                     break;
@@ -374,7 +443,7 @@ bool ImplCache::tryBoth(Solver* solver)
 
         //If value is set or eliminated, skip
         if (solver->value(var) != l_Undef
-            || solver->varData[var].removed != Removed::none
+            || solver->varFlags.removed(var) != Removed::none
         ) {
             continue;
         }
@@ -420,27 +489,23 @@ void ImplCache::tryVar(
 
     Lit lit = Lit(var, false);
 
-    const vector<LitExtra>& cache1 = implCache[lit.toInt()].lits;
+    const CacheLits cache1 = (*this)[lit];
     assert(solver->watches.size() > (lit.toInt()));
     watch_subarray_const ws1 = solver->watches[lit];
-    const vector<LitExtra>& cache2 = implCache[(~lit).toInt()].lits;
+    const CacheLits cache2 = (*this)[~lit];
     watch_subarray_const ws2 = solver->watches[~lit];
 
     //Fill 'seen' and 'val' from cache
-    for (vector<LitExtra>::const_iterator
-        it = cache1.begin(), end = cache1.end()
-        ; it != end
-        ; ++it
-    ) {
-        const uint32_t var2 = it->getLit().var();
+    for (const LitExtra l: cache1) {
+        const uint32_t var2 = l.getLit().var();
 
         //A variable that has been really eliminated, skip
-        if (solver->varData[var2].removed != Removed::none) {
+        if (solver->varFlags.removed(var2) != Removed::none) {
             continue;
         }
 
-        seen[it->getLit().var()] = 1;
-        val[it->getLit().var()] = it->getLit().sign();
+        seen[l.getLit().var()] = 1;
+        val[l.getLit().var()] = l.getLit().sign();
     }
 
     //Fill 'seen' and 'val' from watch
@@ -465,24 +530,20 @@ void ImplCache::tryVar(
 
     //Try to see if we propagate the same or opposite from the other end
     //Using cache
-    for (vector<LitExtra>::const_iterator
-        it = cache2.begin(), end = cache2.end()
-        ; it != end
-        ; ++it
-    ) {
-        assert(it->getLit().var() != var);
-        const uint32_t var2 = it->getLit().var();
+    for (const LitExtra l: cache2) {
+        assert(l.getLit().var() != var);
+        const uint32_t var2 = l.getLit().var();
 
         //Only if the other one also contained it
         if (!seen[var2])
             continue;
 
         //If var has been removed, skip
-        if (solver->varData[var2].removed != Removed::none) {
+        if (solver->varFlags.removed(var2) != Removed::none) {
             continue;
         }
 
-        handleNewData(val, var, it->getLit());
+        handleNewData(val, var, l.getLit());
     }
 
     //Try to see if we propagate the same or opposite from the other end
@@ -503,9 +564,9 @@ void ImplCache::tryVar(
     }
 
     //Clear 'seen' and 'val'
-    for (vector<LitExtra>::const_iterator it = cache1.begin(), end = cache1.end(); it != end; ++it) {
-        seen[it->getLit().var()] = false;
-        val[it->getLit().var()] = false;
+    for (const LitExtra l: cache1) {
+        seen[l.getLit().var()] = false;
+        val[l.getLit().var()] = false;
     }
 
     for (const Watched *it = ws1.begin(), *end = ws1.end(); it != end; ++it) {
@@ -517,29 +578,31 @@ void ImplCache::tryVar(
     }
 }
 
-bool TransCache::merge(
-    const vector<LitExtra>& otherLits //Lits to add
+bool ImplCache::merge(
+    const Lit at
+    , const CacheLits& otherLits //Lits to add
     , const Lit extraLit //Add this, too to the list of lits
     , const bool red //The step was a redundant-dependent step?
     , const uint32_t leaveOut //Leave this literal out
     , vector<uint16_t>& seen
 ) {
-    //Mark every literal that is to be added in 'seen'
-    for (size_t i = 0, size = otherLits.size(); i < size; i++) {
-        const Lit lit = otherLits[i].getLit();
-        const bool onlyIrred = otherLits[i].getOnlyIrredBin();
+    decode(at, tmp_lits);
 
-        seen[lit.toInt()] = 1 + (int)onlyIrred;
+    //Mark every literal that is to be added in 'seen'
+    for (const LitExtra l: otherLits) {
+        seen[l.getLit().toInt()] = 1 + (int)l.getOnlyIrredBin();
     }
 
-    bool taut = mergeHelper(extraLit, red, seen);
+    bool changed = false;
+    const size_t origSize = tmp_lits.size();
+    bool taut = mergeHelper(extraLit, red, seen, changed);
 
     //Whatever rests needs to be added
-    for (size_t i = 0 ,size = otherLits.size(); i < size; i++) {
-        const Lit lit = otherLits[i].getLit();
+    for (const LitExtra l: otherLits) {
+        const Lit lit = l.getLit();
         if (seen[lit.toInt()]) {
             if (lit.var() != leaveOut)
-                lits.push_back(LitExtra(lit, !red && otherLits[i].getOnlyIrredBin()));
+                tmp_lits.push_back(LitExtra(lit, !red && l.getOnlyIrredBin()));
             seen[lit.toInt()] = 0;
         }
     }
@@ -547,34 +610,44 @@ bool TransCache::merge(
     //Handle extra lit
     if (extraLit != lit_Undef && seen[extraLit.toInt()]) {
         if (extraLit.var() != leaveOut)
-            lits.push_back(LitExtra(extraLit, !red));
+            tmp_lits.push_back(LitExtra(extraLit, !red));
         seen[extraLit.toInt()] = 0;
     }
 
+    //otherLits may point into the arena, so it must not be used from here
+    if (changed || tmp_lits.size() != origSize) {
+        store(at, tmp_lits, origSize);
+    }
+
     return taut;
 }
 
-bool TransCache::merge(
-    const vector<Lit>& otherLits //Lits to add
+bool ImplCache::merge(
+    const Lit at
+    , const vector<Lit>& otherLits //Lits to add
     , const Lit extraLit //Add this, too to the list of lits
     , const bool red //The step was a redundant-dependent step?
     , const uint32_t leaveOut //Leave this literal out
     , vector<uint16_t>& seen
 ) {
+    decode(at, tmp_lits);
+
     //Mark every literal that is to be added in 'seen'
     for (size_t i = 0, size = otherLits.size(); i < size; i++) {
         const Lit lit = otherLits[i];
         seen[lit.toInt()] = 1;
     }
 
-    bool taut = mergeHelper(extraLit, red, seen);
+    bool changed = false;
+    const size_t origSize = tmp_lits.size();
+    bool taut = mergeHelper(extraLit, red, seen, changed);
 
     //Whatever rests needs to be added
     for (size_t i = 0 ,size = otherLits.size(); i < size; i++) {
         const Lit lit = otherLits[i];
         if (seen[lit.toInt()]) {
             if (lit.var() != leaveOut)
-                lits.push_back(LitExtra(lit, false));
+                tmp_lits.push_back(LitExtra(lit, false));
             seen[lit.toInt()] = 0;
         }
     }
@@ -582,17 +655,23 @@ bool TransCache::merge(
     //Handle extra lit
     if (extraLit != lit_Undef && seen[extraLit.toInt()]) {
         if (extraLit.var() != leaveOut)
-            lits.push_back(LitExtra(extraLit, !red));
+            tmp_lits.push_back(LitExtra(extraLit, !red));
         seen[extraLit.toInt()] = 0;
     }
 
+    if (changed || tmp_lits.size() != origSize) {
+        store(at, tmp_lits, origSize);
+    }
+
     return taut;
 }
 
-bool TransCache::mergeHelper(
+//Works on tmp_lits, the decoded list being merged into
+bool ImplCache::mergeHelper(
     const Lit extraLit //Add this, too to the list of lits
     , const bool red //The step was a redundant-dependent step?
     , vector<uint16_t>& seen
+    , bool& changed
 ) {
     bool taut = false;
 
@@ -603,18 +682,19 @@ bool TransCache::mergeHelper(
     //Everything that's already in the cache, set seen[] to zero
     //Also, if seen[] is 2, but it's marked redundant in the cache
     //mark it as irred
-    for (size_t i = 0, size = lits.size(); i < size; i++) {
+    for (size_t i = 0, size = tmp_lits.size(); i < size; i++) {
         if (!red
-            && !lits[i].getOnlyIrredBin()
-            && seen[lits[i].getLit().toInt()] == 2
+            && !tmp_lits[i].getOnlyIrredBin()
+            && seen[tmp_lits[i].getLit().toInt()] == 2
         ) {
-            lits[i].setOnlyIrredBin();
+            tmp_lits[i].setOnlyIrredBin();
+            changed = true;
         }
 
-        seen[lits[i].getLit().toInt()] = 0;
+        seen[tmp_lits[i].getLit().toInt()] = 0;
 
         //Both L and ~L are in, the ancestor is a tautology
-        if (seen[(~(lits[i].getLit())).toInt()]) {
+        if (seen[(~(tmp_lits[i].getLit())).toInt()]) {
             taut = true;
         }
     }
@@ -622,35 +702,21 @@ bool TransCache::mergeHelper(
     return taut;
 }
 
-//Make all literals as if propagated only by redundant
-void TransCache::makeAllRed()
-{
-    for(size_t i = 0; i < lits.size(); i++) {
-        lits[i] = LitExtra(lits[i].getLit(), false);
-    }
-
-}
-
-void TransCache::updateVars(
-    const std::vector< uint32_t >& outerToInter
-    , const size_t newMaxVars
-) {
-    for(size_t i = 0; i < lits.size(); i++) {
-        lits[i] = LitExtra(getUpdatedLit(lits[i].getLit(), outerToInter), lits[i].getOnlyIrredBin());
-        assert(lits[i].getLit().var() < newMaxVars);
-    }
-
-}
-
 void ImplCache::updateVars(
     vector<uint16_t>& seen
     , const std::vector< uint32_t >& outerToInter
     , const std::vector< uint32_t >& interToOuter2
-    , const size_t newMaxVar
+    , const size_t newMaxVars
 ) {
-    updateBySwap(implCache, seen, interToOuter2);
-    for(size_t i = 0; i < implCache.size(); i++) {
-        implCache[i].updateVars(outerToInter, newMaxVar);
+    updateBySwap(slots, seen, interToOuter2);
+    for(size_t i = 0; i < slots.size(); i++) {
+        const Lit lit = Lit::toLit(i);
+        decode(lit, tmp_lits);
+        for(LitExtra& l: tmp_lits) {
+            l = LitExtra(getUpdatedLit(l.getLit(), outerToInter), l.getOnlyIrredBin());
+            assert(l.getLit().var() < newMaxVars);
+        }
+        store(lit, tmp_lits);
     }
 }
 
@@ -58,6 +58,18 @@ public:
         x  |= 0x1;
     }
 
+    uint32_t toInt() const
+    {
+        return x;
+    }
+
+    static LitExtra toLitExtra(const uint32_t data)
+    {
+        LitExtra l;
+        l.x = data;
+        return l;
+    }
+
     bool operator<(const LitExtra other) const
     {
         if (getOnlyIrredBin() && !other.getOnlyIrredBin()) return false;
@@ -79,53 +91,106 @@ private:
 
 };
 
-class TransCache {
+///Read-only view of the literals implied by a literal. They are stored
+///sorted, as varint-encoded deltas, and decoded while iterating
+class CacheLits {
 public:
-    TransCache()
-        //conflictLastUpdated(std::numeric_limits<uint64_t>::max())
+    class const_iterator {
+    public:
+        const_iterator(const uint8_t* _at, const uint8_t* _end) :
+            at(_at)
+            , end(_end)
+        {
+            decode();
+        }
+
+        LitExtra operator*() const
+        {
+            return LitExtra::toLitExtra(x);
+        }
+
+        const_iterator& operator++()
+        {
+            at = next;
+            decode();
+            return *this;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return at != other.at;
+        }
+
+    private:
+        void decode()
+        {
+            if (at == end)
+                return;
+
+            uint32_t delta = 0;
+            uint32_t shift = 0;
+            next = at;
+            while(*next & 0x80) {
+                delta |= (uint32_t)(*next++ & 0x7f) << shift;
+                shift += 7;
+            }
+            delta |= (uint32_t)(*next++) << shift;
+            x += delta;
+        }
+
+        const uint8_t* at;
+        const uint8_t* end;
+        const uint8_t* next = NULL;
+        uint32_t x = 0;
+    };
+
+    CacheLits(const uint8_t* _data, const uint32_t _bytes, const uint32_t _num) :
+        data(_data)
+        , bytes(_bytes)
+        , num(_num)
     {}
 
-    bool merge(
-        const vector<LitExtra>& otherLits
-        , const Lit extraLit
-        , const bool red
-        , const uint32_t leaveOut
-        , vector<uint16_t>& seen
-    );
-    bool merge(
-        const vector<Lit>& otherLits //Lits to add
-        , const Lit extraLit //Add this, too to the list of lits
-        , const bool red //The step was a redundant-dependent step?
-        , const uint32_t leaveOut //Leave this literal out
-        , vector<uint16_t>& seen
-    );
-    void makeAllRed();
+    const_iterator begin() const
+    {
+        return const_iterator(data, data + bytes);
+    }
 
-    void updateVars(
-        const std::vector< uint32_t >& outerToInter
-        , const size_t newMaxVars
-    );
+    const_iterator end() const
+    {
+        return const_iterator(data + bytes, data + bytes);
+    }
+
+    size_t size() const
+    {
+        return num;
+    }
 
-    std::vector<LitExtra> lits;
-    //uint64_t conflictLastUpdated;
+    bool empty() const
+    {
+        return num == 0;
+    }
 
 private:
-    bool mergeHelper(
-        const Lit extraLit //Add this, too to the list of lits
-        , const bool red //The step was a redundant-dependent step?
-        , vector<uint16_t>& seen
-    );
+    const uint8_t* data;
+    uint32_t bytes;
+    uint32_t num;
 };
 
-inline std::ostream& operator<<(std::ostream& os, const TransCache& tc)
+inline std::ostream& operator<<(std::ostream& os, const CacheLits& tc)
 {
-    for (size_t i = 0; i < tc.lits.size(); i++) {
-        os << tc.lits[i].getLit()
-        << "(" << (tc.lits[i].getOnlyIrredBin() ? "NL" : "L") << ") ";
+    for (const LitExtra l: tc) {
+        os << l.getLit()
+        << "(" << (l.getOnlyIrredBin() ? "NL" : "L") << ") ";
     }
     return os;
 }
 
+/**
+@brief The literals implied by each literal
+
+All lists live in one arena. A list that grows is rewritten at the end of
+the arena, and the arena is compacted once half of it is unused.
+*/
 class ImplCache  {
 public:
     void print_stats(const Solver* solver) const;
@@ -134,56 +199,47 @@ public:
     void makeAllRed();
     void save_on_var_memorys(uint32_t newNumVars)
     {
-        implCache.resize(newNumVars*2);
-        implCache.shrink_to_fit();
-    }
-
-    std::vector<TransCache> implCache;
-
-    std::vector<TransCache>::iterator begin()
-    {
-        return implCache.begin();
-    }
-
-    std::vector<TransCache>::iterator end()
-    {
-        return implCache.end();
-    }
-
-    std::vector<TransCache>::const_iterator begin() const
-    {
-        return implCache.begin();
-    }
-
-    std::vector<TransCache>::const_iterator end() const
-    {
-        return implCache.end();
+        slots.resize(newNumVars*2);
+        slots.shrink_to_fit();
     }
 
-    const TransCache& operator[](const Lit at) const
+    CacheLits operator[](const Lit at) const
     {
-        return implCache[at.toInt()];
+        const Slot& slot = slots[at.toInt()];
+        return CacheLits(arena.data() + slot.at, slot.bytes, slot.num);
     }
 
-    TransCache& operator[](const Lit at)
-    {
-        return implCache[at.toInt()];
-    }
+    bool merge(
+        const Lit at
+        , const CacheLits& otherLits
+        , const Lit extraLit
+        , const bool red
+        , const uint32_t leaveOut
+        , vector<uint16_t>& seen
+    );
+    bool merge(
+        const Lit at
+        , const vector<Lit>& otherLits //Lits to add
+        , const Lit extraLit //Add this, too to the list of lits
+        , const bool red //The step was a redundant-dependent step?
+        , const uint32_t leaveOut //Leave this literal out
+        , vector<uint16_t>& seen
+    );
 
     void new_var()
     {
-        implCache.push_back(TransCache());
-        implCache.push_back(TransCache());
+        slots.push_back(Slot());
+        slots.push_back(Slot());
     }
 
     void new_vars(const size_t n)
     {
-        implCache.resize(implCache.size()+2*n);
+        slots.resize(slots.size()+2*n);
     }
 
     size_t size() const
     {
-        return implCache.size();
+        return slots.size();
     }
 
     void updateVars(
@@ -224,22 +280,45 @@ public:
 
     void free()
     {
-        vector<TransCache> tmp;
-        implCache.swap(tmp);
+        vector<Slot> tmp;
+        slots.swap(tmp);
+        vector<uint8_t> tmp2;
+        arena.swap(tmp2);
+        unused = 0;
     }
 
     void clear()
     {
-        for(vector<TransCache>::iterator
-            it = implCache.begin(), end = implCache.end()
-            ; it != end
-            ; ++it
-        ) {
-            it->lits.clear();
+        for(Slot& slot: slots) {
+            slot = Slot();
         }
+        arena.clear();
+        unused = 0;
     }
 
 private:
+    struct Slot
+    {
+        uint64_t at = 0;
+        uint32_t bytes = 0;
+        uint32_t num = 0;
+    };
+    vector<Slot> slots;
+    vector<uint8_t> arena;
+    uint64_t unused = 0; ///<Bytes in the arena not in any list
+
+    void decode(const Lit at, vector<LitExtra>& out) const;
+    void store(const Lit at, vector<LitExtra>& lits, const size_t sorted = 0);
+    void compact();
+    bool mergeHelper(
+        const Lit extraLit //Add this, too to the list of lits
+        , const bool red //The step was a redundant-dependent step?
+        , vector<uint16_t>& seen
+        , bool& changed
+    );
+    vector<LitExtra> tmp_lits;
+    vector<uint8_t> tmp_bytes;
+
     void tryVar(Solver* solver, uint32_t var);
 
     void handleNewData(
@@ -255,18 +334,4 @@ private:
 
 } //end namespace
 
-namespace std
-{
-    template <>
-    inline void swap (CMSat::TransCache& m1, CMSat::TransCache& m2)
-    #ifdef _MSC_VER
-    throw()
-    #else
-    noexcept (true)
-    #endif
-    {
-         m1.lits.swap(m2.lits);
-    }
-}
-
 #endif //TRANSCACHE_H
@@ -270,6 +270,8 @@ void Main::add_supported_options()
         , "Stop solving after this much time (s)")
     ("maxconfl", po::value(&conf.maxConfl)->default_value(conf.maxConfl, "MAX")
         , "Stop solving after this many conflicts")
+    ("maxmem", po::value(&conf.maxMemMB)->default_value(conf.maxMemMB, "MAX")
+        , "Memory budget (MB). Close to it, memory is freed up by cleaning the clause database, the cache, etc. If that is not enough, solving stops and returns INDETERMINATE")
     ("undef", po::value(&conf.greedy_undef)->default_value(conf.greedy_undef)
         , "Set as many variables in solution to UNDEF as possible if solution is SAT")
     ("mult,m", po::value(&conf.orig_global_timeout_multiplier)->default_value(conf.orig_global_timeout_multiplier)
@@ -370,8 +372,12 @@ void Main::add_supported_options()
         , "Carry out probing")
     ("probemaxm", po::value(&conf.probe_bogoprops_time_limitM)->default_value(conf.probe_bogoprops_time_limitM)
       , "Time in mega-bogoprops to perform probing")
+    ("probethreads", po::value(&conf.probe_threads)->default_value(conf.probe_threads)
+        , "Number of threads to probe with")
     ("transred", po::value(&conf.doTransRed)->default_value(conf.doTransRed)
         , "Remove useless binary clauses (transitive reduction)")
+    ("transredmaxm", po::value(&conf.trans_red_time_limitM)->default_value(conf.trans_red_time_limitM)
+        , "Maximum number of Mega-bogoprops(~time) to spend on transitive reduction of the binary clauses")
     ("intree", po::value(&conf.doIntreeProbe)->default_value(conf.doIntreeProbe)
         , "Carry out intree-based probing")
     ("intreemaxm", po::value(&conf.intree_time_limitM)->default_value(conf.intree_time_limitM)
@@ -399,6 +405,10 @@ void Main::add_supported_options()
 
     ("occsimp", po::value(&conf.perform_occur_based_simp)->default_value(conf.perform_occur_based_simp)
         , "Perform occurrence-list-based optimisations (variable elimination, subsumption, bounded variable addition...)")
+    ("occdirty", po::value(&conf.occ_only_dirty)->default_value(conf.occ_only_dirty)
+        , "Only revisit variables whose clauses changed since the last complete round of subsumption and BVE")
+    ("subthreads", po::value(&conf.subsume_threads)->default_value(conf.subsume_threads)
+        , "Number of threads for long-with-long subsumption and strengthening")
 
 
     ("confbtwsimp", po::value(&conf.num_conflicts_of_search)->default_value(conf.num_conflicts_of_search)
@@ -431,6 +441,10 @@ void Main::add_supported_options()
         , "Eliminate this ratio of free variables at most per variable elimination iteration")
     ("skipresol", po::value(&conf.skip_some_bve_resolvents)->default_value(conf.skip_some_bve_resolvents)
         , "Skip BVE resolvents in case they belong to a gate")
+    ("bvethreads", po::value(&conf.varelim_threads)->default_value(conf.varelim_threads)
+        , "Number of threads to compute BVE resolvents with")
+    ("bceto", po::value(&conf.bce_time_limitM)->default_value(conf.bce_time_limitM)
+        , "Blocked/covered clause elimination time limit in bogoprops M")
     ("occredmax", po::value(&conf.maxRedLinkInSize)->default_value(conf.maxRedLinkInSize)
         , "Don't add to occur list any redundant clause larger than this")
     ("occirredmaxmb", po::value(&conf.maxOccurIrredMB)->default_value(conf.maxOccurIrredMB)
@@ -507,6 +521,12 @@ void Main::add_supported_options()
         , "Time-out in microsteps for each more minimisation with binary clauses. Only active if 'moreminim' is on")
     ("moreminimlit", po::value(&conf.max_num_lits_more_red_min)->default_value(conf.max_num_lits_more_red_min)
         , "Number of first literals to look through for more minimisation when doing learnt cl minim right after learning it")
+    ("alluip", po::value(&conf.doAllUIPShrink)->default_value(conf.doAllUIPShrink)
+        , "Shrink learnt clauses by replacing literals of a lower decision level with that level's UIP")
+    ("alluipmaxsz", po::value(&conf.max_size_all_uip_shrink)->default_value(conf.max_size_all_uip_shrink)
+        , "Only try all-UIP shrinking on learnt clauses at most this long")
+    ("alluiplimit", po::value(&conf.all_uip_shrink_limit)->default_value(conf.all_uip_shrink_limit)
+        , "Time-out in trail steps for each all-UIP shrinking. Only active if 'alluip' is on")
     ("cacheformoreminim", po::value(&conf.more_otf_shrink_with_stamp)->default_value(conf.more_otf_shrink_with_stamp)
         , "Use cache for otf more minim of learnt clauses")
     ("stampformoreminim", po::value(&conf.more_otf_shrink_with_cache)->default_value(conf.more_otf_shrink_with_cache)
@@ -518,6 +538,8 @@ void Main::add_supported_options()
     ("rewardotfsubsume", po::value(&conf.rewardShortenedClauseWithConfl)
         ->default_value(conf.rewardShortenedClauseWithConfl)
         , "Reward with this many prop&confl a clause that has been shortened with on-the-fly subsumption")
+    ("eagersubsume", po::value(&conf.eager_subsume_last_k)->default_value(conf.eager_subsume_last_k)
+        , "Remove those of the last this many learnt clauses that the newly learnt clause subsumes. 0 turns it off")
     ("printimpldot", po::value(&conf.doPrintConflDot)->default_value(conf.doPrintConflDot)
         , "Print implication graph DOT files (for input into graphviz package)")
     ;
@@ -587,16 +609,36 @@ void Main::add_supported_options()
         , "Regularly execute clause distillation")
     ("distillmaxm", po::value(&conf.distill_long_irred_cls_time_limitM)->default_value(conf.distill_long_irred_cls_time_limitM)
         , "Maximum number of Mega-bogoprops(~time) to spend on viviying long irred cls by enqueueing and propagating")
+    ("distillred", po::value(&conf.do_distill_red_clauses)->default_value(conf.do_distill_red_clauses)
+        , "Distill the long learnt clauses, too, best (lowest glue) first")
+    ("distillredmaxm", po::value(&conf.distill_red_cls_time_limitM)->default_value(conf.distill_red_cls_time_limitM)
+        , "Maximum number of Mega-bogoprops(~time) to spend on viviying long learnt cls by enqueueing and propagating")
     ("distillto", po::value(&conf.distill_time_limitM)->default_value(conf.distill_time_limitM)
         , "Maximum time in bogoprops M for distillation")
     ("distillby", po::value(&conf.distill_queue_by)->default_value(conf.distill_queue_by)
         , "Enqueue lits from long clauses during distiallation N-by-N. 1 is slower, 2 is faster, etc.")
+    ("sweep", po::value(&conf.do_sweep)->default_value(conf.do_sweep)
+        , "Find equivalent literals through random simulation of AND and XOR gates, and prove them with propagation")
+    ("sweepmaxm", po::value(&conf.sweep_time_limitM)->default_value(conf.sweep_time_limitM)
+        , "Maximum number of Mega-bogoprops(~time) to spend on SAT sweeping")
+    ("stampsweep", po::value(&conf.do_stamp_sweep)->default_value(conf.do_stamp_sweep)
+        , "Remove and strengthen all long clauses with the stamps of the binary implication graph")
+    ("stampsweepmaxm", po::value(&conf.stamp_sweep_time_limitM)->default_value(conf.stamp_sweep_time_limitM)
+        , "Maximum number of Mega-bogoprops(~time) to spend on the stamp sweep")
     ("strcachemaxm", po::value(&conf.watch_cache_stamp_based_str_time_limitM)->default_value(conf.watch_cache_stamp_based_str_time_limitM)
         , "Maximum number of Mega-bogoprops(~time) to spend on viviying long irred cls through watches, cache and stamps")
     ("renumber", po::value(&conf.doRenumberVars)->default_value(conf.doRenumberVars)
         , "Renumber variables to increase CPU cache efficiency")
     ("savemem", po::value(&conf.doSaveMem)->default_value(conf.doSaveMem)
         , "Save memory by deallocating variable space after renumbering. Only works if renumbering is active.")
+    ("incconsol", po::value(&conf.doIncrementalConsolidate)->default_value(conf.doIncrementalConsolidate)
+        , "Consolidate clause memory incrementally: only evacuate the sparsest chunks, and reuse them. Lowers peak memory use and pauses")
+    ("incconsolratio", po::value(&conf.incremental_consolidate_max_used_ratio)->default_value(conf.incremental_consolidate_max_used_ratio)
+        , "During incremental consolidation, evacuate chunks that are used at most this much")
+    ("incconsolchunks", po::value(&conf.incremental_consolidate_max_chunks)->default_value(conf.incremental_consolidate_max_chunks)
+        , "During incremental consolidation, evacuate at most this many chunks")
+    ("localconsol", po::value(&conf.doLocalityConsolidate)->default_value(conf.doLocalityConsolidate)
+        , "During full consolidation, put low-glue redundant clauses first, and clauses of the same watchlist and of active variables next to each other")
     ("implicitmanip", po::value(&conf.doStrSubImplicit)->default_value(conf.doStrSubImplicit)
         , "Subsume and strengthen implicit clauses with each other")
     ("implsubsto", po::value(&conf.subsume_implicit_time_limitM)->default_value(conf.subsume_implicit_time_limitM)
@@ -1177,6 +1219,9 @@ int Main::solve()
     }
     check_num_threads_sanity(num_threads);
     solver->set_num_threads(num_threads);
+    if (conf.maxMemMB != std::numeric_limits<uint64_t>::max()) {
+        solver->set_max_memory(conf.maxMemMB);
+    }
     if (sql != 0) {
         solver->set_sqlite(sqlite_filename);
     }
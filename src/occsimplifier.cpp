@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <limits>
 #include <cmath>
 #include <functional>
+#include <thread>
 
 
 #include "popcnt.h"
@@ -92,7 +93,6 @@ OccSimplifier::OccSimplifier(Solver* _solver):
     , velim_order(VarOrderLt(varElimComplexity))
     , topLevelGauss(NULL)
     //, gateFinder(NULL)
-    , anythingHasBeenBlocked(false)
     , blockedMapBuilt(false)
 {
     bva = new BVA(solver, this);
@@ -132,10 +132,19 @@ void OccSimplifier::save_on_var_memory()
     cl_to_free_later.shrink_to_fit();
 
     touched.shrink_to_fit();
+    elim_work = ElimWork();
+    elim_thread_work.clear();
+    elim_thread_work.shrink_to_fit();
+    elim_batch.clear();
+    elim_batch.shrink_to_fit();
+    elim_batch_mark.clear();
+    elim_batch_mark.shrink_to_fit();
     resolvents.shrink_to_fit();
-    poss_gate_parts.shrink_to_fit();
-    negs_gate_parts.shrink_to_fit();
-    blockedClauses.shrink_to_fit();;
+    resolvent_lits.shrink_to_fit();
+    tmp_resolvent.shrink_to_fit();
+    blockedClauses.shrink_to_fit();
+    blkcls.shrink_to_fit();
+    tmp_blk_lits.shrink_to_fit();
 }
 
 void OccSimplifier::print_blocked_clauses_reverse() const
@@ -150,8 +159,11 @@ void OccSimplifier::print_blocked_clauses_reverse() const
             << "dummy blocked clause for literal (internal number) " << it->blockedOn
             << endl;
         } else {
+            cout << "blocked clause (internal number) ";
+            for(uint64_t i = it->start; i < it->end; i++) {
+                cout << blkcls[i] << " ";
+            }
             cout
-            << "blocked clause (internal number) " << it->lits
             << " blocked on var (internal numbering) "
             << solver->map_outer_to_inter(it->blockedOn.var()) + 1
             << endl;
@@ -161,10 +173,13 @@ void OccSimplifier::print_blocked_clauses_reverse() const
 
 void OccSimplifier::dump_blocked_clauses(std::ostream* outfile) const
 {
-    for (BlockedClause blocked: blockedClauses) {
+    vector<Lit> lits;
+    for (const BlockedClause& blocked: blockedClauses) {
         if (blocked.dummy)
             continue;
 
+        lits.assign(blkcls.begin() + blocked.start, blkcls.begin() + blocked.end);
+
         //Print info about clause
         *outfile
         << "c next clause is eliminated/blocked on lit "
@@ -173,7 +188,7 @@ void OccSimplifier::dump_blocked_clauses(std::ostream* outfile) const
 
         //Print clause
         *outfile
-        << sortLits(blocked.lits)
+        << sortLits(lits)
         << " 0"
         << endl;
     }
@@ -184,7 +199,7 @@ void OccSimplifier::extend_model(SolutionExtender* extender)
     //Either a variable is not eliminated, or its value is undef
     for(size_t i = 0; i < solver->nVarsOuter(); i++) {
         const uint32_t outer = solver->map_inter_to_outer(i);
-        assert(solver->varData[i].removed != Removed::elimed
+        assert(solver->varFlags.removed(i) != Removed::elimed
             || (solver->value(i) == l_Undef && solver->model_value(outer) == l_Undef)
         );
     }
@@ -202,7 +217,7 @@ void OccSimplifier::extend_model(SolutionExtender* extender)
             if (!it2->dummy
                 && !it->toRemove
             ) {
-                __builtin_prefetch(it->lits.data());
+                __builtin_prefetch(blkcls.data() + it2->start);
             }
         }
         if (it->toRemove) {
@@ -213,8 +228,11 @@ void OccSimplifier::extend_model(SolutionExtender* extender)
         if (it->dummy) {
             extender->dummyBlocked(it->blockedOn);
         } else {
-            for(Lit& l: it->lits) {
+            tmp_blk_lits.clear();
+            for(uint64_t at = it->start; at < it->end; at++) {
+                Lit& l = blkcls[at];
                 l = solver->varReplacer->get_lit_replaced_with_outer(l);
+                tmp_blk_lits.push_back(l);
                 if (solver->model_value(l) == l_True) {
                     goto next;
                 }
@@ -226,10 +244,17 @@ void OccSimplifier::extend_model(SolutionExtender* extender)
                 ) {
                     it->toRemove = true;
                     can_remove_blocked_clauses = true;
+                    if (it->bce) {
+                        num_bce_cls_on_stack--;
+                    }
                     goto next;
                 }
             }
-            extender->addClause(it->lits, it->blockedOn);
+            if (it->bce) {
+                extender->addBlockedClause(tmp_blk_lits, it->blockedOn);
+            } else {
+                extender->addClause(tmp_blk_lits, it->blockedOn);
+            }
         }
         next:;
     }
@@ -253,6 +278,7 @@ void OccSimplifier::unlink_clause(
         for (const Lit lit: cl) {
             touched.touch(lit);
         }
+        mark_elim_batch_changed(cl);
     }
 
     if (!only_set_is_removed) {
@@ -432,16 +458,47 @@ uint64_t OccSimplifier::calc_mem_usage_of_occur(const vector<ClOffset>& toAdd) c
         ; ++it
     ) {
         Clause* cl = solver->cl_alloc.ptr(*it);
-        //*2 because of the overhead of allocation
-        memUsage += cl->size()*sizeof(Watched)*2;
+        //No overhead, the occurrences are laid out exactly, see reserve_occur_space()
+        memUsage += cl->size()*sizeof(Watched);
     }
 
-    //Estimate malloc overhead
+    //Overflow of the lists that grow during simplification
     memUsage += solver->num_active_vars()*2*40;
 
     return memUsage;
 }
 
+//Counts the occurrences that will be linked in, and lays out the
+//occurrence lists back-to-back with exactly that much space
+void OccSimplifier::reserve_occur_space(const bool link_in_red)
+{
+    vector<uint32_t> extra(solver->watches.size(), 0);
+    for(const ClOffset offs: solver->longIrredCls) {
+        const Clause* cl = solver->cl_alloc.ptr(offs);
+        for(const Lit lit: *cl) {
+            extra[lit.toInt()]++;
+        }
+    }
+
+    //Must mirror the decisions of link_in_clauses()
+    if (link_in_red) {
+        int64_t link_in_lit_limit = solver->conf.maxOccurRedLitLinkedM*1000ULL*1000ULL;
+        for(const ClOffset offs: solver->longRedCls[0]) {
+            const Clause* cl = solver->cl_alloc.ptr(offs);
+            if (cl->size() < solver->conf.maxRedLinkInSize
+                && link_in_lit_limit > 0
+            ) {
+                for(const Lit lit: *cl) {
+                    extra[lit.toInt()]++;
+                }
+                link_in_lit_limit -= cl->size();
+            }
+        }
+    }
+
+    solver->watches.reserve_pooled(extra);
+}
+
 void OccSimplifier::print_mem_usage_of_occur(uint64_t memUsage) const
 {
     if (solver->conf.verbosity) {
@@ -553,20 +610,20 @@ bool OccSimplifier::check_varelim_when_adding_back_cl(const Clause* cl) const
         //The clause was too long, and wasn't linked in
         //but has been var-elimed, so remove it
         if (!cl->getOccurLinked()
-            && solver->varData[it2->var()].removed == Removed::elimed
+            && solver->varFlags.removed(it2->var()) == Removed::elimed
         ) {
             notLinkedNeedFree = true;
         }
 
         if (cl->getOccurLinked()
-            && solver->varData[it2->var()].removed != Removed::none
+            && solver->varFlags.removed(it2->var()) != Removed::none
         ) {
             std::cerr
             << "ERROR! Clause " << *cl
             << " red: " << cl->red()
             << " contains lit " << *it2
             << " which has removed status"
-            << removed_type_to_string(solver->varData[it2->var()].removed)
+            << removed_type_to_string(solver->varFlags.removed(it2->var()))
             << endl;
 
             assert(false);
@@ -692,7 +749,7 @@ bool OccSimplifier::can_eliminate_var(const uint32_t var) const
 {
     assert(var <= solver->nVars());
     if (solver->value(var) != l_Undef
-        || solver->varData[var].removed != Removed::none
+        || solver->varFlags.removed(var) != Removed::none
         ||  solver->var_inside_assumptions(var)
     ) {
         return false;
@@ -713,6 +770,14 @@ bool OccSimplifier::eliminate_vars()
     limit_to_decrease = &norm_varelim_time_limit;
     cl_to_free_later.clear();
     assert(solver->watches.get_smudged_list().empty());
+    elim_work.seen.resize(solver->nVars()*2, 0);
+    if (solver->conf.varelim_threads > 1) {
+        elim_thread_work.resize(solver->conf.varelim_threads);
+        for(ElimWork& w: elim_thread_work) {
+            w.seen.resize(solver->nVars()*2, 0);
+        }
+        elim_batch_mark.resize(solver->nVars(), 0);
+    }
     order_vars_for_elim();
     bvestats.clear();
     bvestats.numCalls = 1;
@@ -730,6 +795,16 @@ bool OccSimplifier::eliminate_vars()
             && !solver->must_interrupt_asap()
         ) {
             assert(limit_to_decrease == &norm_varelim_time_limit);
+            if (solver->conf.varelim_threads > 1) {
+                const size_t elimed = eliminate_var_batch(wenThrough);
+                vars_elimed += elimed;
+                last_elimed += elimed;
+                if (!solver->ok)
+                    goto end;
+
+                continue;
+            }
+
             uint32_t var = velim_order.removeMin();
 
             //Stats
@@ -804,6 +879,10 @@ end:
         cout
         << "c  #try to eliminate: " << wenThrough << endl
         << "c  #var-elim: " << vars_elimed << endl
+        << "c  #var-elim with gate and/xor/ite: "
+        << bvestats.elimedWithAndGate << "/"
+        << bvestats.elimedWithXorGate << "/"
+        << bvestats.elimedWithIteGate << endl
         << "c  #T-o: " << (time_out ? "Y" : "N") << endl
         << "c  #T-r: " << std::fixed << std::setprecision(2) << (time_remain*100.0) << "%" << endl
         << "c  #T: " << time_used << endl;
@@ -825,6 +904,11 @@ end:
     }
 
     assert(limit_to_decrease == &norm_varelim_time_limit);
+    bve_complete = solver->ok
+        && !time_out
+        && varelim_num_limit > 0
+        && velim_order.empty()
+        && !solver->must_interrupt_asap();
     bvestats.varElimTimeOut += time_out;
     bvestats.timeUsed = cpuTime() - myTime;
     bvestats_global += bvestats;
@@ -832,6 +916,241 @@ end:
     return solver->ok;
 }
 
+size_t OccSimplifier::ElimWork::mem_used() const
+{
+    size_t b = 0;
+    b += seen.capacity()*sizeof(uint16_t);
+    b += dummy.capacity()*sizeof(Lit);
+    b += toClear.capacity()*sizeof(Lit);
+    b += stamp_norm.capacity()*sizeof(Lit);
+    b += stamp_inv.capacity()*sizeof(Lit);
+    b += poss_gate.capacity()*sizeof(char);
+    b += negs_gate.capacity()*sizeof(char);
+    b += poss_tri.capacity()*sizeof(std::pair<Lit, Lit>);
+    b += negs_tri.capacity()*sizeof(std::pair<Lit, Lit>);
+    b += poss_tri_at.capacity()*sizeof(uint32_t);
+    b += negs_tri_at.capacity()*sizeof(uint32_t);
+
+    return b;
+}
+
+namespace CMSat {
+struct OneThreadElim
+{
+    OneThreadElim(
+        OccSimplifier* _simplifier
+        , const size_t _tid
+        , const size_t _num_threads
+        , const int64_t _limit
+        , const int64_t _aggressive_limit
+    ) :
+        simplifier(_simplifier)
+        , tid(_tid)
+        , num_threads(_num_threads)
+        , limit(_limit)
+        , aggressive_limit(_aggressive_limit)
+    {
+    }
+
+    void operator()()
+    {
+        OccSimplifier::ElimWork& w = simplifier->elim_thread_work[tid];
+        for(size_t i = tid; i < simplifier->elim_batch.size(); i += num_threads) {
+            OccSimplifier::ElimCand& c = simplifier->elim_batch[i];
+            w.limit = limit;
+            w.aggressive_limit = aggressive_limit;
+            c.ret = simplifier->test_elim_and_fill_resolvents(
+                c.var, w, c.resolvents, c.resolvent_lits);
+            c.cost = limit - w.limit;
+            c.aggressive_cost = aggressive_limit - w.aggressive_limit;
+            c.used_aggressive = w.used_aggressive;
+            c.gate = w.gate;
+        }
+    }
+
+    OccSimplifier* simplifier;
+    const size_t tid;
+    const size_t num_threads;
+    const int64_t limit;
+    const int64_t aggressive_limit;
+};
+}
+
+//Adds var to the batch unless an irred clause of it contains a var already
+//in the batch. Eliminating a var of the batch then cannot remove or create
+//clauses of any other var in it
+bool OccSimplifier::add_to_elim_batch(const uint32_t var)
+{
+    if (elim_batch_mark[var]) {
+        return false;
+    }
+
+    elim_nbh.clear();
+    for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+        watch_subarray_const ws = solver->watches[lit];
+        *limit_to_decrease -= (long)ws.size();
+        for(const Watched& w: ws) {
+            if (w.isBin()) {
+                if (w.red())
+                    continue;
+
+                if (elim_batch_mark[w.lit2().var()] >= 2)
+                    return false;
+
+                elim_nbh.push_back(w.lit2().var());
+            } else if (w.isClause()) {
+                const Clause& cl = *solver->cl_alloc.ptr(w.get_offset());
+                if (cl.getRemoved() || cl.red())
+                    continue;
+
+                *limit_to_decrease -= (long)cl.size();
+                for(const Lit l: cl) {
+                    if (elim_batch_mark[l.var()] >= 2)
+                        return false;
+
+                    elim_nbh.push_back(l.var());
+                }
+            }
+        }
+    }
+
+    elim_batch_mark[var] = 2;
+    elim_batch_marked.push_back(var);
+    for(const uint32_t v: elim_nbh) {
+        if (!elim_batch_mark[v]) {
+            elim_batch_mark[v] = 1;
+            elim_batch_marked.push_back(v);
+        }
+    }
+
+    return true;
+}
+
+//Subsumption and strengthening with the resolvents of a var can still touch
+//the clauses of other vars in the batch. Their resolvents are then recomputed
+void OccSimplifier::mark_elim_batch_changed(const Clause& cl)
+{
+    if (elim_batch_marked.empty()) {
+        return;
+    }
+
+    for(const Lit lit: cl) {
+        if (elim_batch_mark[lit.var()] == 2) {
+            elim_batch_mark[lit.var()] = 3;
+        }
+    }
+}
+
+void OccSimplifier::clear_elim_batch_marks()
+{
+    for(const uint32_t var: elim_batch_marked) {
+        elim_batch_mark[var] = 0;
+    }
+    elim_batch_marked.clear();
+}
+
+/**
+@brief Eliminates a batch of variables taken from velim_order
+
+The variables in the batch share no irred clause. Their resolvents are
+computed in parallel, then the eliminations are done one by one, in heap
+order, exactly as maybe_eliminate() would do them.
+*/
+size_t OccSimplifier::eliminate_var_batch(size_t& wenThrough)
+{
+    const size_t max_batch = 256;
+    elim_batch.clear();
+    elim_batch_skipped.clear();
+    while(!velim_order.empty()
+        && elim_batch.size() < max_batch
+        && elim_batch_skipped.size() < max_batch
+        && *limit_to_decrease > 0
+    ) {
+        const uint32_t var = velim_order.removeMin();
+        if (!can_eliminate_var(var)) {
+            *limit_to_decrease -= 20;
+            wenThrough++;
+            continue;
+        }
+
+        if (!add_to_elim_batch(var)) {
+            elim_batch_skipped.push_back(var);
+            continue;
+        }
+        elim_batch.push_back(ElimCand());
+        elim_batch.back().var = var;
+    }
+    for(const uint32_t var: elim_batch_skipped) {
+        velim_order.insert(var);
+    }
+
+    //Compute resolvents in parallel
+    const size_t num_threads = solver->conf.varelim_threads;
+    vector<std::thread> thds;
+    for(size_t i = 0; i < num_threads; i++) {
+        thds.push_back(std::thread(OneThreadElim(
+            this, i, num_threads, *limit_to_decrease, aggressive_elim_time_limit)));
+    }
+    for(std::thread& thread : thds) {
+        thread.join();
+    }
+
+    //Eliminate in order
+    size_t elimed = 0;
+    size_t at = 0;
+    for(; at < elim_batch.size(); at++) {
+        if (*limit_to_decrease <= 0
+            || varelim_num_limit <= 0
+            || solver->must_interrupt_asap()
+        ) {
+            break;
+        }
+
+        ElimCand& c = elim_batch[at];
+        *limit_to_decrease -= 20;
+        wenThrough++;
+        if (!can_eliminate_var(c.var))
+            continue;
+
+        bool eliminated;
+        if (elim_batch_mark[c.var] == 3) {
+            eliminated = maybe_eliminate(c.var);
+        } else {
+            print_var_elim_complexity_stats(c.var);
+            bvestats.testedToElimVars++;
+            bvestats.usedAggressiveCheckToELim += c.used_aggressive;
+            *limit_to_decrease -= c.cost;
+            aggressive_elim_time_limit -= c.aggressive_cost;
+
+            eliminated = c.ret != std::numeric_limits<int>::max()
+                && *limit_to_decrease >= 0;
+            if (eliminated) {
+                bvestats.triedToElimVars++;
+                count_elim_gate(c.gate);
+                eliminate_var_with_resolvents(c.var, c.resolvents, c.resolvent_lits);
+            }
+        }
+        if (eliminated) {
+            elimed++;
+            varelim_num_limit--;
+        }
+        if (!solver->ok) {
+            at++;
+            break;
+        }
+    }
+
+    //Not reached, put them back
+    for(; at < elim_batch.size(); at++) {
+        if (!velim_order.inHeap(elim_batch[at].var)) {
+            velim_order.insert(elim_batch[at].var);
+        }
+    }
+    clear_elim_batch_marks();
+
+    return elimed;
+}
+
 void OccSimplifier::free_clauses_to_free()
 {
     for(ClOffset off: cl_to_free_later) {
@@ -931,6 +1250,10 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
             }
         } else if (token == "occ-bva") {
             bva->bounded_var_addition();
+        } else if (token == "occ-bce") {
+            blocked_clause_elim(false);
+        } else if (token == "occ-cce") {
+            blocked_clause_elim(true);
         } /*else if (token == "occ-gates") {
             if (solver->conf.doCache
                 && solver->conf.doGateFind
@@ -948,6 +1271,195 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
     return solver->ok;
 }
 
+static inline uint64_t mix_sig(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+//Hash of the (outer) literals of a clause, independent of their order
+static uint64_t outer_cl_sig(const Solver* solver, const Lit* lits, const uint32_t size)
+{
+    uint64_t h = size;
+    for(uint32_t i = 0; i < size; i++) {
+        h += mix_sig(solver->map_inter_to_outer(lits[i]).toInt() + 1);
+    }
+    return mix_sig(h);
+}
+
+//Every irredundant clause gets a hash of its (outer) literals, which is
+//added to the fingerprint of all its variables. Adding, removing or
+//changing a clause therefore changes the fingerprint of all its variables
+void OccSimplifier::calc_occ_sigs(vector<uint64_t>& sigs) const
+{
+    sigs.clear();
+    sigs.resize(solver->nVarsOuter(), 0);
+
+    for(const ClOffset offset: clauses) {
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        if (cl->freed() || cl->getRemoved() || cl->red()) {
+            continue;
+        }
+
+        const uint64_t h = outer_cl_sig(solver, cl->begin(), cl->size());
+        for(const Lit lit: *cl) {
+            sigs[solver->map_inter_to_outer(lit.var())] += h;
+        }
+    }
+
+    for(size_t i = 0; i < solver->nVars()*2; i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: solver->watches[lit]) {
+            if (!w.isBin() || w.red() || w.lit2() < lit) {
+                continue;
+            }
+
+            const Lit lits[2] = {lit, w.lit2()};
+            const uint64_t h = outer_cl_sig(solver, lits, 2);
+            sigs[solver->map_inter_to_outer(lit.var())] += h;
+            sigs[solver->map_inter_to_outer(w.lit2().var())] += h;
+        }
+    }
+}
+
+//Redundant clauses are not part of the fingerprints, as learnt clauses come
+//and go all the time. Only the new ones matter: an irredundant clause that
+//has not changed may subsume or strengthen them. These are the sorted
+//hashes of the redundant clauses, and if 'mark_new' is set, the variables
+//of those not in red_sig are made dirty. Returns the number made dirty
+size_t OccSimplifier::calc_red_sigs(vector<uint64_t>& sigs, const bool mark_new)
+{
+    size_t num_dirty = 0;
+    sigs.clear();
+    for(const ClOffset offset: clauses) {
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        if (cl->freed() || cl->getRemoved() || !cl->red()) {
+            continue;
+        }
+
+        sigs.push_back(outer_cl_sig(solver, cl->begin(), cl->size()));
+        if (mark_new && !std::binary_search(red_sig.begin(), red_sig.end(), sigs.back())) {
+            for(const Lit lit: *cl) {
+                char& d = dirty[solver->map_inter_to_outer(lit.var())];
+                num_dirty += !d;
+                d = 1;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < solver->nVars()*2; i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: solver->watches[lit]) {
+            if (!w.isBin() || !w.red() || w.lit2() < lit) {
+                continue;
+            }
+
+            const Lit lits[2] = {lit, w.lit2()};
+            sigs.push_back(outer_cl_sig(solver, lits, 2));
+            if (mark_new && !std::binary_search(red_sig.begin(), red_sig.end(), sigs.back())) {
+                for(const Lit l: lits) {
+                    char& d = dirty[solver->map_inter_to_outer(l.var())];
+                    num_dirty += !d;
+                    d = 1;
+                }
+            }
+        }
+    }
+    std::sort(sigs.begin(), sigs.end());
+
+    return num_dirty;
+}
+
+void OccSimplifier::mark_dirty_vars()
+{
+    sub_complete = false;
+    bve_complete = false;
+    sub_sig.clear();
+    sub_red_sig.clear();
+    dirty.clear();
+    if (!solver->conf.occ_only_dirty || occ_sig.empty()) {
+        dirty.resize(solver->nVarsOuter(), 1);
+        return;
+    }
+
+    const double myTime = cpuTime();
+    vector<uint64_t> sigs;
+    calc_occ_sigs(sigs);
+    dirty.resize(sigs.size(), 1);
+    size_t num_dirty = 0;
+    for(size_t outer = 0; outer < sigs.size(); outer++) {
+        dirty[outer] = outer >= occ_sig.size() || occ_sig[outer] != sigs[outer];
+        num_dirty += dirty[outer];
+    }
+    vector<uint64_t> red_sigs;
+    num_dirty += calc_red_sigs(red_sigs, true);
+
+    if (solver->conf.verbosity) {
+        cout << "c [occ] dirty vars: " << num_dirty << "/" << sigs.size()
+        << solver->conf.print_times(cpuTime() - myTime)
+        << endl;
+    }
+}
+
+//A variable that was not dirty during sub/str but changed since the last
+//complete round had its clauses skipped, so it is not recorded as handled
+void OccSimplifier::save_sub_sigs()
+{
+    calc_occ_sigs(sub_sig);
+    for(size_t outer = 0; outer < sub_sig.size(); outer++) {
+        const bool was_dirty = outer >= dirty.size() || dirty[outer];
+        if (!was_dirty && sub_sig[outer] != occ_sig[outer]) {
+            sub_sig[outer] = std::numeric_limits<uint64_t>::max();
+        }
+    }
+    calc_red_sigs(sub_red_sig, false);
+}
+
+//Only record what has been fully dealt with, so that anything skipped due
+//to time-outs stays dirty
+void OccSimplifier::save_occ_sigs()
+{
+    if (!solver->conf.occ_only_dirty
+        || !sub_complete
+        || !bve_complete
+        || !solver->okay()
+    ) {
+        return;
+    }
+
+    calc_occ_sigs(occ_sig);
+
+    //Changed after the last sub/str pass, e.g. by BVE resolvents or BVA
+    for(size_t outer = 0; outer < occ_sig.size(); outer++) {
+        if (outer >= sub_sig.size() || sub_sig[outer] != occ_sig[outer]) {
+            occ_sig[outer] = std::numeric_limits<uint64_t>::max();
+        }
+    }
+    sub_sig.clear();
+    red_sig.swap(sub_red_sig);
+    sub_red_sig.clear();
+
+    //Could not be eliminated due to e.g. assumptions, must try again
+    for(uint32_t var = 0; var < solver->nVars(); var++) {
+        if (solver->value(var) == l_Undef
+            && solver->varFlags.removed(var) == Removed::none
+            && !can_eliminate_var(var)
+        ) {
+            occ_sig[solver->map_inter_to_outer(var)] = std::numeric_limits<uint64_t>::max();
+        }
+    }
+}
+
+bool OccSimplifier::var_dirty(const uint32_t var) const
+{
+    const uint32_t outer = solver->map_inter_to_outer(var);
+    return outer >= dirty.size() || dirty[outer];
+}
+
 bool OccSimplifier::setup()
 {
     assert(solver->okay());
@@ -978,6 +1490,7 @@ bool OccSimplifier::setup()
     if (!fill_occur_and_print_stats()) {
         return false;
     }
+    mark_dirty_vars();
 
     set_limits();
     return solver->ok;
@@ -993,6 +1506,7 @@ bool OccSimplifier::simplify(const bool _startup, const std::string schedule)
     const size_t origBlockedSize = blockedClauses.size();
     const size_t origTrailSize = solver->trail_size();
     execute_simplifier_strategy(schedule);
+    save_occ_sigs();
 
     remove_by_drat_recently_blocked_clauses(origBlockedSize);
     finishUp(origTrailSize);
@@ -1004,6 +1518,7 @@ bool OccSimplifier::backward_sub_str()
 {
     assert(cl_to_free_later.empty());
     assert(solver->watches.get_smudged_list().empty());
+    sub_str->all_cls_tried = true;
 
     if (!sub_str->backward_sub_str_with_bins_tris()) {
         goto end;
@@ -1024,6 +1539,10 @@ bool OccSimplifier::backward_sub_str()
     if (!sub_str->handle_sub_str_with()) {
         goto end;
     }
+    sub_complete = sub_str->all_cls_tried;
+    if (sub_complete && solver->conf.occ_only_dirty) {
+        save_sub_sigs();
+    }
 
     //TODO subsume tri with bin+tri, bin with bin.
 
@@ -1045,6 +1564,15 @@ bool OccSimplifier::fill_occur()
         return false;
     }
 
+    //Redundant ones are linked in only if they don't take too much space
+    const uint64_t memUsageRed = calc_mem_usage_of_occur(solver->longRedCls[0]);
+    const bool linkin = memUsageRed <= solver->conf.maxOccurRedMB*1000ULL*1000ULL;
+
+    //Sort, so we get the shortest ones in at least
+    std::sort(solver->longRedCls[0].begin(), solver->longRedCls[0].end()
+        , ClauseSizeSorter(solver->cl_alloc));
+    reserve_occur_space(linkin);
+
     LinkInData link_in_data = link_in_clauses(
         solver->longIrredCls
         , true //add to occur list
@@ -1055,16 +1583,7 @@ bool OccSimplifier::fill_occur()
     print_linkin_data(link_in_data);
 
     //Add redundant to occur
-    memUsage = calc_mem_usage_of_occur(solver->longRedCls[0]);
-    print_mem_usage_of_occur(memUsage);
-    bool linkin = true;
-    if (memUsage > solver->conf.maxOccurRedMB*1000ULL*1000ULL) {
-        linkin = false;
-    }
-    //Sort, so we get the shortest ones in at least
-    std::sort(solver->longRedCls[0].begin(), solver->longRedCls[0].end()
-        , ClauseSizeSorter(solver->cl_alloc));
-
+    print_mem_usage_of_occur(memUsageRed);
     link_in_data = link_in_clauses(
         solver->longRedCls[0]
         , linkin
@@ -1095,7 +1614,7 @@ bool OccSimplifier::uneliminate(uint32_t var)
     //Check that it was really eliminated
     //NOTE: it's already been made a decision var, as the variable has been re-added already
     solver->set_decision_var(var);
-    assert(solver->varData[var].removed == Removed::elimed);
+    assert(solver->varFlags.removed(var) == Removed::elimed);
     assert(solver->value(var) == l_Undef);
 
     if (!blockedMapBuilt) {
@@ -1105,7 +1624,7 @@ bool OccSimplifier::uneliminate(uint32_t var)
 
     //Uneliminate it in theory
     bvestats_global.numVarsElimed--;
-    solver->varData[var].removed = Removed::none;
+    solver->varFlags.set_removed(var, Removed::none);
     solver->set_decision_var(var);
 
     //Find if variable is really needed to be eliminated
@@ -1120,21 +1639,30 @@ bool OccSimplifier::uneliminate(uint32_t var)
         size_t at = it->second[i];
 
         //Mark for removal from blocked list
+        if (blockedClauses[at].toRemove)
+            continue;
         blockedClauses[at].toRemove = true;
         can_remove_blocked_clauses = true;
+        if (blockedClauses[at].bce) {
+            num_bce_cls_on_stack--;
+        }
         assert(blockedClauses[at].blockedOn.var() == var);
 
         if (blockedClauses[at].dummy)
             continue;
 
         //Re-insert into Solver
+        tmp_blk_lits.assign(
+            blkcls.begin() + blockedClauses[at].start
+            , blkcls.begin() + blockedClauses[at].end
+        );
         #ifdef VERBOSE_DEBUG_RECONSTRUCT
         cout
-        << "Uneliminating cl " << blockedClauses[at].lits
+        << "Uneliminating cl " << tmp_blk_lits
         << " on var " << var+1
         << endl;
         #endif
-        solver->addClause(blockedClauses[at].lits);
+        solver->addClause(tmp_blk_lits);
         if (!solver->okay())
             return false;
     }
@@ -1158,7 +1686,7 @@ void OccSimplifier::remove_by_drat_recently_blocked_clauses(size_t origBlockedSi
         //If doing stamping or caching, we cannot delete binary redundant
         //clauses, because they are stored in the stamp/cache and so
         //will be used -- and DRAT will complain when used
-        if (blockedClauses[i].lits.size() <= 2
+        if (blockedClauses[i].size() <= 2
             && (solver->conf.doCache
                 || solver->conf.doStamp)
         ) {
@@ -1166,12 +1694,8 @@ void OccSimplifier::remove_by_drat_recently_blocked_clauses(size_t origBlockedSi
         }
 
         (*solver->drat) << del;
-        for(vector<Lit>::const_iterator
-            it = blockedClauses[i].lits.begin(), end = blockedClauses[i].lits.end()
-            ; it != end
-            ; ++it
-        ) {
-            (*solver->drat) << *it;
+        for(uint64_t at = blockedClauses[i].start; at < blockedClauses[i].end; at++) {
+            (*solver->drat) << blkcls[at];
         }
         (*solver->drat) << fin;
     }
@@ -1206,6 +1730,7 @@ void OccSimplifier::finishUp(
     //Add back clauses to solver
     solver->propagate_occur();
     remove_all_longs_from_watches();
+    solver->watches.release_pool();
     add_back_to_solver();
 
     //Update global stats
@@ -1249,7 +1774,7 @@ void OccSimplifier::sanityCheckElimedVars()
             continue;
 
         for (const Lit lit: *cl) {
-            if (solver->varData[lit.var()].removed == Removed::elimed) {
+            if (solver->varFlags.removed(lit.var()) == Removed::elimed) {
                 cout
                 << "Error: elimed var -- Lit " << lit << " in clause"
                 << endl
@@ -1274,8 +1799,8 @@ void OccSimplifier::sanityCheckElimedVars()
             ; it2++
         ) {
             if (it2->isBin()) {
-                if (solver->varData[lit.var()].removed == Removed::elimed
-                        || solver->varData[it2->lit2().var()].removed == Removed::elimed
+                if (solver->varFlags.removed(lit.var()) == Removed::elimed
+                        || solver->varFlags.removed(it2->lit2().var()) == Removed::elimed
                 ) {
                     cout
                     << "Error: A var is elimed in a binary clause: "
@@ -1300,6 +1825,8 @@ void OccSimplifier::set_limits()
         *solver->conf.global_timeout_multiplier;
     aggressive_elim_time_limit = 300LL *1000LL*solver->conf.aggressive_elim_time_limitM
         *solver->conf.global_timeout_multiplier;
+    bce_time_limit             = 100LL*1000LL*solver->conf.bce_time_limitM
+        *solver->conf.global_timeout_multiplier;
 
     //If variable elimination isn't going so well
     if (bvestats_global.testedToElimVars > 0
@@ -1350,6 +1877,7 @@ void OccSimplifier::cleanBlockedClauses()
     assert(solver->decisionLevel() == 0);
     vector<BlockedClause>::iterator i = blockedClauses.begin();
     vector<BlockedClause>::iterator j = blockedClauses.begin();
+    uint64_t lits_at = 0;
 
     for (vector<BlockedClause>::iterator
         end = blockedClauses.end()
@@ -1357,7 +1885,7 @@ void OccSimplifier::cleanBlockedClauses()
         ; i++
     ) {
         const uint32_t blockedOn = solver->map_outer_to_inter(i->blockedOn.var());
-        if (solver->varData[blockedOn].removed == Removed::elimed
+        if (solver->varFlags.removed(blockedOn) == Removed::elimed
             && solver->value(blockedOn) != l_Undef
         ) {
             std::cerr
@@ -1371,11 +1899,21 @@ void OccSimplifier::cleanBlockedClauses()
         if (i->toRemove) {
             blockedMapBuilt = false;
         } else {
-            assert(solver->varData[blockedOn].removed == Removed::elimed);
+            assert(i->bce || solver->varFlags.removed(blockedOn) == Removed::elimed);
+
+            //Compact the literals, too. Order is kept, so we never overwrite
+            //literals that are yet to be moved
+            const uint64_t sz = i->size();
+            std::copy(blkcls.begin() + i->start, blkcls.begin() + i->end
+                , blkcls.begin() + lits_at);
+            i->start = lits_at;
+            i->end = lits_at + sz;
+            lits_at += sz;
             *j++ = *i;
         }
     }
     blockedClauses.resize(blockedClauses.size()-(i-j));
+    blkcls.resize(lits_at);
     can_remove_blocked_clauses = false;
 }
 
@@ -1468,219 +2006,731 @@ size_t OccSimplifier::rem_cls_from_watch_due_to_varelim(
     return blockedClauses.size() - orig_blocked_cls_size;
 }
 
-void OccSimplifier::add_clause_to_blck(const Lit lit, const vector<Lit>& lits)
-{
+void OccSimplifier::add_clause_to_blck(
+    const Lit lit
+    , const vector<Lit>& lits
+    , const bool bce
+) {
     const Lit lit_outer = solver->map_inter_to_outer(lit);
-    vector<Lit> lits_outer = lits;
-    solver->map_inter_to_outer(lits_outer);
-    blockedClauses.push_back(BlockedClause(lit_outer, lits_outer));
+    const uint64_t start = blkcls.size();
+    for(const Lit l: lits) {
+        blkcls.push_back(solver->map_inter_to_outer(l));
+    }
+    blockedClauses.push_back(BlockedClause(lit_outer, start, blkcls.size()));
+    if (bce) {
+        blockedClauses.back().bce = true;
+        num_bce_cls_on_stack++;
+    }
 }
 
-bool OccSimplifier::find_gate(
-    Lit elim_lit
-    , watch_subarray_const a
-    , watch_subarray_const b
-) {
-    bool found_better = false;
-    assert(toClear.empty());
-    for(const Watched w: a) {
-        if (w.isBin()
-            && !w.red()
-        ) {
-            seen[(~w.lit2()).toInt()] = 1;
-            toClear.push_back(~w.lit2());
+//Whether any clause removed by BCE/CCE is blocked on 'var' (OUTER). Needs
+//blk_var_to_cl to be built
+bool OccSimplifier::bce_cls_blocked_on(const uint32_t var) const
+{
+    map<uint32_t, vector<size_t> >::const_iterator it = blk_var_to_cl.find(var);
+    if (it == blk_var_to_cl.end()) {
+        return false;
+    }
+
+    for(const size_t at: it->second) {
+        const BlockedClause& b = blockedClauses[at];
+        if (b.bce && !b.toRemove) {
+            return true;
         }
     }
+    return false;
+}
 
-    for(const Watched w: b) {
-        if (w.isBin()) {
+//Puts back all clauses removed by BCE/CCE in case 'lits' contains a variable
+//some of them were blocked on. The new clause, or assumption, could make
+//them non-blocked. They are re-examined during the next simplification
+bool OccSimplifier::readd_blocked_clauses_on(const vector<Lit>& lits)
+{
+    if (num_bce_cls_on_stack == 0) {
+        return solver->okay();
+    }
+
+    if (!blockedMapBuilt) {
+        cleanBlockedClauses();
+        buildBlockedMap();
+    }
+    //Clauses are blocked on the var they were blocked on at the time, which
+    //may since have been replaced by one in 'lits'
+    bool found = false;
+    for(const Lit lit: lits) {
+        const uint32_t outer = solver->map_inter_to_outer(lit.var());
+        found = bce_cls_blocked_on(outer);
+        if (!found && solver->varReplacer->var_is_replacing(outer)) {
+            for(const uint32_t v: solver->varReplacer->get_vars_replacing(lit.var())) {
+                found |= bce_cls_blocked_on(solver->map_inter_to_outer(v));
+            }
+        }
+        if (found) {
+            break;
+        }
+    }
+    if (!found) {
+        return solver->okay();
+    }
+
+    //Re-adding may uneliminate variables, which compacts blockedClauses,
+    //so copy them out first
+    vector<vector<Lit> > readd;
+    for(BlockedClause& b: blockedClauses) {
+        if (!b.bce || b.toRemove) {
             continue;
         }
 
-        if (w.isClause()) {
-            const Clause* cl = solver->cl_alloc.ptr(w.get_offset());
-            if (cl->getRemoved()) {
+        b.toRemove = true;
+        readd.push_back(vector<Lit>(blkcls.begin() + b.start, blkcls.begin() + b.end));
+    }
+    can_remove_blocked_clauses = true;
+    num_bce_cls_on_stack = 0;
+    if (solver->conf.verbosity >= 2) {
+        cout << "c [occ-bce] Re-adding " << readd.size() << " blocked clauses" << endl;
+    }
+
+    for(const vector<Lit>& cl: readd) {
+        solver->addClause(cl);
+        if (!solver->okay()) {
+            return false;
+        }
+    }
+
+    return solver->okay();
+}
+
+//Checks the resolvents on 'lit' of the clause in bce_cov with the irredundant
+//clauses. Returns true if all are tautologies, i.e. the clause is blocked
+//on 'lit'. Otherwise, if 'covered' is set, the literals present in all
+//non-tautological resolvents are appended to bce_cov (covered literal
+//addition)
+bool OccSimplifier::resolvents_blocked_on(const Lit lit, const bool covered)
+{
+    const size_t orig_size = bce_cov.size();
+    bool found_resolvent = false;
+
+    watch_subarray_const ws = solver->watches[~lit];
+    *limit_to_decrease -= (long)ws.size();
+    for(const Watched& w: ws) {
+        if (w.isBin()) {
+            if (w.red() || seen[(~w.lit2()).toInt()]) {
                 continue;
             }
 
-            assert(cl->size() > 2);
-            if (!cl->red() && cl->size()-1 > gate_lits_of_elim_cls.size()) {
-                bool OK = true;
-                for(const Lit lit: *cl) {
-                    if (lit != ~elim_lit) {
-                        if (!seen[lit.toInt()]) {
-                            OK = false;
-                            break;
-                        }
+            if (!covered) {
+                return false;
+            }
+            if (!found_resolvent) {
+                found_resolvent = true;
+                if (!seen[w.lit2().toInt()]) {
+                    bce_cov.push_back(w.lit2());
+                }
+            } else {
+                //Only w.lit2() can stay covered
+                seen2[w.lit2().toInt()] = 1;
+                size_t j = orig_size;
+                for(size_t i = orig_size; i < bce_cov.size(); i++) {
+                    if (seen2[bce_cov[i].toInt()]) {
+                        bce_cov[j++] = bce_cov[i];
                     }
                 }
+                bce_cov.resize(j);
+                seen2[w.lit2().toInt()] = 0;
+            }
+        } else if (w.isClause()) {
+            const Clause& cl = *solver->cl_alloc.ptr(w.get_offset());
+            if (cl.getRemoved() || cl.red()) {
+                continue;
+            }
+
+            *limit_to_decrease -= (long)cl.size();
+            bool taut = false;
+            for(const Lit l: cl) {
+                if (l != ~lit && seen[(~l).toInt()]) {
+                    taut = true;
+                    break;
+                }
+            }
+            if (taut) {
+                continue;
+            }
 
-                //Found all lits inside
-                if (OK) {
-                    gate_lits_of_elim_cls.clear();
-                    for(const Lit lit: *cl) {
-                        if (lit != ~elim_lit) {
-                            gate_lits_of_elim_cls.push_back(lit);
-                        }
+            if (!covered) {
+                return false;
+            }
+            if (!found_resolvent) {
+                found_resolvent = true;
+                for(const Lit l: cl) {
+                    if (l != ~lit && !seen[l.toInt()]) {
+                        bce_cov.push_back(l);
+                    }
+                }
+            } else {
+                for(const Lit l: cl) {
+                    seen2[l.toInt()] = 1;
+                }
+                size_t j = orig_size;
+                for(size_t i = orig_size; i < bce_cov.size(); i++) {
+                    if (seen2[bce_cov[i].toInt()]) {
+                        bce_cov[j++] = bce_cov[i];
                     }
-                    found_better = true;
+                }
+                bce_cov.resize(j);
+                for(const Lit l: cl) {
+                    seen2[l.toInt()] = 0;
                 }
             }
         }
-    }
 
-    for(Lit l: toClear) {
-        seen[l.toInt()] = 0;
+        //Nothing in common, neither blocked nor covered
+        if (found_resolvent && bce_cov.size() == orig_size) {
+            return false;
+        }
     }
-    toClear.clear();
 
-    return found_better;
+    for(size_t i = orig_size; i < bce_cov.size(); i++) {
+        seen[bce_cov[i].toInt()] = 1;
+    }
+    return !found_resolvent;
 }
 
-void OccSimplifier::mark_gate_in_poss_negs(
-    Lit elim_lit
-    , watch_subarray_const poss
-    , watch_subarray_const negs
+//Removes the clause if it's blocked, or with 'covered' set, if it becomes
+//blocked or a tautology after covered literal addition. The extension
+//stack gets, in order, the clause before each literal addition with the
+//literal the addition was done on, then the final clause with the
+//literal it's blocked on
+bool OccSimplifier::block_or_cover_clause(
+    const ClOffset offset
+    , const bool covered
+    , const vector<char>& can_block
 ) {
-    gate_lits_of_elim_cls.clear();
+    const Clause& cl = *solver->cl_alloc.ptr(offset);
+    const size_t max_cov_size = cl.size()*4;
+    bce_cov.clear();
+    bce_steps.clear();
+    for(const Lit lit: cl) {
+        bce_cov.push_back(lit);
+        seen[lit.toInt()] = 1;
+    }
 
-    //Either of the two is OK
-    find_gate(elim_lit, poss, negs);
-    bool gate_found_elim_pos = find_gate(~elim_lit, negs, poss);
+    Lit blocked_on = lit_Undef;
+    bool taut = false;
+    size_t i = 0;
+    while(i < bce_cov.size() && *limit_to_decrease > 0) {
+        const Lit lit = bce_cov[i++];
+        if (!can_block[lit.var()]) {
+            continue;
+        }
 
-    if (!gate_lits_of_elim_cls.empty()
-        && solver->conf.verbosity >= 10
+        const size_t size_before = bce_cov.size();
+        if (resolvents_blocked_on(lit, covered)) {
+            blocked_on = lit;
+            break;
+        }
+        if (bce_cov.size() == size_before) {
+            continue;
+        }
+
+        bce_steps.push_back(std::make_pair(size_before, lit));
+        for(size_t at = size_before; at < bce_cov.size(); at++) {
+            if (seen[(~bce_cov[at]).toInt()]) {
+                taut = true;
+            }
+        }
+        if (taut || bce_cov.size() > max_cov_size) {
+            break;
+        }
+
+        //Literals checked before may now be blocked
+        i = 0;
+    }
+
+    const bool removed = blocked_on != lit_Undef || taut;
+    if (removed) {
+        for(const auto& step: bce_steps) {
+            bce_tmp.assign(bce_cov.begin(), bce_cov.begin() + step.first);
+            add_clause_to_blck(step.second, bce_tmp, true);
+        }
+        if (blocked_on != lit_Undef) {
+            add_clause_to_blck(blocked_on, bce_cov, true);
+        }
+        blockedMapBuilt = false;
+        if (bce_steps.empty()) {
+            runStats.blocked++;
+        } else {
+            runStats.covered++;
+        }
+
+        //DRAT deletion is done once it's on the extension stack
+        unlink_clause(offset, false, false, true);
+    }
+
+    for(const Lit lit: bce_cov) {
+        seen[lit.toInt()] = 0;
+    }
+    return removed;
+}
+
+void OccSimplifier::blocked_clause_elim(const bool covered)
+{
+    const double myTime = cpuTime();
+    const int64_t orig_bce_time_limit = bce_time_limit;
+    limit_to_decrease = &bce_time_limit;
+    assert(cl_to_free_later.empty());
+    assert(solver->watches.get_smudged_list().empty());
+
+    //Solution extension flips the variable a clause was blocked on. It
+    //must not be assumed or be part of the independent set, whose
+    //projected solutions must stay the same
+    vector<char> can_block(solver->nVars(), 0);
+    for(uint32_t var = 0; var < solver->nVars(); var++) {
+        can_block[var] = solver->value(var) == l_Undef
+            && solver->varFlags.removed(var) == Removed::none
+            && !solver->var_inside_assumptions(var);
+    }
+    if (solver->conf.independent_vars) {
+        for(uint32_t outside_var: *solver->conf.independent_vars) {
+            uint32_t outer_var = solver->map_to_with_bva(outside_var);
+            outer_var = solver->varReplacer->get_var_replaced_with_outer(outer_var);
+            const uint32_t int_var = solver->map_outer_to_inter(outer_var);
+            if (int_var < solver->nVars()) {
+                can_block[int_var] = 0;
+            }
+        }
+    }
+
+    const uint64_t orig_blocked = runStats.blocked;
+    const uint64_t orig_covered = runStats.covered;
+    //Start at a random clause so time-outs don't always hit the same ones
+    const size_t start = clauses.empty() ? 0 : solver->mtrand.randInt(clauses.size()-1);
+    for(size_t num = 0
+        ; num < clauses.size() && *limit_to_decrease > 0
+        ; num++
     ) {
+        const ClOffset offset = clauses[(start + num) % clauses.size()];
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        if (cl->freed() || cl->getRemoved() || cl->red()) {
+            continue;
+        }
+        block_or_cover_clause(offset, covered, can_block);
+    }
+
+    solver->clean_occur_from_removed_clauses_only_smudged();
+    free_clauses_to_free();
+    const double time_used = cpuTime() - myTime;
+    const bool time_out = (*limit_to_decrease <= 0);
+    const double time_remain = float_div(*limit_to_decrease, orig_bce_time_limit);
+    runStats.blockTime += time_used;
+    if (solver->conf.verbosity) {
         cout
-        << "Lit: " << elim_lit
-        << " gate_lits_of_elim_cls.size():" << gate_lits_of_elim_cls << endl
-        << " gate_found_elim_pos:" << gate_found_elim_pos
+        << "c [occ-" << (covered ? "cce" : "bce") << "]"
+        << " blocked: " << runStats.blocked - orig_blocked
+        << " covered: " << runStats.covered - orig_covered
+        << solver->conf.print_times(time_used, time_out, time_remain)
         << endl;
     }
-    if (!gate_lits_of_elim_cls.empty()) {
-        gate_found_elim = true;
-        if (!gate_found_elim_pos) {
-            mark_gate_parts(elim_lit, poss, negs, poss_gate_parts, negs_gate_parts);
-        } else {
-            mark_gate_parts(~elim_lit, negs, poss, negs_gate_parts, poss_gate_parts);
-        }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , covered ? "occ-cce" : "occ-bce"
+            , time_used
+            , time_out
+            , time_remain
+        );
     }
 }
 
-void OccSimplifier::mark_gate_parts(
-    Lit elim_lit
+//Finds ~elim_lit = AND(m_1..m_k): binaries (elim_lit V m_i) in 'a' and
+//(~elim_lit V ~m_1 V .. V ~m_k) in 'b'. With k=1 it's an equivalence
+bool OccSimplifier::find_and_gate(
+    const Lit elim_lit
     , watch_subarray_const a
     , watch_subarray_const b
-    , vector<char>& a_mark
-    , vector<char>& b_mark
-) {
-    a_mark.clear();
-    a_mark.resize(a.size(), 0);
-    b_mark.clear();
-    b_mark.resize(b.size(), 0);
+    , vector<char>& a_gate
+    , vector<char>& b_gate
+    , ElimWork& w
+) const {
+    assert(w.toClear.empty());
+    w.limit -= (long)a.size() + (long)b.size();
+    for(const Watched ws: a) {
+        if (ws.isBin()
+            && !ws.red()
+        ) {
+            w.seen[(~ws.lit2()).toInt()] = 1;
+            w.toClear.push_back(~ws.lit2());
+        }
+    }
 
-    for(Lit lit: gate_lits_of_elim_cls) {
-        seen[lit.toInt()] = 1;
+    //Largest definition found
+    size_t best_at = std::numeric_limits<size_t>::max();
+    uint32_t best_size = 0;
+    if (!w.toClear.empty()) {
+        for(size_t i = 0; i < b.size(); i++) {
+            const Watched ws = b[i];
+            if (ws.isBin()) {
+                if (!ws.red()
+                    && w.seen[ws.lit2().toInt()]
+                    && best_size < 1
+                ) {
+                    best_at = i;
+                    best_size = 1;
+                }
+                continue;
+            }
+
+            assert(ws.isClause());
+            const Clause& cl = *solver->cl_alloc.ptr(ws.get_offset());
+            if (cl.getRemoved()
+                || cl.red()
+                || cl.size()-1 <= best_size
+            ) {
+                continue;
+            }
+
+            w.limit -= (long)cl.size();
+            bool all_in = true;
+            for(const Lit lit: cl) {
+                if (lit != ~elim_lit && !w.seen[lit.toInt()]) {
+                    all_in = false;
+                    break;
+                }
+            }
+            if (all_in) {
+                best_at = i;
+                best_size = cl.size()-1;
+            }
+        }
     }
 
-    size_t num_found = 0;
-    size_t at = 0;
-    for(Watched w: a) {
-        if (w.isBin()
-            && !w.red()
-            && seen[(~w.lit2()).toInt()]
+    for(const Lit l: w.toClear) {
+        w.seen[l.toInt()] = 0;
+    }
+    w.toClear.clear();
+    if (best_size == 0) {
+        return false;
+    }
+
+    //Mark the gate's clauses
+    b_gate[best_at] = 1;
+    if (b[best_at].isBin()) {
+        w.toClear.push_back(b[best_at].lit2());
+    } else {
+        const Clause& cl = *solver->cl_alloc.ptr(b[best_at].get_offset());
+        for(const Lit lit: cl) {
+            if (lit != ~elim_lit) {
+                w.toClear.push_back(lit);
+            }
+        }
+    }
+    for(const Lit l: w.toClear) {
+        w.seen[l.toInt()] = 1;
+    }
+    for(size_t i = 0; i < a.size(); i++) {
+        if (a[i].isBin()
+            && !a[i].red()
+            && w.seen[(~a[i].lit2()).toInt()]
         ) {
-            num_found++;
-            a_mark[at] = 1;
+            a_gate[i] = 1;
         }
-        at++;
     }
-    assert(num_found >= gate_lits_of_elim_cls.size()
-        && "We have to find all, but there could be multiple that are the same"
-        //NOTE: this is not a precise check but it's better than nothing
-    );
+    for(const Lit l: w.toClear) {
+        w.seen[l.toInt()] = 0;
+    }
+    w.toClear.clear();
 
-    assert(false);
-    /*
-     * TODO move to LONG after move to TRI removal
-     *
-     *
-    at = 0;
-    num_found = 0;
-    for(Watched w: b) {
-        if (gate_lits_of_elim_cls.size() == 2
-            && w.isTri()
-            && !w.red()
-            && seen[w.lit2().toInt()]
-            && seen[w.lit3().toInt()]
+    return true;
+}
+
+//Finds lit XOR l_1 XOR .. XOR l_k = rhs, i.e. all 2^k clauses of the same
+//parity over the same variables
+bool OccSimplifier::find_xor_gate(
+    const Lit lit
+    , watch_subarray_const poss
+    , watch_subarray_const negs
+    , ElimWork& w
+) const {
+    const uint32_t max_size = std::min<uint32_t>(solver->conf.maxXorToFind, 7);
+    for(const Watched ws: poss) {
+        if (!ws.isClause())
+            continue;
+
+        const Clause& cl = *solver->cl_alloc.ptr(ws.get_offset());
+        if (cl.getRemoved()
+            || cl.red()
+            || cl.size() > max_size
         ) {
-            b_mark[at] = 1;
-            num_found++;
+            continue;
+        }
+
+        //Each side must have 2^(k-1) clauses
+        const uint32_t need = 1U << (cl.size()-1);
+        if (poss.size() < need/2 || negs.size() < need/2) {
+            continue;
         }
 
-        if (gate_lits_of_elim_cls.size() >= 3
-            && w.isClause()
+        //Number the other vars, and calculate parity
+        assert(w.toClear.empty());
+        bool rhs = false;
+        for(const Lit l: cl) {
+            rhs ^= l.sign();
+            if (l.var() != lit.var()) {
+                w.toClear.push_back(Lit(l.var(), false));
+                w.seen[Lit(l.var(), false).toInt()] = w.toClear.size();
+            }
+        }
+
+        //Collect clauses with the same vars and parity
+        uint64_t found = 0;
+        for(int side = 0; side < 2; side++) {
+            watch_subarray_const ws2 = side == 0 ? poss : negs;
+            vector<char>& gate = side == 0 ? w.poss_gate : w.negs_gate;
+            w.limit -= (long)ws2.size();
+            for(size_t i = 0; i < ws2.size(); i++) {
+                if (!ws2[i].isClause())
+                    continue;
+
+                const Clause& cl2 = *solver->cl_alloc.ptr(ws2[i].get_offset());
+                if (cl2.getRemoved()
+                    || cl2.red()
+                    || cl2.size() != cl.size()
+                ) {
+                    continue;
+                }
+
+                w.limit -= (long)cl2.size();
+                bool rhs2 = false;
+                uint32_t mask = 0;
+                bool ok = true;
+                for(const Lit l: cl2) {
+                    rhs2 ^= l.sign();
+                    if (l.var() == lit.var())
+                        continue;
+
+                    const uint16_t at = w.seen[Lit(l.var(), false).toInt()];
+                    if (at == 0) {
+                        ok = false;
+                        break;
+                    }
+                    mask |= (uint32_t)l.sign() << (at-1);
+                }
+                if (ok && rhs2 == rhs) {
+                    found |= 1ULL << mask;
+                    gate[i] = 1;
+                }
+            }
+        }
+
+        for(const Lit l: w.toClear) {
+            w.seen[l.toInt()] = 0;
+        }
+        w.toClear.clear();
+
+        const uint32_t num_found = my_popcnt((uint32_t)found)
+            + my_popcnt((uint32_t)(found >> 32));
+        if (num_found == need) {
+            return true;
+        }
+        std::fill(w.poss_gate.begin(), w.poss_gate.end(), 0);
+        std::fill(w.negs_gate.begin(), w.negs_gate.end(), 0);
+        if (w.limit < 0) {
+            return false;
+        }
+    }
+
+    return false;
+}
+static bool find_tri_with(
+    const vector<std::pair<Lit, Lit> >& tris
+    , const Lit a
+    , const Lit b
+    , size_t& at
+) {
+    for(size_t i = 0; i < tris.size(); i++) {
+        if ((tris[i].first == a && tris[i].second == b)
+            || (tris[i].first == b && tris[i].second == a)
         ) {
-            const Clause* cl = solver->cl_alloc.ptr(w.get_offset());
-            if (cl->getRemoved()) {
+            at = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+//Finds lit = ITE(c, t, e), i.e. the 4 clauses
+//(~lit V ~c V t), (~lit V c V e), (lit V ~c V ~t), (lit V c V ~e)
+bool OccSimplifier::find_ite_gate(
+    const Lit lit
+    , watch_subarray_const poss
+    , watch_subarray_const negs
+    , ElimWork& w
+) const {
+    w.poss_tri.clear();
+    w.poss_tri_at.clear();
+    w.negs_tri.clear();
+    w.negs_tri_at.clear();
+    for(int side = 0; side < 2; side++) {
+        watch_subarray_const ws = side == 0 ? poss : negs;
+        vector<std::pair<Lit, Lit> >& tris = side == 0 ? w.poss_tri : w.negs_tri;
+        vector<uint32_t>& tris_at = side == 0 ? w.poss_tri_at : w.negs_tri_at;
+        w.limit -= (long)ws.size();
+        for(size_t i = 0; i < ws.size(); i++) {
+            if (!ws[i].isClause())
+                continue;
+
+            const Clause& cl = *solver->cl_alloc.ptr(ws[i].get_offset());
+            if (cl.getRemoved() || cl.red() || cl.size() != 3)
                 continue;
+
+            Lit other[2];
+            uint32_t num = 0;
+            for(const Lit l: cl) {
+                if (l.var() != lit.var()) {
+                    other[num++] = l;
+                }
             }
+            tris.push_back(std::make_pair(other[0], other[1]));
+            tris_at.push_back(i);
+        }
+    }
+    if (w.poss_tri.size() < 2 || w.negs_tri.size() < 2) {
+        return false;
+    }
 
-            if (!cl->red() && cl->size()-1 == gate_lits_of_elim_cls.size()) {
-                bool found_it = true;
-                for(const Lit lit: *cl) {
-                    if (lit != ~elim_lit) {
-                        if (!seen[lit.toInt()]) {
-                            found_it = false;
-                            break;
-                        }
-                    }
+    for(size_t at_ct = 0; at_ct < w.negs_tri.size(); at_ct++) {
+        const std::pair<Lit, Lit>& tri = w.negs_tri[at_ct];
+        w.limit -= (long)(w.negs_tri.size() + w.poss_tri.size())*2;
+        if (w.limit < 0) {
+            return false;
+        }
+
+        //(~lit V ~c V t), with ~c being either of the two
+        for(int flip = 0; flip < 2; flip++) {
+            const Lit c = flip ? ~tri.second : ~tri.first;
+            const Lit t = flip ? tri.first : tri.second;
+
+            //(~lit V c V e)
+            for(size_t j = 0; j < w.negs_tri.size(); j++) {
+                Lit e;
+                if (w.negs_tri[j].first == c) {
+                    e = w.negs_tri[j].second;
+                } else if (w.negs_tri[j].second == c) {
+                    e = w.negs_tri[j].first;
+                } else {
+                    continue;
                 }
-                if (found_it) {
-                    b_mark[at] = 1;
-                    num_found++;
+
+                size_t at_t;
+                size_t at_e;
+                if (find_tri_with(w.poss_tri, ~c, ~t, at_t)
+                    && find_tri_with(w.poss_tri, c, ~e, at_e)
+                ) {
+                    w.negs_gate[w.negs_tri_at[at_ct]] = 1;
+                    w.negs_gate[w.negs_tri_at[j]] = 1;
+                    w.poss_gate[w.poss_tri_at[at_t]] = 1;
+                    w.poss_gate[w.poss_tri_at[at_e]] = 1;
+                    return true;
                 }
             }
         }
-        at++;
-    }*/
-    assert(num_found >= 1
-        && "We have to find the matching gate clause. But there could be multiple matching"
-    );
+    }
 
-    for(Lit lit: gate_lits_of_elim_cls) {
-        seen[lit.toInt()] = 0;
+    return false;
+}
+
+//Marks in w.poss_gate/w.negs_gate the clauses defining the var of lit
+void OccSimplifier::find_elim_gate(
+    const Lit lit
+    , watch_subarray_const poss
+    , watch_subarray_const negs
+    , ElimWork& w
+) const {
+    w.gate = ElimGate::none;
+    w.poss_gate.clear();
+    w.poss_gate.resize(poss.size(), 0);
+    w.negs_gate.clear();
+    w.negs_gate.resize(negs.size(), 0);
+
+    if (find_and_gate(lit, poss, negs, w.poss_gate, w.negs_gate, w)
+        || find_and_gate(~lit, negs, poss, w.negs_gate, w.poss_gate, w)
+    ) {
+        w.gate = ElimGate::and_gate;
+    } else if (find_xor_gate(lit, poss, negs, w)) {
+        w.gate = ElimGate::xor_gate;
+    } else if (find_ite_gate(lit, poss, negs, w)) {
+        w.gate = ElimGate::ite_gate;
     }
 }
 
 bool OccSimplifier::skip_resolution_thanks_to_gate(
     const size_t at_poss
     , const size_t at_negs
+    , const ElimWork& w
 ) const {
-    if (!gate_found_elim)
+    if (w.gate == ElimGate::none)
         return false;
 
-    return poss_gate_parts[at_poss] == negs_gate_parts[at_negs];
+    return w.poss_gate[at_poss] == w.negs_gate[at_negs];
+}
+
+void OccSimplifier::count_elim_gate(const ElimGate gate)
+{
+    switch(gate) {
+        case ElimGate::and_gate:
+            bvestats.elimedWithAndGate++;
+            break;
+        case ElimGate::xor_gate:
+            bvestats.elimedWithXorGate++;
+            break;
+        case ElimGate::ite_gate:
+            bvestats.elimedWithIteGate++;
+            break;
+        case ElimGate::none:
+            break;
+    }
 }
 
 int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
 {
+    elim_work.limit = *limit_to_decrease;
+    elim_work.aggressive_limit = aggressive_elim_time_limit;
+    const int ret = test_elim_and_fill_resolvents(var, elim_work, resolvents, resolvent_lits);
+    *limit_to_decrease = elim_work.limit;
+    aggressive_elim_time_limit = elim_work.aggressive_limit;
+    bvestats.usedAggressiveCheckToELim += elim_work.used_aggressive;
+
+    return ret;
+}
+
+/**
+@brief Computes the resolvents of var into 'out' if it's worth eliminating
+
+Only reads the clauses and sorts the occurrence lists of var, so it can run
+in parallel for variables that share no clause
+*/
+int OccSimplifier::test_elim_and_fill_resolvents(
+    const uint32_t var
+    , ElimWork& w
+    , vector<Resolvent>& out
+    , vector<Lit>& out_lits
+) const {
     assert(solver->ok);
-    assert(solver->varData[var].removed == Removed::none);
+    assert(solver->varFlags.removed(var) == Removed::none);
     assert(solver->value(var) == l_Undef);
+    w.used_aggressive = false;
 
     //Gather data
-    HeuristicData pos = calc_data_for_heuristic(Lit(var, false));
-    HeuristicData neg = calc_data_for_heuristic(Lit(var, true));
+    HeuristicData pos = calc_data_for_heuristic(Lit(var, false), w.limit);
+    HeuristicData neg = calc_data_for_heuristic(Lit(var, true), w.limit);
 
     //Heuristic calculation took too much time
-    if (*limit_to_decrease < 0) {
+    if (w.limit < 0) {
         return std::numeric_limits<int>::max();
     }
 
     //Check if we should do aggressive check or not
-    const bool aggressive = (aggressive_elim_time_limit > 0 && !startup);
-    bvestats.usedAggressiveCheckToELim += aggressive;
+    const bool aggressive = (w.aggressive_limit > 0 && !startup);
+    w.used_aggressive = aggressive;
 
     //set-up
     const Lit lit = Lit(var, false);
@@ -1688,7 +2738,8 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     watch_subarray negs = solver->watches[~lit];
     std::sort(poss.begin(), poss.end(), watch_sort_smallest_first());
     std::sort(negs.begin(), negs.end(), watch_sort_smallest_first());
-    resolvents.clear();
+    out.clear();
+    out_lits.clear();
 
     //Pure literal, no resolvents
     //we look at "pos" and "neg" (and not poss&negs) because we don't care about redundant clauses
@@ -1703,9 +2754,11 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         return std::numeric_limits<int>::max();
     }
 
-    gate_found_elim = false;
-    if (solver->conf.skip_some_bve_resolvents) {
-        //mark_gate_in_poss_negs(lit, poss, negs);
+    w.gate = ElimGate::none;
+    if (solver->conf.skip_some_bve_resolvents
+        && solver->conf.otfHyperbin
+    ) {
+        find_elim_gate(lit, poss, negs, w);
     }
 
     // Count clauses/literals after elimination
@@ -1720,7 +2773,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         ; it != end
         ; ++it, at_poss++
     ) {
-        *limit_to_decrease -= 3;
+        w.limit -= 3;
         if (solver->redundant_or_removed(*it))
             continue;
 
@@ -1729,7 +2782,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             ; it2 != end2
             ; it2++, at_negs++
         ) {
-            *limit_to_decrease -= 3;
+            w.limit -= 3;
             if (solver->redundant_or_removed(*it2))
                 continue;
 
@@ -1738,35 +2791,35 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
                 //Below: Always resolve binaries so that cache&stamps stay OK
                 && !(it->isBin() && it2->isBin())
                 //Real check
-                && skip_resolution_thanks_to_gate(at_poss, at_negs)
+                && skip_resolution_thanks_to_gate(at_poss, at_negs, w)
             ) {
                 continue;
             }
 
             //Resolve the two clauses
-            bool tautological = resolve_clauses(*it, *it2, lit, aggressive);
+            bool tautological = resolve_clauses(*it, *it2, lit, aggressive, w);
             if (tautological)
                 continue;
 
             #ifdef VERBOSE_DEBUG_VARELIM
-            cout << "Adding new clause due to varelim: " << dummy << endl;
+            cout << "Adding new clause due to varelim: " << w.dummy << endl;
             #endif
 
             //Update after-stats
             after_clauses++;
-            after_literals += dummy.size();
-            if (dummy.size() >= 3)
+            after_literals += w.dummy.size();
+            if (w.dummy.size() >= 3)
                 after_long++;
-            if (dummy.size() == 2)
+            if (w.dummy.size() == 2)
                 after_bin++;
 
             //Early-abort or over time
             if (after_clauses > before_clauses
                 //Too long resolvent
                 || (solver->conf.velim_resolvent_too_large != -1
-                    && ((int)dummy.size() > solver->conf.velim_resolvent_too_large))
+                    && ((int)w.dummy.size() > solver->conf.velim_resolvent_too_large))
                 //Over-time
-                || *limit_to_decrease < -10LL*1000LL
+                || w.limit < -10LL*1000LL
 
             ) {
                 return std::numeric_limits<int>::max();
@@ -1784,7 +2837,8 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
                     , solver->cl_alloc.ptr(it2->get_offset())->stats
             );
 
-            resolvents.push_back(Resolvent(dummy, stats));
+            out.push_back(Resolvent(out_lits.size(), w.dummy.size(), stats));
+            out_lits.insert(out_lits.end(), w.dummy.begin(), w.dummy.end());
         }
     }
 
@@ -1947,8 +3001,8 @@ void OccSimplifier::set_var_as_eliminated(const uint32_t var, const Lit lit)
         <<  solver->map_inter_to_outer(lit)
         << " finished " << endl;
     }
-    assert(solver->varData[var].removed == Removed::none);
-    solver->varData[var].removed = Removed::elimed;
+    assert(solver->varFlags.removed(var) == Removed::none);
+    solver->varFlags.set_removed(var, Removed::elimed);
 
     bvestats_global.numVarsElimed++;
 }
@@ -1956,7 +3010,7 @@ void OccSimplifier::set_var_as_eliminated(const uint32_t var, const Lit lit)
 void OccSimplifier::create_dummy_blocked_clause(const Lit lit)
 {
     blockedClauses.push_back(
-        BlockedClause(solver->map_inter_to_outer(lit))
+        BlockedClause(solver->map_inter_to_outer(lit), blkcls.size())
     );
 }
 
@@ -1973,7 +3027,17 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
         return false;  //didn't eliminate :(
     }
     bvestats.triedToElimVars++;
+    count_elim_gate(elim_work.gate);
+    eliminate_var_with_resolvents(var, resolvents, resolvent_lits);
+
+    return true; //elininated!
+}
 
+void OccSimplifier::eliminate_var_with_resolvents(
+    const uint32_t var
+    , vector<Resolvent>& res
+    , const vector<Lit>& res_lits
+) {
     const Lit lit = Lit(var, false);
     print_var_eliminate_stat(lit);
 
@@ -1985,11 +3049,15 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
 
     //It's best to add resolvents with largest first. Then later, the smaller ones
     //can subsume the larger ones. While adding, we do subsumption check.
-    std::sort(resolvents.begin(), resolvents.end());
+    std::sort(res.begin(), res.end());
 
     //Add resolvents
-    for(Resolvent& resolvent: resolvents) {
-        if (!add_varelim_resolvent(resolvent.lits, resolvent.stats)) {
+    for(const Resolvent& resolvent: res) {
+        tmp_resolvent.assign(
+            res_lits.begin() + resolvent.at
+            , res_lits.begin() + resolvent.at + resolvent.size
+        );
+        if (!add_varelim_resolvent(tmp_resolvent, resolvent.stats)) {
             goto end;
         }
     }
@@ -2001,29 +3069,28 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
 
 end:
     set_var_as_eliminated(var, lit);
-
-    return true; //elininated!
 }
 
 void OccSimplifier::add_pos_lits_to_dummy_and_seen(
     const Watched ps
     , const Lit posLit
-) {
+    , ElimWork& w
+) const {
     if (ps.isBin()) {
-        *limit_to_decrease -= 1;
+        w.limit -= 1;
         assert(ps.lit2() != posLit);
 
-        seen[ps.lit2().toInt()] = 1;
-        dummy.push_back(ps.lit2());
+        w.seen[ps.lit2().toInt()] = 1;
+        w.dummy.push_back(ps.lit2());
     }
 
     if (ps.isClause()) {
-        Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        const Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
+        w.limit -= (long)cl.size()/2;
         for (const Lit lit : cl){
             if (lit != posLit) {
-                seen[lit.toInt()] = 1;
-                dummy.push_back(lit);
+                w.seen[lit.toInt()] = 1;
+                w.dummy.push_back(lit);
             }
         }
     }
@@ -2032,34 +3099,35 @@ void OccSimplifier::add_pos_lits_to_dummy_and_seen(
 bool OccSimplifier::add_neg_lits_to_dummy_and_seen(
     const Watched qs
     , const Lit posLit
-) {
+    , ElimWork& w
+) const {
     if (qs.isBin()) {
-        *limit_to_decrease -= 1;
+        w.limit -= 1;
         assert(qs.lit2() != ~posLit);
 
-        if (seen[(~qs.lit2()).toInt()]) {
+        if (w.seen[(~qs.lit2()).toInt()]) {
             return true;
         }
-        if (!seen[qs.lit2().toInt()]) {
-            dummy.push_back(qs.lit2());
-            seen[qs.lit2().toInt()] = 1;
+        if (!w.seen[qs.lit2().toInt()]) {
+            w.dummy.push_back(qs.lit2());
+            w.seen[qs.lit2().toInt()] = 1;
         }
     }
 
     if (qs.isClause()) {
-        Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        const Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
+        w.limit -= (long)cl.size()/2;
         for (const Lit lit: cl) {
             if (lit == ~posLit)
                 continue;
 
-            if (seen[(~lit).toInt()]) {
+            if (w.seen[(~lit).toInt()]) {
                 return true;
             }
 
-            if (!seen[lit.toInt()]) {
-                dummy.push_back(lit);
-                seen[lit.toInt()] = 1;
+            if (!w.seen[lit.toInt()]) {
+                w.dummy.push_back(lit);
+                w.seen[lit.toInt()] = 1;
             }
         }
     }
@@ -2071,7 +3139,8 @@ bool OccSimplifier::reverse_distillation_of_dummy(
     const Watched ps
     , const Watched qs
     , const Lit posLit
-) {
+    , ElimWork& w
+) const {
     /*
     //TODO
     //Use watchlists
@@ -2090,16 +3159,16 @@ bool OccSimplifier::reverse_distillation_of_dummy(
     }
 
     for (size_t i = 0
-        ; i < toClear.size() && aggressive_elim_time_limit > 0
+        ; i < w.toClear.size() && w.aggressive_limit > 0
         ; i++
     ) {
-        aggressive_elim_time_limit -= 3;
-        const Lit lit = toClear[i];
+        w.aggressive_limit -= 3;
+        const Lit lit = w.toClear[i];
         assert(lit.var() != posLit.var());
 
         //Use cache
-        const vector<LitExtra>& cache = solver->implCache[lit].lits;
-        aggressive_elim_time_limit -= (int64_t)cache.size()/3;
+        const CacheLits cache = solver->implCache[lit];
+        w.aggressive_limit -= (int64_t)cache.size()/3;
         for(const LitExtra litextra: cache) {
             //If redundant, that doesn't help
             if (!litextra.getOnlyIrredBin())
@@ -2111,13 +3180,13 @@ bool OccSimplifier::reverse_distillation_of_dummy(
 
             //If (a) was in original clause
             //then (a V b) means -b can be put inside
-            if (!seen[(~otherLit).toInt()]) {
-                toClear.push_back(~otherLit);
-                seen[(~otherLit).toInt()] = 1;
+            if (!w.seen[(~otherLit).toInt()]) {
+                w.toClear.push_back(~otherLit);
+                w.seen[(~otherLit).toInt()] = 1;
             }
 
             //If (a V b) is irred in the clause, then done
-            if (seen[otherLit.toInt()]) {
+            if (w.seen[otherLit.toInt()]) {
                 return true;
             }
         }
@@ -2129,15 +3198,16 @@ bool OccSimplifier::reverse_distillation_of_dummy(
 bool OccSimplifier::subsume_dummy_through_stamping(
     const Watched ps
     , const Watched qs
-) {
+    , ElimWork& w
+) const {
     //only if none of the clauses were binary
     //Otherwise we cannot tell if the value in the cache is dependent
     //on the binary clause itself, so that would cause a circular de-
     //pendency
 
     if (!ps.isBin() && !qs.isBin()) {
-        aggressive_elim_time_limit -= (int64_t)toClear.size()*5;
-        if (solver->stamp.stampBasedClRem(toClear)) {
+        w.aggressive_limit -= (int64_t)w.toClear.size()*5;
+        if (solver->stamp.stampBasedClRem(w.toClear, w.stamp_norm, w.stamp_inv)) {
             return true;
         }
     }
@@ -2150,7 +3220,8 @@ bool OccSimplifier::resolve_clauses(
     , const Watched qs
     , const Lit posLit
     , const bool aggressive
-) {
+    , ElimWork& w
+) const {
     //If clause has already been freed, skip
     if (ps.isClause()
         && solver->cl_alloc.ptr(ps.get_offset())->freed()
@@ -2163,28 +3234,28 @@ bool OccSimplifier::resolve_clauses(
         return false;
     }
 
-    dummy.clear();
-    assert(toClear.empty());
-    add_pos_lits_to_dummy_and_seen(ps, posLit);
-    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit);
-    toClear = dummy;
+    w.dummy.clear();
+    assert(w.toClear.empty());
+    add_pos_lits_to_dummy_and_seen(ps, posLit, w);
+    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit, w);
+    w.toClear = w.dummy;
 
     if (!tautological && aggressive) {
-        tautological = reverse_distillation_of_dummy(ps, qs, posLit);
+        tautological = reverse_distillation_of_dummy(ps, qs, posLit, w);
     }
 
     if (!tautological && aggressive
         && solver->conf.doStamp
         && solver->conf.otfHyperbin
     ) {
-        tautological = subsume_dummy_through_stamping(ps, qs);
+        tautological = subsume_dummy_through_stamping(ps, qs, w);
     }
 
-    *limit_to_decrease -= (long)toClear.size()/2 + 1;
-    for (const Lit lit: toClear) {
-        seen[lit.toInt()] = 0;
+    w.limit -= (long)w.toClear.size()/2 + 1;
+    for (const Lit lit: w.toClear) {
+        w.seen[lit.toInt()] = 0;
     }
-    toClear.clear();
+    w.toClear.clear();
 
     return tautological;
 }
@@ -2228,12 +3299,14 @@ bool OccSimplifier::aggressiveCheck(
     return false;
 }
 
-OccSimplifier::HeuristicData OccSimplifier::calc_data_for_heuristic(const Lit lit)
-{
+OccSimplifier::HeuristicData OccSimplifier::calc_data_for_heuristic(
+    const Lit lit
+    , int64_t& limit
+) const {
     HeuristicData ret;
 
     watch_subarray_const ws_list = solver->watches[lit];
-    *limit_to_decrease -= (long)ws_list.size()*3 + 100;
+    limit -= (long)ws_list.size()*3 + 100;
     for (const Watched ws: ws_list) {
         //Skip redundant clauses
         if (solver->redundant(ws))
@@ -2421,8 +3494,8 @@ int OccSimplifier::check_empty_resolvent_action(
 pair<int, int> OccSimplifier::heuristicCalcVarElimScore(const uint32_t var)
 {
     const Lit lit(var, false);
-    const HeuristicData pos = calc_data_for_heuristic(lit);
-    const HeuristicData neg = calc_data_for_heuristic(~lit);
+    const HeuristicData pos = calc_data_for_heuristic(lit, *limit_to_decrease);
+    const HeuristicData neg = calc_data_for_heuristic(~lit, *limit_to_decrease);
 
     //Estimate cost
     int posTotalLonger = pos.longer;
@@ -2484,8 +3557,11 @@ void OccSimplifier::order_vars_for_elim()
         ; var < solver->nVars() && *limit_to_decrease > 0
         ; var++
     ) {
-        if (!can_eliminate_var(var))
+        if (!can_eliminate_var(var)
+            || !var_dirty(var)
+        ) {
             continue;
+        }
 
         *limit_to_decrease -= 50;
         assert(!velim_order.inHeap(var));
@@ -2526,7 +3602,7 @@ std::pair<int, int> OccSimplifier::strategyCalcVarElimScore(const uint32_t var)
 void OccSimplifier::check_elimed_vars_are_unassigned() const
 {
     for (size_t i = 0; i < solver->nVarsOuter(); i++) {
-        if (solver->varData[i].removed == Removed::elimed) {
+        if (solver->varFlags.removed(i) == Removed::elimed) {
             assert(solver->value(i) == l_Undef);
         }
     }
@@ -2537,7 +3613,7 @@ void OccSimplifier::check_elimed_vars_are_unassignedAndStats() const
     assert(solver->ok);
     int64_t checkNumElimed = 0;
     for (size_t i = 0; i < solver->nVarsOuter(); i++) {
-        if (solver->varData[i].removed == Removed::elimed) {
+        if (solver->varFlags.removed(i) == Removed::elimed) {
             checkNumElimed++;
             assert(solver->value(i) == l_Undef);
         }
@@ -2556,10 +3632,16 @@ void OccSimplifier::check_elimed_vars_are_unassignedAndStats() const
 size_t OccSimplifier::mem_used() const
 {
     size_t b = 0;
-    b += poss_gate_parts.capacity()*sizeof(char);
-    b += negs_gate_parts.capacity()*sizeof(char);
-    b += gate_lits_of_elim_cls.capacity()*sizeof(Lit);
-    b += dummy.capacity()*sizeof(char);
+    b += elim_work.mem_used();
+    for(const ElimWork& w: elim_thread_work) {
+        b += w.mem_used();
+    }
+    for(const ElimCand& c: elim_batch) {
+        b += c.resolvents.capacity()*sizeof(Resolvent);
+        b += c.resolvent_lits.capacity()*sizeof(Lit);
+    }
+    b += elim_batch.capacity()*sizeof(ElimCand);
+    b += elim_batch_mark.capacity()*sizeof(uint8_t);
     b += sub_str_with.capacity()*sizeof(ClOffset);
     b += sub_str->mem_used();
     for(map<uint32_t, vector<size_t> >::const_iterator
@@ -2570,13 +3652,14 @@ size_t OccSimplifier::mem_used() const
         b += it->second.capacity()*sizeof(size_t);
     }
     b += blockedClauses.capacity()*sizeof(BlockedClause);
-    for(vector<BlockedClause>::const_iterator
-        it = blockedClauses.begin(), end = blockedClauses.end()
-        ; it != end
-        ; ++it
-    ) {
-        b += it->lits.capacity()*sizeof(Lit);
-    }
+    b += blkcls.capacity()*sizeof(Lit);
+    b += tmp_blk_lits.capacity()*sizeof(Lit);
+    b += bce_cov.capacity()*sizeof(Lit);
+    b += bce_steps.capacity()*sizeof(std::pair<size_t, Lit>);
+    b += bce_tmp.capacity()*sizeof(Lit);
+    b += resolvents.capacity()*sizeof(Resolvent);
+    b += resolvent_lits.capacity()*sizeof(Lit);
+    b += tmp_resolvent.capacity()*sizeof(Lit);
     b += blk_var_to_cl.size()*(sizeof(uint32_t)+sizeof(vector<size_t>)); //TODO under-counting
     b += velim_order.mem_used();
     b += varElimComplexity.capacity()*sizeof(int)*2;
@@ -2652,6 +3735,8 @@ OccSimplifier::Stats& OccSimplifier::Stats::operator+=(const Stats& other)
     //Time
     linkInTime += other.linkInTime;
     blockTime += other.blockTime;
+    blocked += other.blocked;
+    covered += other.covered;
     varElimTime += other.varElimTime;
     finalCleanupTime += other.finalCleanupTime;
     zeroDepthAssings += other.zeroDepthAssings;
@@ -2675,6 +3760,9 @@ BVEStats& BVEStats::operator+=(const BVEStats& other)
     usedAggressiveCheckToELim += other.usedAggressiveCheckToELim;
     newClauses += other.newClauses;
     subsumedByVE  += other.subsumedByVE;
+    elimedWithAndGate += other.elimedWithAndGate;
+    elimedWithXorGate += other.elimedWithXorGate;
+    elimedWithIteGate += other.elimedWithIteGate;
 
     return *this;
 }
@@ -2710,6 +3798,16 @@ void OccSimplifier::Stats::print(const size_t nVars) const
 
 
 
+    print_stats_line("c blocked cls"
+        , blocked
+        , float_div(blockTime, numCalls)
+        , "s BCE/CCE per call"
+    );
+
+    print_stats_line("c covered cls"
+        , covered
+    );
+
     print_stats_line("c 0-depth assigns"
         , zeroDepthAssings
         , stats_line_percent(zeroDepthAssings, nVars)
@@ -2725,10 +3823,9 @@ void OccSimplifier::save_state(SimpleOutFile& f)
     cleanBlockedClauses();
     f.put_uint64_t(blockedClauses.size());
     for(const BlockedClause& c: blockedClauses) {
-        c.save_to_file(f);
+        c.save_to_file(f, blkcls);
     }
     f.put_struct(globalStats);
-    f.put_uint32_t(anythingHasBeenBlocked);
 
 
 }
@@ -2737,18 +3834,20 @@ void OccSimplifier::load_state(SimpleInFile& f)
     const uint64_t sz = f.get_uint64_t();
     for(uint64_t i = 0; i < sz; i++) {
         BlockedClause b;
-        b.load_from_file(f);
+        b.load_from_file(f, blkcls);
         blockedClauses.push_back(b);
+        if (b.bce && !b.toRemove) {
+            num_bce_cls_on_stack++;
+        }
     }
     f.get_struct(globalStats);
-    anythingHasBeenBlocked = f.get_uint32_t();
 
     blockedMapBuilt = false;
     buildBlockedMap();
 
     //Sanity check
     for(size_t i = 0; i < solver->nVars(); i++) {
-        if (solver->varData[i].removed == Removed::elimed) {
+        if (solver->varFlags.removed(i) == Removed::elimed) {
             assert(solver->value(i) == l_Undef);
         }
     }
@@ -57,47 +57,76 @@ class TopLevelGaussAbst;
 class SubsumeStrengthen;
 class BVA;
 
+/**
+@brief A blocked or eliminated clause
+
+The literals are not stored here but in one common array (blkcls in
+OccSimplifier), at positions [start, end). Clauses removed by blocked or
+covered clause elimination have 'bce' set: their blockedOn variable is
+not eliminated, so it is flipped, not set, during solution extension
+*/
 struct BlockedClause {
     BlockedClause()
     {}
 
-    BlockedClause(Lit dummyLit) :
+    BlockedClause(Lit dummyLit, const uint64_t at) :
         blockedOn(dummyLit)
         , toRemove(false)
         , dummy(true)
+        , start(at)
+        , end(at)
     {}
 
     BlockedClause(
         const Lit _blockedOn
-        , const vector<Lit>& _lits
+        , const uint64_t _start
+        , const uint64_t _end
     ) :
         blockedOn(_blockedOn)
         , toRemove(false)
-        , lits(_lits)
         , dummy(false)
+        , start(_start)
+        , end(_end)
+    {
+    }
+
+    size_t size() const
     {
+        return end-start;
     }
 
-    void save_to_file(SimpleOutFile& f) const
+    void save_to_file(SimpleOutFile& f, const vector<Lit>& blkcls) const
     {
         f.put_lit(blockedOn);
         f.put_uint32_t(toRemove);
-        f.put_vector(lits);
+        f.put_uint64_t(size());
+        for(uint64_t i = start; i < end; i++) {
+            f.put_lit(blkcls[i]);
+        }
         f.put_uint32_t(dummy);
+        f.put_uint32_t(bce);
     }
 
-    void load_from_file(SimpleInFile& f)
+    void load_from_file(SimpleInFile& f, vector<Lit>& blkcls)
     {
         blockedOn = f.get_lit();
         toRemove = f.get_uint32_t();
-        f.get_vector(lits);
+        const uint64_t sz = f.get_uint64_t();
+        start = blkcls.size();
+        for(uint64_t i = 0; i < sz; i++) {
+            blkcls.push_back(f.get_lit());
+        }
+        end = blkcls.size();
         dummy = f.get_uint32_t();
+        bce = f.get_uint32_t();
     }
 
     Lit blockedOn = lit_Undef;
     bool toRemove = false;
-    vector<Lit> lits;
     bool dummy = false;
+    bool bce = false;
+    uint64_t start = 0;
+    uint64_t end = 0;
 };
 
 struct BVEStats
@@ -119,6 +148,9 @@ struct BVEStats
     uint64_t usedAggressiveCheckToELim = 0;
     uint64_t newClauses = 0;
     uint64_t subsumedByVE = 0;
+    uint64_t elimedWithAndGate = 0;
+    uint64_t elimedWithXorGate = 0;
+    uint64_t elimedWithIteGate = 0;
 
     BVEStats& operator+=(const BVEStats& other);
 
@@ -146,6 +178,13 @@ struct BVEStats
         << " red-bin rem: " << binRedClRemThroughElim
         << " red-long rem: " << longRedClRemThroughElim
         << endl;
+
+        cout
+        << "c [occ-bve]"
+        << " gate-elim and: " << elimedWithAndGate
+        << " xor: " << elimedWithXorGate
+        << " ite: " << elimedWithIteGate
+        << endl;
     }
 
     void print()
@@ -201,6 +240,18 @@ struct BVEStats
         print_stats_line("c v-elim-sub"
             , subsumedByVE
         );
+
+        print_stats_line("c v-elim with AND gate"
+            , elimedWithAndGate
+        );
+
+        print_stats_line("c v-elim with XOR gate"
+            , elimedWithXorGate
+        );
+
+        print_stats_line("c v-elim with ITE gate"
+            , elimedWithIteGate
+        );
     }
     void clear() {
         BVEStats tmp;
@@ -226,6 +277,7 @@ public:
     void new_vars(const size_t n);
     void save_on_var_memory();
     bool uneliminate(const uint32_t var);
+    bool readd_blocked_clauses_on(const vector<Lit>& lits);
     size_t mem_used() const;
     size_t mem_used_xor() const;
     size_t mem_used_bva() const;
@@ -240,6 +292,10 @@ public:
         return bvestats_global.numVarsElimed;
     }
 
+    //Has the variable's irredundant occurrence changed since the last
+    //complete round of subsumption and BVE?
+    bool var_dirty(const uint32_t var) const;
+
     struct Stats
     {
         void print(const size_t nVars) const;
@@ -253,6 +309,8 @@ public:
         //Time stats
         double linkInTime = 0;
         double blockTime = 0;
+        uint64_t blocked = 0;
+        uint64_t covered = 0;
         double varElimTime = 0;
         double finalCleanupTime = 0;
 
@@ -266,7 +324,6 @@ public:
     const Stats& get_stats() const;
     const SubsumeStrengthen* getSubsumeStrengthen() const;
     void check_elimed_vars_are_unassigned() const;
-    bool getAnythingHasBeenBlocked() const;
     void freeXorMem();
     void save_state(SimpleOutFile& f);
     void load_state(SimpleInFile& f);
@@ -304,9 +361,6 @@ private:
     vector<uint8_t>& seen2;
     vector<Lit>& toClear;
 
-    //Temporaries
-    vector<Lit>     dummy;       ///<Used by merge()
-    vector<Lit>     gate_lits_of_elim_cls;
 
     //Limits
     uint64_t clause_lits_added;
@@ -316,6 +370,7 @@ private:
     int64_t  empty_varelim_time_limit;
     int64_t  varelim_num_limit;
     int64_t  aggressive_elim_time_limit;
+    int64_t  bce_time_limit;
     int64_t* limit_to_decrease;
 
     //Start-up
@@ -333,6 +388,7 @@ private:
         uint64_t cl_not_linked = 0;
     };
     uint64_t calc_mem_usage_of_occur(const vector<ClOffset>& toAdd) const;
+    void     reserve_occur_space(const bool link_in_red);
     void     print_mem_usage_of_occur(uint64_t memUsage) const;
     void     print_linkin_data(const LinkInData link_in_data) const;
     bool     decide_occur_limit(bool irred, uint64_t memUsage);
@@ -397,47 +453,149 @@ private:
     Heap<VarOrderLt> velim_order;
     size_t      rem_cls_from_watch_due_to_varelim(watch_subarray todo, const Lit lit);
     vector<Lit> tmp_rem_lits;
-    vec<Watched> tmp_rem_cls_copy;
-    void        add_clause_to_blck(const Lit lit, const vector<Lit>& lits);
+    watch_list tmp_rem_cls_copy;
+    void        add_clause_to_blck(const Lit lit, const vector<Lit>& lits, const bool bce = false);
     void        set_var_as_eliminated(const uint32_t var, const Lit lit);
     bool        can_eliminate_var(const uint32_t var) const;
 
 
     TouchList   touched;
     vector<ClOffset> cl_to_free_later;
+
+    //Dirty-tracking across rounds. All indexed by OUTER variable
+    vector<uint64_t> occ_sig; ///<Fingerprint of irred occurrences at the end of the last complete round
+    vector<uint64_t> sub_sig; ///<Fingerprint right after the last complete sub/str pass of this round
+    vector<uint64_t> red_sig; ///<Sorted hashes of the red clauses sub/str dealt with in the last complete round
+    vector<uint64_t> sub_red_sig; ///<Sorted hashes of the red clauses right after the last complete sub/str pass of this round
+    vector<char> dirty;
+    bool        sub_complete = false;
+    bool        bve_complete = false;
+    void        calc_occ_sigs(vector<uint64_t>& sigs) const;
+    size_t      calc_red_sigs(vector<uint64_t>& sigs, const bool mark_new);
+    void        mark_dirty_vars();
+    void        save_sub_sigs();
+    void        save_occ_sigs();
     bool        maybe_eliminate(const uint32_t x);
     void        create_dummy_blocked_clause(const Lit lit);
     int         test_elim_and_fill_resolvents(uint32_t var);
-    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs);
-    void        mark_gate_parts(
-        Lit elim_lit
-        , watch_subarray_const a
-        , watch_subarray_const b
-        , vector<char>& a_mark
-        , vector<char>& b_mark
-    );
-    bool        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b);
-    bool        skip_resolution_thanks_to_gate(const size_t at_poss, const size_t at_negs) const;
     void        print_var_eliminate_stat(Lit lit) const;
     bool        add_varelim_resolvent(vector<Lit>& finalLits, const ClauseStats& stats);
     void        update_varelim_complexity_heap(const uint32_t var);
     void        print_var_elim_complexity_stats(const uint32_t var) const;
+    ///Literals are at [at, at+size) in resolvent_lits
     struct Resolvent {
-        Resolvent(const vector<Lit>& _lits, const ClauseStats _stats) :
-            lits(_lits)
+        Resolvent(const uint32_t _at, const uint32_t _size, const ClauseStats _stats) :
+            at(_at)
+            , size(_size)
             , stats(_stats)
         {}
-        vector<Lit> lits;
+        uint32_t at;
+        uint32_t size;
         ClauseStats stats;
         bool operator<(const Resolvent& other) const
         {
-            return lits.size() > other.lits.size();
+            return size > other.size;
         }
     };
     vector<Resolvent> resolvents;
-    vector<char> poss_gate_parts;
-    vector<char> negs_gate_parts;
-    bool gate_found_elim;
+    vector<Lit> resolvent_lits; ///<Cleared for every variable, but its memory is kept
+    vector<Lit> tmp_resolvent;
+
+    //Gate definitions of the var to eliminate. If the var is defined by a
+    //gate, only gate x non-gate resolvents are needed
+    enum class ElimGate {none, and_gate, xor_gate, ite_gate};
+
+    //Scratch space and budget for computing the resolvents of a variable.
+    //The serial code uses elim_work, parallel BVE gives each thread its own
+    struct ElimWork
+    {
+        vector<uint16_t> seen;
+        vector<Lit> dummy;
+        vector<Lit> toClear;
+        vector<Lit> stamp_norm;
+        vector<Lit> stamp_inv;
+        int64_t limit = 0;
+        int64_t aggressive_limit = 0;
+        bool used_aggressive = false;
+
+        ElimGate gate = ElimGate::none;
+        vector<char> poss_gate; ///<poss[i] is part of the gate
+        vector<char> negs_gate; ///<negs[i] is part of the gate
+        vector<std::pair<Lit, Lit> > poss_tri; ///<Used by ITE gate finding
+        vector<std::pair<Lit, Lit> > negs_tri;
+        vector<uint32_t> poss_tri_at;
+        vector<uint32_t> negs_tri_at;
+
+        size_t mem_used() const;
+    };
+    ElimWork elim_work;
+    void find_elim_gate(
+        const Lit lit
+        , watch_subarray_const poss
+        , watch_subarray_const negs
+        , ElimWork& w
+    ) const;
+    bool find_and_gate(
+        const Lit elim_lit
+        , watch_subarray_const a
+        , watch_subarray_const b
+        , vector<char>& a_gate
+        , vector<char>& b_gate
+        , ElimWork& w
+    ) const;
+    bool find_xor_gate(
+        const Lit lit
+        , watch_subarray_const poss
+        , watch_subarray_const negs
+        , ElimWork& w
+    ) const;
+    bool find_ite_gate(
+        const Lit lit
+        , watch_subarray_const poss
+        , watch_subarray_const negs
+        , ElimWork& w
+    ) const;
+    bool skip_resolution_thanks_to_gate(
+        const size_t at_poss
+        , const size_t at_negs
+        , const ElimWork& w
+    ) const;
+    void count_elim_gate(const ElimGate gate);
+    int test_elim_and_fill_resolvents(
+        const uint32_t var
+        , ElimWork& w
+        , vector<Resolvent>& out
+        , vector<Lit>& out_lits
+    ) const;
+    void eliminate_var_with_resolvents(
+        const uint32_t var
+        , vector<Resolvent>& res
+        , const vector<Lit>& res_lits
+    );
+
+    //Parallel BVE over variables that share no irred clause
+    struct ElimCand
+    {
+        uint32_t var;
+        int ret;
+        int64_t cost;
+        int64_t aggressive_cost;
+        bool used_aggressive;
+        ElimGate gate;
+        vector<Resolvent> resolvents;
+        vector<Lit> resolvent_lits;
+    };
+    vector<ElimCand> elim_batch;
+    vector<uint32_t> elim_batch_skipped;
+    vector<ElimWork> elim_thread_work;
+    vector<uint8_t> elim_batch_mark; ///<1: in a clause of a batch var, 2: in batch, 3: in batch, clauses changed
+    vector<uint32_t> elim_batch_marked;
+    vector<uint32_t> elim_nbh;
+    bool add_to_elim_batch(const uint32_t var);
+    void mark_elim_batch_changed(const Clause& cl);
+    void clear_elim_batch_marks();
+    size_t eliminate_var_batch(size_t& wenThrough);
+    friend struct OneThreadElim;
 
     struct HeuristicData
     {
@@ -458,7 +616,7 @@ private:
         uint32_t lit;
         uint32_t count; //resolution count (if can be counted, otherwise MAX)
     };
-    HeuristicData calc_data_for_heuristic(const Lit lit);
+    HeuristicData calc_data_for_heuristic(const Lit lit, int64_t& limit) const;
     std::pair<int, int> strategyCalcVarElimScore(const uint32_t var);
     uint64_t time_spent_on_calc_otf_update;
     uint64_t num_otf_update_until_now;
@@ -478,24 +636,29 @@ private:
         , const Watched qs
         , const Lit noPosLit
         , const bool useCache
-    );
+        , ElimWork& w
+    ) const;
     void add_pos_lits_to_dummy_and_seen(
         const Watched ps
         , const Lit posLit
-    );
+        , ElimWork& w
+    ) const;
     bool add_neg_lits_to_dummy_and_seen(
         const Watched qs
         , const Lit posLit
-    );
+        , ElimWork& w
+    ) const;
     bool reverse_distillation_of_dummy(
         const Watched ps
         , const Watched qs
         , const Lit posLit
-    );
+        , ElimWork& w
+    ) const;
     bool subsume_dummy_through_stamping(
        const Watched ps
         , const Watched qs
-    );
+        , ElimWork& w
+    ) const;
     bool aggressiveCheck(
         const Lit lit
         , const Lit noPosLit
@@ -513,12 +676,21 @@ private:
 
     /////////////////////
     //Blocked clause elimination
-    bool anythingHasBeenBlocked;
+    void blocked_clause_elim(const bool covered);
+    bool block_or_cover_clause(const ClOffset offset, const bool covered, const vector<char>& can_block);
+    bool resolvents_blocked_on(const Lit lit, const bool covered);
+    uint64_t num_bce_cls_on_stack = 0; ///<Entries with 'bce' set and not 'toRemove'
+    vector<Lit> bce_cov; ///<Clause being checked, followed by its covered literals
+    vector<std::pair<size_t, Lit> > bce_steps; ///<Size of bce_cov before each literal addition, and the literal it was done on
+    vector<Lit> bce_tmp;
     vector<BlockedClause> blockedClauses;
+    vector<Lit> blkcls; ///<Literals of all blocked clauses
+    vector<Lit> tmp_blk_lits;
     map<uint32_t, vector<size_t> > blk_var_to_cl;
     bool blockedMapBuilt;
     void buildBlockedMap();
     void cleanBlockedClauses();
+    bool bce_cls_blocked_on(const uint32_t var) const;
     bool can_remove_blocked_clauses = false;
 
     //validity checking
@@ -537,14 +709,9 @@ inline const OccSimplifier::Stats& OccSimplifier::get_stats() const
     return globalStats;
 }
 
-inline bool OccSimplifier::getAnythingHasBeenBlocked() const
-{
-    return anythingHasBeenBlocked;
-}
-
 inline std::ostream& operator<<(std::ostream& os, const BlockedClause& bl)
 {
-    os << bl.lits << " blocked on: " << bl.blockedOn;
+    os << "lits [" << bl.start << ", " << bl.end << ")" << " blocked on: " << bl.blockedOn;
 
     return os;
 }
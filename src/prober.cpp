@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <set>
 #include <utility>
 #include <cmath>
+#include <thread>
 
 #include "solver.h"
 #include "clausecleaner.h"
@@ -35,6 +36,8 @@ THE SOFTWARE.
 #include "clausecleaner.h"
 #include "completedetachreattacher.h"
 #include "sqlstats.h"
+#include "varreplacer.h"
+#include "sccfinder.h"
 
 using namespace CMSat;
 using std::make_pair;
@@ -302,7 +305,7 @@ vector<uint32_t> Prober::randomize_possible_choices()
     vars_to_probe.clear();
     for(size_t i = 0; i < solver->nVars(); i++) {
         if (solver->value(i) == l_Undef
-            && solver->varData[i].removed == Removed::none
+            && solver->varFlags.removed(i) == Removed::none
         ) {
             vars_to_probe.push_back(i);
         }
@@ -354,6 +357,11 @@ bool Prober::probe(vector<uint32_t>* probe_order)
     assert(solver->propStats.otfHyperTime == 0);
     single_prop_tout = (double)numPropsTodo *solver->conf.single_probe_time_limit_perc;
 
+    if (solver->conf.probe_threads > 1) {
+        probe_parallel(numPropsTodo);
+        goto end;
+    }
+
     for(size_t i = 0
         ; i < vars_to_probe.size()
         && limit_used() < numPropsTodo
@@ -374,7 +382,7 @@ bool Prober::probe(vector<uint32_t>* probe_order)
 
         //Check if var is set already
         if (solver->value(lit.var()) != l_Undef
-            || solver->varData[lit.var()].removed != Removed::none
+            || solver->varFlags.removed(lit.var()) != Removed::none
             || visitedAlready[lit.toInt()]
         ) {
             continue;
@@ -476,15 +484,17 @@ void Prober::update_cache(Lit thisLit, Lit lit, size_t numElemsSet)
         //Update stats/markings
         //cacheUpdated[(~ancestor).toInt()]++;
         extraTime += 1;
-        extraTimeCache += solver->implCache[~ancestor].lits.size()/30;
-        extraTimeCache += solver->implCache[~thisLit].lits.size()/30;
+        extraTimeCache += solver->implCache[~ancestor].size()/30;
+        extraTimeCache += solver->implCache[~thisLit].size()/30;
 
         const bool redStep = solver->varData[thisLit.var()].reason.isRedStep();
 
         //Update the cache now
         assert(ancestor != lit_Undef);
-        bool taut = solver->implCache[~ancestor].merge(
-            solver->implCache[~thisLit].lits
+        solver->varReplacer->get_scc_finder()->mark_dirty(ancestor.var());
+        bool taut = solver->implCache.merge(
+            ~ancestor
+            , solver->implCache[~thisLit]
             , thisLit
             , redStep
             , ancestor.var()
@@ -495,7 +505,7 @@ void Prober::update_cache(Lit thisLit, Lit lit, size_t numElemsSet)
         //enqueue ~ancestor at toplevel since both
         //~ancestor V OTHER, and ~ancestor V ~OTHER are technically in
         if (taut
-            && solver->varData[ancestor.var()].removed == Removed::none
+            && solver->varFlags.removed(ancestor.var()) == Removed::none
         ) {
             toEnqueue.push_back(~ancestor);
             if (solver->conf.verbosity >= 10)
@@ -504,7 +514,7 @@ void Prober::update_cache(Lit thisLit, Lit lit, size_t numElemsSet)
 
         #ifdef VERBOSE_DEBUG_FULLPROP
         cout << "The impl cache of " << (~ancestor) << " is now: ";
-        cout << solver->implCache[(~ancestor).toInt()] << endl;
+        cout << solver->implCache[~ancestor] << endl;
         #endif
     }
 }
@@ -550,8 +560,10 @@ void Prober::add_rest_of_lits_to_cache(Lit lit)
         tmp_lits.push_back(thisLit);
     }
 
-    bool taut = solver->implCache[~lit].merge(
-        tmp_lits
+    solver->varReplacer->get_scc_finder()->mark_dirty(lit.var());
+    bool taut = solver->implCache.merge(
+        ~lit
+        , tmp_lits
         , lit_Undef
         , true //Red step -- we don't know, so we assume
         , lit.var()
@@ -745,6 +757,400 @@ bool Prober::propagate(Lit& failed)
     return true;
 }
 
+namespace CMSat {
+struct OneThreadProbe
+{
+    OneThreadProbe(
+        const Prober* _prober
+        , Prober::ProbeWork& _w
+        , const size_t _tid
+        , const size_t _num_threads
+        , const uint64_t _max_props
+    ) :
+        prober(_prober)
+        , w(_w)
+        , tid(_tid)
+        , num_threads(_num_threads)
+        , max_props(_max_props)
+    {
+    }
+
+    void operator()()
+    {
+        prober->probe_in_thread(w, tid, num_threads, max_props);
+    }
+
+    const Prober* prober;
+    Prober::ProbeWork& w;
+    const size_t tid;
+    const size_t num_threads;
+    const uint64_t max_props;
+};
+}
+
+//Each thread gets the full budget, so the wall-clock time is about the
+//same as that of the serial probing, but more candidates are covered
+bool Prober::probe_parallel(const uint64_t numPropsTodo)
+{
+    build_probe_view();
+
+    const size_t num_threads = solver->conf.probe_threads;
+    vector<ProbeWork> works(num_threads);
+    for(ProbeWork& w: works) {
+        w.val.resize(solver->nVars()*2, 0);
+        w.parent.resize(solver->nVars(), lit_Undef);
+        w.depth.resize(solver->nVars(), 0);
+        w.false_cnt.resize(cl_at.size()-1, 0);
+        w.visited.resize(solver->nVars()*2, 0);
+        w.first_prop.resize(solver->nVars()*2, 0);
+        w.hyperbin = solver->conf.otfHyperbin;
+        w.bothprop = solver->conf.doBothProp;
+    }
+
+    const uint64_t max_props = numPropsTodo > limit_used() ? numPropsTodo - limit_used() : 0;
+    vector<std::thread> thds;
+    for(size_t i = 0; i < num_threads; i++) {
+        thds.push_back(std::thread(OneThreadProbe(
+            this, works[i], i, num_threads, max_props)));
+    }
+    for(std::thread& thread : thds) {
+        thread.join();
+    }
+    free_probe_view();
+
+    //Time is that of the slowest thread
+    uint64_t props = 0;
+    for(const ProbeWork& w: works) {
+        props = std::max(props, w.bogoprops);
+        runStats.numProbed += w.numProbed;
+        runStats.numVarProbed += w.numVarProbed;
+        runStats.numLoopIters += w.numLoopIters;
+        for(size_t i = 0; i < visitedAlready.size(); i++) {
+            visitedAlready[i] |= w.visited[i];
+        }
+    }
+    solver->propStats.bogoProps += props;
+
+    return merge_probe_results(works);
+}
+
+//Binary implications in CSR form, the long clauses flattened, and for each
+//literal the long clauses it is in. Irred long clauses and the best tier of
+//redundant ones are used.
+void Prober::build_probe_view()
+{
+    const size_t num_lits = solver->nVars()*2;
+    bin_at.clear();
+    bin_at.resize(num_lits+1, 0);
+    for(size_t i = 0; i < num_lits; i++) {
+        //Binary clauses (~lit V lit2) are implications lit -> lit2
+        const Lit lit = Lit::toLit(i);
+        watch_subarray_const ws = solver->watches[~lit];
+        extraTime += ws.size()/4;
+        bin_at[i+1] = bin_at[i];
+        for (const Watched& w: ws) {
+            if (w.isBin()) {
+                bin_impl.push_back(w.lit2());
+                bin_at[i+1]++;
+            }
+        }
+    }
+
+    cl_at.clear();
+    cl_lits.clear();
+    occ_at.clear();
+    occ_at.resize(num_lits+1, 0);
+    for(const vector<ClOffset>* cls: {&solver->longIrredCls, &solver->longRedCls[0]}) {
+        for(const ClOffset offset: *cls) {
+            const Clause* cl = solver->cl_alloc.ptr(offset);
+            extraTime += cl->size();
+            cl_at.push_back(cl_lits.size());
+            for(const Lit l: *cl) {
+                cl_lits.push_back(l);
+                occ_at[l.toInt()+1]++;
+            }
+        }
+    }
+    cl_at.push_back(cl_lits.size());
+    for(size_t i = 0; i < num_lits; i++) {
+        occ_at[i+1] += occ_at[i];
+    }
+
+    occ_cls.resize(cl_lits.size());
+    vector<uint32_t> at(occ_at.begin(), occ_at.end()-1);
+    for(size_t c = 0; c+1 < cl_at.size(); c++) {
+        for(size_t i = cl_at[c]; i < cl_at[c+1]; i++) {
+            occ_cls[at[cl_lits[i].toInt()]++] = c;
+        }
+    }
+}
+
+void Prober::free_probe_view()
+{
+    for(vector<uint32_t>* v: {&bin_at, &cl_at, &occ_at, &occ_cls}) {
+        v->clear();
+        v->shrink_to_fit();
+    }
+    for(vector<Lit>* v: {&bin_impl, &cl_lits}) {
+        v->clear();
+        v->shrink_to_fit();
+    }
+}
+
+void Prober::probe_in_thread(
+    ProbeWork& w
+    , const size_t tid
+    , const size_t num_threads
+    , const uint64_t max_props
+) const {
+    for(size_t i = tid
+        ; i < vars_to_probe.size()
+        && w.bogoprops < max_props
+        && !solver->must_interrupt_asap()
+        ; i += num_threads
+    ) {
+        w.numLoopIters++;
+        const uint32_t var = vars_to_probe[i];
+        const Lit lit = Lit(var, false);
+        if (solver->value(var) != l_Undef
+            || solver->varFlags.removed(var) != Removed::none
+            || w.visited[lit.toInt()]
+        ) {
+            continue;
+        }
+
+        w.numVarProbed++;
+        if (probe_lit_in_thread(w, lit, true)) {
+            probe_lit_in_thread(w, ~lit, false);
+        }
+    }
+}
+
+//Returns false if the lit failed
+bool Prober::probe_lit_in_thread(ProbeWork& w, const Lit lit, const bool first) const
+{
+    if (first) {
+        for(const Lit l: w.first_prop_lits) {
+            w.first_prop[l.toInt()] = 0;
+        }
+        w.first_prop_lits.clear();
+    }
+
+    w.numProbed++;
+    w.val[lit.toInt()] = 1;
+    w.parent[lit.var()] = lit_Undef;
+    w.depth[lit.var()] = 0;
+    w.trail.push_back(lit);
+
+    const Lit failed = propagate_in_thread(w);
+    if (failed != lit_Undef) {
+        w.failed.push_back(failed);
+    } else {
+        for(const Lit l: w.trail) {
+            w.visited[l.toInt()] = 1;
+            if (!w.bothprop) {
+                continue;
+            }
+            if (first) {
+                w.first_prop[l.toInt()] = 1;
+                w.first_prop_lits.push_back(l);
+            } else if (w.first_prop[l.toInt()]) {
+                w.both.push_back(std::make_pair(lit, l));
+            }
+        }
+        w.bogoprops += w.trail.size();
+    }
+    cancel_in_thread(w);
+
+    return failed == lit_Undef;
+}
+
+//Deepest common ancestor in the implication tree. Everything below it is
+//implied by it through propagation alone
+Lit Prober::common_ancestor(ProbeWork& w, Lit a, Lit b) const
+{
+    while(a != b) {
+        w.bogoprops++;
+        if (w.depth[a.var()] >= w.depth[b.var()]) {
+            a = w.parent[a.var()];
+        } else {
+            b = w.parent[b.var()];
+        }
+    }
+    return a;
+}
+
+//Binaries are propagated for the whole trail before a long clause is
+//looked at, so the tree is as shallow as possible and hyper-binary
+//resolvents are not implied by existing binaries. Long clauses are
+//propagated by counting their false literals. Returns lit_Undef, or the
+//deepest literal whose propagation alone leads to the conflict
+Lit Prober::propagate_in_thread(ProbeWork& w) const
+{
+    while(true) {
+        while(w.qhead_bin < w.trail.size()) {
+            const Lit p = w.trail[w.qhead_bin++];
+            for(uint32_t i = bin_at[p.toInt()]; i < bin_at[p.toInt()+1]; i++) {
+                w.bogoprops++;
+                const Lit q = bin_impl[i];
+                if (w.val[q.toInt()]) {
+                    continue;
+                }
+                if (w.val[(~q).toInt()]) {
+                    return common_ancestor(w, p, ~q);
+                }
+                w.val[q.toInt()] = 1;
+                w.parent[q.var()] = p;
+                w.depth[q.var()] = w.depth[p.var()] + 1;
+                w.trail.push_back(q);
+            }
+        }
+
+        if (w.qhead_long == w.trail.size()) {
+            return lit_Undef;
+        }
+
+        //All false lits must be counted, even after a conflict, for
+        //cancel_in_thread() to undo the counts
+        const Lit p = w.trail[w.qhead_long++];
+        Lit failed = lit_Undef;
+        for(uint32_t i = occ_at[(~p).toInt()]; i < occ_at[(~p).toInt()+1]; i++) {
+            w.bogoprops++;
+            const uint32_t c = occ_cls[i];
+            w.false_cnt[c]++;
+            if (failed != lit_Undef
+                || w.false_cnt[c] + 1 < cl_at[c+1] - cl_at[c]
+            ) {
+                continue;
+            }
+
+            //Unit or conflicting, unless satisfied or some lits are not
+            //counted yet
+            Lit unset = lit_Undef;
+            uint32_t num_unset = 0;
+            bool satisfied = false;
+            for(uint32_t at = cl_at[c]; at < cl_at[c+1]; at++) {
+                const Lit l = cl_lits[at];
+                if (w.val[l.toInt()]) {
+                    satisfied = true;
+                    break;
+                }
+                if (!w.val[(~l).toInt()]) {
+                    unset = l;
+                    num_unset++;
+                }
+            }
+            w.bogoprops += cl_at[c+1] - cl_at[c];
+            if (satisfied || num_unset > 1) {
+                continue;
+            }
+
+            Lit ancestor = lit_Undef;
+            for(uint32_t at = cl_at[c]; at < cl_at[c+1]; at++) {
+                const Lit l = cl_lits[at];
+                if (l == unset) {
+                    continue;
+                }
+                ancestor = (ancestor == lit_Undef) ? ~l : common_ancestor(w, ancestor, ~l);
+            }
+            if (num_unset == 0) {
+                failed = ancestor;
+                continue;
+            }
+
+            if (w.hyperbin) {
+                w.hyper_bins.push_back(std::make_pair(~ancestor, unset));
+            }
+            w.val[unset.toInt()] = 1;
+            w.parent[unset.var()] = ancestor;
+            w.depth[unset.var()] = w.depth[ancestor.var()] + 1;
+            w.trail.push_back(unset);
+        }
+
+        if (failed != lit_Undef) {
+            return failed;
+        }
+    }
+}
+
+void Prober::cancel_in_thread(ProbeWork& w) const
+{
+    for(size_t i = 0; i < w.qhead_long; i++) {
+        const Lit p = w.trail[i];
+        for(uint32_t at = occ_at[(~p).toInt()]; at < occ_at[(~p).toInt()+1]; at++) {
+            w.false_cnt[occ_cls[at]]--;
+        }
+        w.bogoprops += occ_at[(~p).toInt()+1] - occ_at[(~p).toInt()];
+    }
+    for(const Lit l: w.trail) {
+        w.val[l.toInt()] = 0;
+    }
+    w.trail.clear();
+    w.qhead_bin = 0;
+    w.qhead_long = 0;
+}
+
+//Everything found is implied by the clauses through unit propagation, given
+//the hyper-binary resolvents, so each can be added to DRAT as it is
+bool Prober::merge_probe_results(vector<ProbeWork>& works)
+{
+    assert(solver->decisionLevel() == 0);
+
+    vector<std::pair<Lit, Lit> > bins;
+    for(const ProbeWork& w: works) {
+        for(std::pair<Lit, Lit> bin: w.hyper_bins) {
+            if (bin.second < bin.first) {
+                std::swap(bin.first, bin.second);
+            }
+            bins.push_back(bin);
+        }
+    }
+    std::sort(bins.begin(), bins.end());
+    bins.erase(std::unique(bins.begin(), bins.end()), bins.end());
+    extraTime += bins.size()*2;
+    for(const std::pair<Lit, Lit>& bin: bins) {
+        *solver->drat << bin.first << bin.second << fin;
+        solver->attach_bin_clause(bin.first, bin.second, true);
+        runStats.addedBin++;
+    }
+
+    for(const ProbeWork& w: works) {
+        for(const Lit failed: w.failed) {
+            runStats.numFailed++;
+            runStats.conflStats.numConflicts++;
+            tmp_lits.clear();
+            tmp_lits.push_back(~failed);
+            solver->add_clause_int(tmp_lits, true);
+            if (!solver->ok) {
+                return false;
+            }
+        }
+    }
+
+    for(const ProbeWork& w: works) {
+        for(const std::pair<Lit, Lit>& both: w.both) {
+            const Lit lit = both.first;
+            const Lit implied = both.second;
+            if (solver->value(implied) == l_True) {
+                continue;
+            }
+            runStats.bothSameAdded++;
+            *solver->drat << ~lit << implied << fin;
+            *solver->drat << lit << implied << fin;
+            tmp_lits.clear();
+            tmp_lits.push_back(implied);
+            solver->add_clause_int(tmp_lits, true);
+            *solver->drat << del << ~lit << implied << fin;
+            *solver->drat << del << lit << implied << fin;
+            if (!solver->ok) {
+                return false;
+            }
+        }
+    }
+
+    return solver->ok;
+}
+
 size_t Prober::mem_used() const
 {
     size_t mem = 0;
@@ -764,7 +1170,7 @@ size_t Prober::mem_used() const
 //     while(true) {
 //         uint32_t var = solver->negPosDist[solver->mtrand.randInt(max)].var;
 //         if (solver->value(var) != l_Undef
-//             || (solver->varData[var].removed != Removed::none)
+//             || (solver->varFlags.removed(var) != Removed::none)
 //         ) continue;
 //
 //         bool OK = true;
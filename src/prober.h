@@ -254,6 +254,51 @@ class Prober {
         bool tryMultiLevelAll();
         void fillToTry(vector<uint32_t>& toTry);
 
+        //Parallel probing. Threads probe disjoint sets of variables over a
+        //read-only snapshot of the clauses, each with its own trail, and
+        //the results are added to the solver serially afterwards
+        struct ProbeWork
+        {
+            vector<uint8_t> val; ///<1 if the literal is true
+            vector<Lit> parent; ///<Implication tree, rooted at the probed lit
+            vector<uint32_t> depth;
+            vector<uint32_t> false_cnt; ///<Number of false lits processed, for each long clause
+            vector<Lit> trail;
+            size_t qhead_bin = 0;
+            size_t qhead_long = 0;
+            vector<char> visited;
+            vector<char> first_prop; ///<Lits propagated by the first polarity, for bothprop
+            vector<Lit> first_prop_lits;
+            bool hyperbin = false;
+            bool bothprop = false;
+
+            //Results
+            vector<Lit> failed; ///<Propagating these alone leads to conflict
+            vector<std::pair<Lit, Lit> > both; ///<Lit and its negation both imply second
+            vector<std::pair<Lit, Lit> > hyper_bins;
+
+            uint64_t bogoprops = 0;
+            uint64_t numProbed = 0;
+            uint64_t numVarProbed = 0;
+            uint64_t numLoopIters = 0;
+        };
+        vector<uint32_t> bin_at; ///<bin_impl[bin_at[lit], bin_at[lit+1]) are implied by lit
+        vector<Lit> bin_impl;
+        vector<uint32_t> cl_at;
+        vector<Lit> cl_lits;
+        vector<uint32_t> occ_at;
+        vector<uint32_t> occ_cls;
+        bool probe_parallel(const uint64_t numPropsTodo);
+        void build_probe_view();
+        void free_probe_view();
+        void probe_in_thread(ProbeWork& w, const size_t tid, const size_t num_threads, const uint64_t max_props) const;
+        bool probe_lit_in_thread(ProbeWork& w, const Lit lit, const bool first) const;
+        Lit propagate_in_thread(ProbeWork& w) const;
+        void cancel_in_thread(ProbeWork& w) const;
+        Lit common_ancestor(ProbeWork& w, Lit a, Lit b) const;
+        bool merge_probe_results(vector<ProbeWork>& works);
+        friend struct OneThreadProbe;
+
         //Used to count extra time, must be cleared at every startup
         uint64_t extraTime;
         uint64_t extraTimeCache;
@@ -94,8 +94,8 @@ void PropEngine::attach_bin_clause(
         assert(value(lit2) == l_Undef || value(lit2) == l_False);
     }
 
-    assert(varData[lit1.var()].removed == Removed::none);
-    assert(varData[lit2.var()].removed == Removed::none);
+    assert(varFlags.removed(lit1.var()) == Removed::none);
+    assert(varFlags.removed(lit2.var()) == Removed::none);
     #endif //DEBUG_ATTACH
 
     watches[lit1].push(Watched(lit2, red));
@@ -122,7 +122,7 @@ void PropEngine::attachClause(
 
     #ifdef DEBUG_ATTACH
     for (uint32_t i = 0; i < c.size(); i++) {
-        assert(varData[c[i].var()].removed == Removed::none);
+        assert(varFlags.removed(c[i].var()) == Removed::none);
     }
     #endif //DEBUG_ATTACH
 
@@ -239,7 +239,7 @@ bool PropEngine::prop_long_cl_any_order(
         return false;
     } else {
         #ifdef STATS_NEEDED
-        c.stats.propagations_made++;
+        cl_alloc.extra_stats(c).propagations_made++;
         if (c.red())
             propStats.propsLongRed++;
         else
@@ -437,7 +437,7 @@ void PropEngine::sortWatched()
         ; i < watches.watches.size()
         ; ++i
     ) {
-        vec<Watched>& ws = watches.watches[i];
+        watch_subarray ws = watches.watches[i];
         if (ws.size() <= 1)
             continue;
 
@@ -450,7 +450,7 @@ void PropEngine::sortWatched()
         cout << endl;
         #endif //VERBOSE_DEBUG
 
-        vec<Watched> sorted;
+        watch_list sorted;
         for(Watched& w: ws) {
             if (w.isBin()) {
                 sorted.push(w);
@@ -504,6 +504,7 @@ void PropEngine::updateVars(
     , const vector<uint32_t>& interToOuter2
 ) {
     updateArray(varData, interToOuter);
+    varFlags.update_vars(interToOuter);
     updateArray(assigns, interToOuter);
     assert(decisionLevel() == 0);
 
@@ -294,7 +294,7 @@ inline PropResult PropEngine::prop_normal_helper(
     , const Lit p
 ) {
     #ifdef STATS_NEEDED
-    c.stats.clause_looked_at++;
+    cl_alloc.extra_stats(c).clause_looked_at++;
     #endif
 
     // Make sure the false literal is data[1]:
@@ -348,8 +348,8 @@ inline PropResult PropEngine::handle_normal_prop_fail(
 
     //Update stats
     #ifdef STATS_NEEDED
-    c.stats.conflicts_made++;
-    c.stats.sum_of_branch_depth_conflict += decisionLevel() + 1;
+    cl_alloc.extra_stats(c).conflicts_made++;
+    cl_alloc.extra_stats(c).sum_of_branch_depth_conflict += decisionLevel() + 1;
     if (c.red())
         lastConflictCausedBy = ConflCausedBy::longred;
     else
@@ -376,7 +376,7 @@ void PropEngine::enqueue(const Lit p, const PropBy from)
 
     #ifdef ENQUEUE_DEBUG
     assert(trail.size() <= nVarsOuter());
-    assert(varData[p.var()].removed == Removed::none);
+    assert(varFlags.removed(p.var()) == Removed::none);
     #endif
 
     const uint32_t v = p.var();
@@ -390,7 +390,7 @@ void PropEngine::enqueue(const Lit p, const PropBy from)
     varData[v].reason = from;
     varData[v].level = decisionLevel();
     if (!update_bogoprops) {
-        varData[v].polarity = !sign;
+        varFlags.set_polarity(v, !sign);
     }
     trail.push_back(p);
 
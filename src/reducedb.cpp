@@ -242,7 +242,11 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
                 cl->stats.ttl--;
             }
             solver->longRedCls[1][j++] = offset;
-            tmpStats.remain.incorporate(cl, sumConfl);
+            tmpStats.remain.incorporate(cl, sumConfl
+            #ifdef STATS_NEEDED
+            , solver->cl_alloc.extra_stats(*cl)
+            #endif
+        );
             cl->stats.marked_clause = 0;
             continue;
         }
@@ -251,7 +255,11 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
         cl->setRemoved();
         solver->watches.smudge((*cl)[0]);
         solver->watches.smudge((*cl)[1]);
-        tmpStats.removed.incorporate(cl, sumConfl);
+        tmpStats.removed.incorporate(cl, sumConfl
+            #ifdef STATS_NEEDED
+            , solver->cl_alloc.extra_stats(*cl)
+            #endif
+        );
         solver->litStats.redLits -= cl->size();
 
         *solver->drat << del << *cl << fin;
@@ -297,10 +305,18 @@ ClauseUsageStats ReduceDB::sumClauseData(
 
     for(ClOffset offset: toprint) {
         const Clause& cl = *solver->cl_alloc.ptr(offset);
-        stats.addStat(cl);
+        stats.addStat(cl
+            #ifdef STATS_NEEDED
+            , solver->cl_alloc.extra_stats(cl)
+            #endif
+        );
 
         if (solver->conf.verbosity >= 6)
-            cl.print_extra_stats();
+            cl.print_extra_stats(
+                #ifdef STATS_NEEDED
+                solver->cl_alloc.extra_stats(cl)
+                #endif
+            );
     }
 
     return stats;
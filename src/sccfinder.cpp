@@ -36,7 +36,8 @@ using std::cout;
 using std::endl;
 
 SCCFinder::SCCFinder(Solver* _solver) :
-    globalIndex(0)
+    all_dirty(true)
+    , globalIndex(0)
     , solver(_solver)
 {}
 
@@ -45,32 +46,21 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     assert(binxors.empty());
     runStats.clear();
     runStats.numCalls = 1;
+    runStats.partialCalls = !all_dirty;
     const double myTime = cpuTime();
 
-    globalIndex = 0;
-    index.clear();
-    index.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
-    lowlink.clear();
-    lowlink.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
-    stackIndicator.clear();
-    stackIndicator.resize(solver->nVars()*2, false);
-    assert(stack.empty());
+    build_graph();
+    tarjan();
 
-    depth = 0;
-    for (uint32_t vertex = 0; vertex < solver->nVars()*2; vertex++) {
-        //Start a DFS at each node we haven't visited yet
-        const uint32_t v = vertex>>1;
-        if (solver->value(v) != l_Undef) {
-            continue;
-        }
-        assert(depth == 0);
-        if (index[vertex] == std::numeric_limits<uint32_t>::max()) {
-            tarjan(vertex);
-            depth--;
-            assert(stack.empty());
-        }
+    //Reset the snapshot's literal->ID map, it's only touched where we went
+    for(const Lit lit: vertex_lit) {
+        local_id[lit.toInt()] = std::numeric_limits<uint32_t>::max();
     }
 
+    //What we found may not get replaced, so it must be found again next time
+    set_all_dirty();
+    all_dirty = !binxors.empty();
+
     //Update & print stats
     runStats.cpu_time = cpuTime() - myTime;
     runStats.foundXorsNew = binxors.size();
@@ -90,80 +80,147 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     return solver->ok;
 }
 
-void SCCFinder::tarjan(const uint32_t vertex)
+uint32_t SCCFinder::add_vertex(const Lit lit)
 {
-    depth++;
-    if (depth >= (uint32_t)solver->conf.max_scc_depth) {
-        if (solver->conf.verbosity) {
-            cout << "c [scc] WARNING: reached maximum depth of " << solver->conf.max_scc_depth << endl;
-        }
-        return;
+    uint32_t& id = local_id[lit.toInt()];
+    if (id == std::numeric_limits<uint32_t>::max()) {
+        id = vertex_lit.size();
+        vertex_lit.push_back(lit);
     }
+    return id;
+}
 
-    const Lit vertLit = Lit::toLit(vertex);
-    if (solver->varData[vertLit.var()].removed != Removed::none) {
-        return;
-    }
+//Copies the implications reachable from the dirty literals into
+//edge_at/edges, in the order the vertices are found
+void SCCFinder::build_graph()
+{
+    local_id.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
+    vertex_lit.clear();
+    edge_at.clear();
+    edges.clear();
 
-    runStats.bogoprops += 1;
-    index[vertex] = globalIndex;  // Set the depth index for v
-    lowlink[vertex] = globalIndex;
-    globalIndex++;
-    stack.push(vertex); // Push v on the stack
-    stackIndicator[vertex] = true;
+    const size_t num_start = all_dirty ? solver->nVars() : dirty_vars.size();
+    for (size_t i = 0; i < num_start; i++) {
+        const uint32_t var = all_dirty ? i : dirty_vars[i];
+        if (var >= solver->nVars()
+            || solver->value(var) != l_Undef
+            || solver->varFlags.removed(var) != Removed::none
+        ) {
+            continue;
+        }
+        add_vertex(Lit(var, false));
+        add_vertex(Lit(var, true));
+    }
 
-    vector<LitExtra>* transCache = NULL;
-    if (solver->conf.doCache
+    const bool use_cache = solver->conf.doCache
         && solver->conf.doExtendedSCC
-        && (!solver->drat->enabled() || solver->conf.otfHyperbin)
-    ) {
-        transCache = &(solver->implCache[~vertLit].lits);
-        __builtin_prefetch(transCache->data());
-    }
+        && (!solver->drat->enabled() || solver->conf.otfHyperbin);
 
-    //Go through the watch
-    watch_subarray_const ws = solver->watches[~vertLit];
-    runStats.bogoprops += ws.size()/4;
-    for (const Watched& w: ws) {
-        //Only binary clauses matter
-        if (!w.isBin())
-            continue;
+    for(size_t at = 0; at < vertex_lit.size(); at++) {
+        const Lit vertLit = vertex_lit[at];
+        edge_at.push_back(edges.size());
+        runStats.bogoprops += 1;
 
-        const Lit lit = w.lit2();
-        if (solver->value(lit) != l_Undef) {
-            continue;
-        }
-        doit(lit, vertex);
-    }
+        //Binary clauses (~vertLit V lit) imply lit
+        watch_subarray_const ws = solver->watches[~vertLit];
+        runStats.bogoprops += ws.size()/4;
+        for (const Watched& w: ws) {
+            if (!w.isBin())
+                continue;
 
-    if (transCache) {
-        runStats.bogoprops += transCache->size()/4;
-        for (const LitExtra& le: *transCache) {
-            Lit lit = le.getLit();
-            if (solver->value(lit) != l_Undef) {
+            const Lit lit = w.lit2();
+            if (solver->value(lit) != l_Undef
+                || solver->varFlags.removed(lit.var()) != Removed::none
+            ) {
                 continue;
             }
-            if (lit != ~vertLit) {
-                doit(lit, vertex);
+            edges.push_back(add_vertex(lit));
+        }
+
+        if (use_cache) {
+            const CacheLits transCache = solver->implCache[~vertLit];
+            runStats.bogoprops += transCache.size()/4;
+            for (const LitExtra le: transCache) {
+                const Lit lit = le.getLit();
+                if (lit == ~vertLit
+                    || solver->value(lit) != l_Undef
+                    || solver->varFlags.removed(lit.var()) != Removed::none
+                ) {
+                    continue;
+                }
+                edges.push_back(add_vertex(lit));
             }
         }
     }
+    edge_at.push_back(edges.size());
+    runStats.vertices += vertex_lit.size();
+    runStats.edges += edges.size();
+}
 
-    // Is v the root of an SCC?
-    if (lowlink[vertex] == index[vertex]) {
-        uint32_t vprime;
-        tmp.clear();
-        do {
-            assert(!stack.empty());
-            vprime = stack.top();
-            stack.pop();
-            stackIndicator[vprime] = false;
-            tmp.push_back(vprime);
-        } while (vprime != vertex);
-        if (tmp.size() >= 2) {
-            runStats.bogoprops += 3;
-            add_bin_xor_in_tmp();
+void SCCFinder::tarjan()
+{
+    const uint32_t num = vertex_lit.size();
+    globalIndex = 0;
+    index.clear();
+    index.resize(num, std::numeric_limits<uint32_t>::max());
+    lowlink.clear();
+    lowlink.resize(num, std::numeric_limits<uint32_t>::max());
+    stackIndicator.clear();
+    stackIndicator.resize(num, false);
+    assert(stack.empty());
+    assert(frames.empty());
+
+    for (uint32_t root = 0; root < num; root++) {
+        //Start a DFS at each node we haven't visited yet
+        if (index[root] != std::numeric_limits<uint32_t>::max()) {
+            continue;
+        }
+
+        frames.push_back(Frame{root, edge_at[root]});
+        index[root] = lowlink[root] = globalIndex++;
+        stack.push_back(root);
+        stackIndicator[root] = true;
+        while(!frames.empty()) {
+            const uint32_t vertex = frames.back().vertex;
+            const uint32_t at = frames.back().at;
+            if (at < edge_at[vertex+1]) {
+                frames.back().at++;
+                const uint32_t succ = edges[at];
+                if (index[succ] == std::numeric_limits<uint32_t>::max()) {
+                    // Successor not yet visited, descend into it
+                    frames.push_back(Frame{succ, edge_at[succ]});
+                    index[succ] = lowlink[succ] = globalIndex++;
+                    stack.push_back(succ);
+                    stackIndicator[succ] = true;
+                } else if (stackIndicator[succ]) {
+                    lowlink[vertex] = std::min(lowlink[vertex], index[succ]);
+                }
+                continue;
+            }
+
+            // All successors done. Is v the root of an SCC?
+            if (lowlink[vertex] == index[vertex]) {
+                uint32_t vprime;
+                tmp.clear();
+                do {
+                    assert(!stack.empty());
+                    vprime = stack.back();
+                    stack.pop_back();
+                    stackIndicator[vprime] = false;
+                    tmp.push_back(vertex_lit[vprime].toInt());
+                } while (vprime != vertex);
+                if (tmp.size() >= 2) {
+                    runStats.bogoprops += 3;
+                    add_bin_xor_in_tmp();
+                }
+            }
+            frames.pop_back();
+            if (!frames.empty()) {
+                const uint32_t parent = frames.back().vertex;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[vertex]);
+            }
         }
+        assert(stack.empty());
     }
 }
 
@@ -218,10 +275,17 @@ void SCCFinder::Stats::print_short(Solver* solver) const
 size_t SCCFinder::mem_used() const
 {
     size_t mem = 0;
+    mem += local_id.capacity()*sizeof(uint32_t);
+    mem += vertex_lit.capacity()*sizeof(Lit);
+    mem += edge_at.capacity()*sizeof(uint32_t);
+    mem += edges.capacity()*sizeof(uint32_t);
+    mem += dirty_vars.capacity()*sizeof(uint32_t);
+    mem += var_dirty.capacity()*sizeof(char);
     mem += index.capacity()*sizeof(uint32_t);
     mem += lowlink.capacity()*sizeof(uint32_t);
-    mem += stack.size()*sizeof(uint32_t); //TODO under-estimates
+    mem += stack.capacity()*sizeof(uint32_t);
     mem += stackIndicator.capacity()*sizeof(char);
+    mem += frames.capacity()*sizeof(Frame);
     mem += tmp.capacity()*sizeof(uint32_t);
 
     return mem;
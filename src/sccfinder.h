@@ -24,13 +24,22 @@ THE SOFTWARE.
 #define SCCFINDER_H
 
 #include "clause.h"
-#include <stack>
 #include <set>
 
 namespace CMSat {
 
 class Solver;
 
+/**
+@brief Finds equivalent literals as SCCs of the binary implication graph
+
+The implications reachable from the start literals are first copied into a
+compact CSR snapshot, then Tarjan's algorithm runs on it with an explicit
+stack. Since an SCC that was not there at the last call must contain a new
+implication, only literals of variables with new binary clauses (or new
+cache entries) are used as start literals, unless the last call found
+something or the variables were renumbered
+*/
 class SCCFinder {
     public:
         SCCFinder(Solver* _solver);
@@ -38,6 +47,8 @@ class SCCFinder {
         const std::set<BinaryXor>& get_binxors() const;
         size_t get_num_binxors_found() const;
         void clear_binxors();
+        void mark_dirty(const uint32_t var);
+        void set_all_dirty();
 
         struct Stats
         {
@@ -48,18 +59,24 @@ class SCCFinder {
             }
 
             uint64_t numCalls = 0;
+            uint64_t partialCalls = 0;
             double cpu_time = 0.0;
             uint64_t foundXors = 0;
             uint64_t foundXorsNew = 0;
             uint64_t bogoprops = 0;
+            uint64_t vertices = 0;
+            uint64_t edges = 0;
 
             Stats& operator+=(const Stats& other)
             {
                 numCalls += other.numCalls;
+                partialCalls += other.partialCalls;
                 cpu_time += other.cpu_time;
                 foundXors += other.foundXors;
                 foundXorsNew += other.foundXorsNew;
                 bogoprops += other.bogoprops;
+                vertices += other.vertices;
+                edges += other.edges;
 
                 return *this;
             }
@@ -85,6 +102,18 @@ class SCCFinder {
                     , "% of all found"
                 );
 
+                print_stats_line("c partial calls"
+                    , partialCalls
+                    , stats_line_percent(partialCalls, numCalls)
+                    , "% of calls"
+                );
+
+                print_stats_line("c vertices/edges/calls"
+                    , vertices
+                    , edges
+                    , numCalls
+                );
+
                 print_stats_line("c bogoprops"
                     , bogoprops
                     , "% of all found"
@@ -100,18 +129,34 @@ class SCCFinder {
         size_t mem_used() const;
 
     private:
-        void tarjan(const uint32_t vertex);
-        void doit(const Lit lit, const uint32_t vertex);
+        void build_graph();
+        uint32_t add_vertex(const Lit lit);
+        void tarjan();
         void add_bin_xor_in_tmp();
 
+        //Snapshot of the implication graph, local vertex IDs
+        vector<uint32_t> local_id; ///<Per literal, its local ID or 'none'
+        vector<Lit> vertex_lit; ///<Per local ID, its literal
+        vector<uint32_t> edge_at; ///<Edges of vertex 'v' are in edges[edge_at[v], edge_at[v+1])
+        vector<uint32_t> edges;
+
+        //Variables whose implications changed since the last call
+        bool all_dirty;
+        vector<uint32_t> dirty_vars;
+        vector<char> var_dirty;
+
         //temporaries
+        struct Frame {
+            uint32_t vertex;
+            uint32_t at; ///<Next edge to visit
+        };
         uint32_t globalIndex;
         vector<uint32_t> index;
         vector<uint32_t> lowlink;
-        std::stack<uint32_t, vector<uint32_t> > stack;
+        vector<uint32_t> stack;
         vector<char> stackIndicator;
+        vector<Frame> frames;
         vector<uint32_t> tmp;
-        uint32_t depth;
 
         Solver* solver;
         std::set<BinaryXor> binxors;
@@ -121,15 +166,27 @@ class SCCFinder {
         Stats globalStats;
 };
 
-inline void SCCFinder::doit(const Lit lit, const uint32_t vertex) {
-    // Was successor v' visited?
-    if (index[lit.toInt()] ==  std::numeric_limits<uint32_t>::max()) {
-        tarjan(lit.toInt());
-        depth--;
-        lowlink[vertex] = std::min(lowlink[vertex], lowlink[lit.toInt()]);
-    } else if (stackIndicator[lit.toInt()])  {
-        lowlink[vertex] = std::min(lowlink[vertex], lowlink[lit.toInt()]);
+inline void SCCFinder::mark_dirty(const uint32_t var)
+{
+    if (all_dirty) {
+        return;
+    }
+    if (var >= var_dirty.size()) {
+        var_dirty.resize(var+1, 0);
+    }
+    if (!var_dirty[var]) {
+        var_dirty[var] = 1;
+        dirty_vars.push_back(var);
+    }
+}
+
+inline void SCCFinder::set_all_dirty()
+{
+    all_dirty = true;
+    for(const uint32_t var: dirty_vars) {
+        var_dirty[var] = 0;
     }
+    dirty_vars.clear();
 }
 
 inline const SCCFinder::Stats& SCCFinder::get_stats() const
@@ -134,7 +134,7 @@ inline void Searcher::add_lit_to_learnt(
 ) {
     antec_data.vsids_all_incoming_vars.push(activ_glue[lit.var()]/var_inc);
     const uint32_t var = lit.var();
-    assert(varData[var].removed == Removed::none);
+    assert(varFlags.removed(var) == Removed::none);
 
     //If var is at level 0, don't do anything with it, just skip
     if (seen[var] || varData[var].level == 0) {
@@ -401,9 +401,9 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             if (cl->red()) {
                 stats.resolvs.longRed++;
                 #ifdef STATS_NEEDED
-                antec_data.vsids_of_ants.push(cl->stats.antec_data.vsids_vars.avg());
+                antec_data.vsids_of_ants.push(cl_alloc.extra_stats(*cl).antec_data.vsids_vars.avg());
                 antec_data.longRed++;
-                antec_data.age_long_reds.push(sumConflicts() - cl->stats.introduced_at_conflict);
+                antec_data.age_long_reds.push(sumConflicts() - cl_alloc.extra_stats(*cl).introduced_at_conflict);
                 antec_data.glue_long_reds.push(cl->stats.glue);
                 #endif
             } else {
@@ -413,7 +413,7 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             antec_data.size_longs.push(cl->size());
 
             #ifdef STATS_NEEDED
-            cl->stats.used_for_uip_creation++;
+            cl_alloc.extra_stats(*cl).used_for_uip_creation++;
             #endif
             if (!update_bogoprops
                 && cl->red()
@@ -495,6 +495,144 @@ inline void Searcher::minimize_learnt_clause()
     stats.recMinLitRem += origSize - learnt_clause.size();
 }
 
+//Walks the trail of 'level' backwards, resolving away the literals of the
+//learnt clause that are on this level, until only one, the level's UIP is
+//left. Fails if a reason would bring in a literal of another level that is
+//not already in the learnt clause, so the glue never goes up.
+bool Searcher::shrink_level_to_uip(
+    const uint32_t level
+    , const size_t num_lits
+    , Lit& uip
+    , int64_t& limit
+) {
+    assert(level > 0 && level < decisionLevel());
+    size_t open = num_lits;
+    const int64_t start = trail_lim[level-1];
+    for(int64_t at = (int64_t)trail_lim[level]-1; at >= start; at--) {
+        limit--;
+        if (limit < 0) {
+            return false;
+        }
+
+        const Lit p = trail[at];
+        if (!seen[p.var()]) {
+            continue;
+        }
+        open--;
+        if (open == 0) {
+            uip = p;
+            return true;
+        }
+
+        const PropBy& reason = varData[p.var()].reason;
+        const Clause* cl = NULL;
+        size_t size;
+        switch (reason.getType()) {
+            case clause_t:
+                cl = cl_alloc.ptr(reason.get_offset());
+                size = cl->size()-1;
+                break;
+
+            case binary_t:
+                size = 1;
+                break;
+
+            default:
+                //Decision while literals are still open, cannot happen
+                return false;
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            Lit q;
+            if (cl != NULL) {
+                q = (*cl)[i+1];
+            } else {
+                q = reason.lit2();
+            }
+            const uint32_t lev = varData[q.var()].level;
+            if (seen[q.var()] || lev == 0) {
+                continue;
+            }
+            if (lev != level) {
+                return false;
+            }
+            seen[q.var()] = 2;
+            shrink_marked.push_back(q.var());
+            open++;
+        }
+    }
+
+    return false;
+}
+
+//All-UIP shrinking: every block of literals in the learnt clause that are
+//on the same, lower, decision level is replaced by that level's UIP
+void Searcher::all_uip_shrink()
+{
+    if (learnt_clause.size() <= 2
+        || learnt_clause.size() > conf.max_size_all_uip_shrink
+    ) {
+        return;
+    }
+    stats.allUIPShrinkAttempt++;
+    const size_t origSize = learnt_clause.size();
+    int64_t limit = conf.all_uip_shrink_limit;
+
+    for(const Lit lit: learnt_clause) {
+        seen[lit.var()] = 1;
+    }
+    toClear = learnt_clause;
+
+    //Make literals of the same level consecutive, highest level first
+    std::sort(learnt_clause.begin()+1, learnt_clause.end()
+        , [&](const Lit a, const Lit b) {
+            return varData[a.var()].level > varData[b.var()].level;
+        }
+    );
+
+    shrink_tmp.clear();
+    shrink_tmp.push_back(learnt_clause[0]);
+    size_t i = 1;
+    while(i < learnt_clause.size()) {
+        const uint32_t level = varData[learnt_clause[i].var()].level;
+        size_t end = i;
+        while(end < learnt_clause.size()
+            && varData[learnt_clause[end].var()].level == level
+        ) {
+            end++;
+        }
+
+        Lit uip = lit_Undef;
+        if (end - i > 1
+            && limit > 0
+            && shrink_level_to_uip(level, end - i, uip, limit)
+        ) {
+            shrink_tmp.push_back(~uip);
+            toClear.push_back(~uip);
+        } else {
+            for(size_t k = i; k < end; k++) {
+                shrink_tmp.push_back(learnt_clause[k]);
+            }
+        }
+        for(const uint32_t var: shrink_marked) {
+            seen[var] = 0;
+        }
+        shrink_marked.clear();
+        i = end;
+    }
+
+    for(const Lit lit: toClear) {
+        seen[lit.var()] = 0;
+    }
+    toClear.clear();
+
+    if (shrink_tmp.size() < origSize) {
+        learnt_clause.swap(shrink_tmp);
+        stats.allUIPShrinkCl++;
+        stats.allUIPShrinkLitRem += origSize - learnt_clause.size();
+    }
+}
+
 inline void Searcher::minimize_using_permdiff()
 {
     if (conf.doMinimRedMore
@@ -717,6 +855,9 @@ Clause* Searcher::analyze_conflict(
     Clause* last_resolved_cl = create_learnt_clause<update_bogoprops>(confl);
     stats.litsRedNonMin += learnt_clause.size();
     minimize_learnt_clause<update_bogoprops>();
+    if (conf.doAllUIPShrink) {
+        all_uip_shrink();
+    }
     stats.litsRedFinal += learnt_clause.size();
     if (learnt_clause.size() <= conf.max_size_more_minim) {
         glue = calc_glue(learnt_clause);
@@ -979,6 +1120,7 @@ lbool Searcher::search()
     }
     hist.clear();
     hist.reset_glue_hist_size(conf.shortTermHistorySize);
+    recent_learnts.clear();
 
     assert(solver->prop_at_head());
 
@@ -1105,7 +1247,7 @@ lbool Searcher::new_decision()
     while (decisionLevel() < assumptions.size()) {
         // Perform user provided assumption:
         Lit p = assumptions[decisionLevel()].lit_inter;
-        assert(varData[p.var()].removed == Removed::none);
+        assert(varFlags.removed(p.var()) == Removed::none);
 
         if (value(p) == l_True) {
             // Dummy decision level:
@@ -1217,7 +1359,7 @@ void Searcher::add_otf_subsume_long_clauses()
         const ClOffset offset = otf_subsuming_long_cls[i];
         Clause& cl = *solver->cl_alloc.ptr(offset);
         #ifdef STATS_NEEDED
-        cl.stats.conflicts_made += conf.rewardShortenedClauseWithConfl;
+        cl_alloc.extra_stats(cl).conflicts_made += conf.rewardShortenedClauseWithConfl;
         #endif
 
         //Find the l_Undef
@@ -1394,7 +1536,7 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl, bool enq)
             bumpClauseAct(cl);
 
             #ifdef STATS_NEEDED
-            cl->stats.antec_data = antec_data;
+            cl_alloc.extra_stats(*cl).antec_data = antec_data;
             propStats.propsLongRed++;
             #endif
 
@@ -1531,7 +1673,7 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
         cl->stats.glue = glue;
     }
     #ifdef STATS_NEEDED
-    cl->stats.conflicts_made += conf.rewardShortenedClauseWithConfl;
+    cl_alloc.extra_stats(*cl).conflicts_made += conf.rewardShortenedClauseWithConfl;
     #endif
 
     return cl;
@@ -1584,6 +1726,9 @@ bool Searcher::handle_conflict(const PropBy confl)
     cl = handle_last_confl_otf_subsumption(cl, glue, backtrack_level);
     assert(learnt_clause.size() <= 2 || cl != NULL);
     attach_and_enqueue_learnt_clause(cl);
+    if (!update_bogoprops) {
+        subsume_recent_learnts(cl);
+    }
 
     //Add decision-based clause
     if (!update_bogoprops
@@ -1613,6 +1758,82 @@ bool Searcher::handle_conflict(const PropBy confl)
 template bool Searcher::handle_conflict<true>(const PropBy confl);
 template bool Searcher::handle_conflict<false>(const PropBy confl);
 
+void Searcher::remove_red_cl_from_list(const Clause* cl, const ClOffset offset)
+{
+    //Recently learnt clauses are at the end of the list
+    vector<ClOffset>& cls = longRedCls[cl->stats.which_red_array];
+    for(size_t i = cls.size(); i > 0; i--) {
+        if (cls[i-1] == offset) {
+            cls.erase(cls.begin() + (i-1));
+            return;
+        }
+    }
+    assert(false && "Red clause must be in its list");
+}
+
+void Searcher::subsume_recent_learnts(Clause* cl)
+{
+    if (conf.eager_subsume_last_k == 0
+        || learnt_clause.size() < 2
+    ) {
+        return;
+    }
+
+    const cl_abst_type abst = calcAbstraction(learnt_clause);
+    for(const Lit lit: learnt_clause) {
+        seen[lit.toInt()] = 1;
+    }
+
+    size_t j = 0;
+    for(size_t i = 0; i < recent_learnts.size(); i++) {
+        const ClOffset offset = recent_learnts[i];
+        Clause* cl2 = cl_alloc.ptr(offset);
+
+        //It has been shortened into the new clause, it's added back below
+        if (cl2 == cl) {
+            continue;
+        }
+
+        cl2->recalc_abst_if_needed();
+        bool subsumed = cl2->size() >= learnt_clause.size()
+            && (abst & ~cl2->abst) == 0
+            && !cl2->used_in_xor()
+            && !clause_locked(*cl2, offset);
+        if (subsumed) {
+            uint32_t found = 0;
+            for(const Lit lit: *cl2) {
+                found += seen[lit.toInt()];
+            }
+            subsumed = (found == learnt_clause.size());
+        }
+
+        if (!subsumed) {
+            recent_learnts[j++] = offset;
+            continue;
+        }
+
+        if (conf.verbosity >= 6) {
+            cout << "Eager-subsumed learnt clause: " << *cl2 << endl;
+        }
+        stats.eagerSubsumed++;
+        solver->detachClause(*cl2);
+        remove_red_cl_from_list(cl2, offset);
+        cl_alloc.clauseFree(offset);
+    }
+    recent_learnts.resize(j);
+
+    for(const Lit lit: learnt_clause) {
+        seen[lit.toInt()] = 0;
+    }
+
+    if (cl != NULL && cl->red()) {
+        if (recent_learnts.size() >= conf.eager_subsume_last_k) {
+            recent_learnts.erase(recent_learnts.begin());
+        }
+        recent_learnts.push_back(cl_alloc.get_offset(cl));
+    }
+}
+
 void Searcher::resetStats()
 {
     startTime = cpuTime();
@@ -1820,6 +2041,7 @@ void Searcher::reduce_db_if_needed()
     }
 
     cl_alloc.consolidate(solver);
+    recent_learnts.clear();
     conf.cur_max_temp_red_cls *= conf.inc_max_temp_red_cls;
 }
 
@@ -1842,6 +2064,7 @@ bool Searcher::clean_clauses_if_needed()
         solver->clauseCleaner->remove_and_clean_all();
 
         cl_alloc.consolidate(solver);
+        recent_learnts.clear();
         rebuildOrderHeap(); //TODO only filter is needed!
         sortWatched();
         simpDB_props = (litStats.redLits + litStats.irredLits)<<5;
@@ -1854,7 +2077,7 @@ void Searcher::rebuildOrderHeap()
 {
     vec<uint32_t> vs;
     for (uint32_t v = 0; v < nVars(); v++) {
-        if (varData[v].removed == Removed::none
+        if (varFlags.removed(v) == Removed::none
             && value(v) == l_Undef
         ) {
             vs.push(v);
@@ -1947,6 +2170,15 @@ bool Searcher::must_abort(const lbool status) {
         return true;
     }
 
+    if (!solver->enforce_mem_budget()) {
+        if (conf.verbosity >= 3) {
+            cout
+            << "c search over memory budget"
+            << endl;
+        }
+        return true;
+    }
+
     return false;
 }
 
@@ -2093,21 +2325,21 @@ lbool Searcher::solve(
 void Searcher::print_solution_varreplace_status() const
 {
     for(size_t var = 0; var < nVarsOuter(); var++) {
-        if (varData[var].removed == Removed::replaced
-            || varData[var].removed == Removed::elimed
+        if (varFlags.removed(var) == Removed::replaced
+            || varFlags.removed(var) == Removed::elimed
         ) {
             assert(value(var) == l_Undef || varData[var].level == 0);
         }
 
         if (conf.verbosity >= 6
-            && varData[var].removed == Removed::replaced
+            && varFlags.removed(var) == Removed::replaced
             && value(var) != l_Undef
         ) {
             cout
             << "var: " << var
             << " value: " << value(var)
             << " level:" << varData[var].level
-            << " type: " << removed_type_to_string(varData[var].removed)
+            << " type: " << removed_type_to_string(varFlags.removed(var))
             << endl;
         }
     }
@@ -2219,7 +2451,7 @@ Lit Searcher::pickBranchLit()
             const uint32_t next_var = order_heap_glue.random_element(mtrand);
 
             if (value(next_var) == l_Undef
-                && solver->varData[next_var].removed == Removed::none
+                && solver->varFlags.removed(next_var) == Removed::none
             ) {
                 stats.decisionsRand++;
                 next = Lit(next_var, !pickPolarity(next_var));
@@ -2253,7 +2485,7 @@ Lit Searcher::pickBranchLit()
     //No vars in heap: solution found
     #ifdef SLOW_DEBUG
     if (next != lit_Undef) {
-        assert(solver->varData[next.var()].removed == Removed::none);
+        assert(solver->varFlags.removed(next.var()) == Removed::none);
     }
     #endif
     return next;
@@ -2272,17 +2504,17 @@ void Searcher::cache_based_more_minim(vector<Lit>& cl)
             break;
 
         //Already removed this literal
-        if (seen[lit.toInt()] == 0)
+        if (!more_minim_lits[lit.toInt()])
             continue;
 
         assert(solver->implCache.size() > lit.toInt());
-        const TransCache& cache1 = solver->implCache[lit];
-        limit -= (int64_t)cache1.lits.size()/2;
-        for (const LitExtra litExtra: cache1.lits) {
-            assert(seen.size() > litExtra.getLit().toInt());
-            if (seen[(~(litExtra.getLit())).toInt()]) {
+        const CacheLits cache1 = solver->implCache[lit];
+        limit -= (int64_t)cache1.size()/2;
+        for (const LitExtra litExtra: cache1) {
+            const uint32_t neg = (~(litExtra.getLit())).toInt();
+            if (more_minim_lits[neg]) {
                 stats.cacheShrinkedClause++;
-                seen[(~(litExtra.getLit())).toInt()] = 0;
+                more_minim_lits.clearBit(neg);
             }
         }
     }
@@ -2295,26 +2527,27 @@ void Searcher::binary_based_more_minim(vector<Lit>& cl)
         std::min<size_t>(conf.max_num_lits_more_red_min, cl.size());
     for (size_t at_lit = 0; at_lit < first_n_lits_of_cl; at_lit++) {
         Lit lit = cl[at_lit];
+
+        //Timeout
+        if (limit <= 0)
+            break;
+
         //Already removed this literal
-        if (seen[lit.toInt()] == 0)
+        if (!more_minim_lits[lit.toInt()])
             continue;
 
-        //Watchlist-based minimisation
+        //Watchlist-based minimisation. Binaries are at the front, the rest
+        //is of no interest. The list is charged once, after the scan
         watch_subarray_const ws = watches[lit];
-        for (const Watched* i = ws.begin() , *end = ws.end()
-            ; i != end && limit > 0
-            ; i++
-        ) {
-            limit--;
-            if (i->isBin()) {
-                if (seen[(~i->lit2()).toInt()]) {
-                    stats.binTriShrinkedClause++;
-                    seen[(~i->lit2()).toInt()] = 0;
-                }
-                continue;
+        const Watched* i = ws.begin();
+        for (const Watched* end = ws.end(); i != end && i->isBin(); i++) {
+            const uint32_t neg = (~i->lit2()).toInt();
+            if (more_minim_lits[neg]) {
+                stats.binTriShrinkedClause++;
+                more_minim_lits.clearBit(neg);
             }
-            break;
         }
+        limit -= i - ws.begin();
     }
 }
 
@@ -2325,8 +2558,11 @@ void Searcher::minimise_redundant_more(vector<Lit>& cl)
     }*/
 
     stats.furtherShrinkAttempt++;
+    if (more_minim_lits.getSize() < nVars()*2) {
+        more_minim_lits.resize(nVars()*2, false);
+    }
     for (const Lit lit: cl) {
-        seen[lit.toInt()] = 1;
+        more_minim_lits.setBit(lit.toInt());
     }
 
     if (conf.doCache && conf.more_otf_shrink_with_cache) {
@@ -2335,7 +2571,7 @@ void Searcher::minimise_redundant_more(vector<Lit>& cl)
 
     binary_based_more_minim(cl);
 
-    //Finally, remove the literals that have seen[literal] = 0
+    //Finally, remove the literals that have been unmarked
     //Here, we can count do stats, etc.
     bool changedClause  = false;
     vector<Lit>::iterator i = cl.begin();
@@ -2344,14 +2580,14 @@ void Searcher::minimise_redundant_more(vector<Lit>& cl)
     //never remove the 0th literal -- TODO this is a bad thing
     //we should be able to remove this, but I can't figure out how to
     //reorder the clause then
-    seen[cl[0].toInt()] = 1;
+    more_minim_lits.setBit(cl[0].toInt());
     for (vector<Lit>::iterator end = cl.end(); i != end; i++) {
-        if (seen[i->toInt()]) {
+        if (more_minim_lits[i->toInt()]) {
             *j++ = *i;
         } else {
             changedClause = true;
         }
-        seen[i->toInt()] = 0;
+        more_minim_lits.clearBit(i->toInt());
     }
     stats.furtherShrinkedSuccess += changedClause;
     cl.resize(cl.size() - (i-j));
@@ -2398,7 +2634,7 @@ void Searcher::stamp_based_more_minim(vector<Lit>& cl)
 
 bool Searcher::VarFilter::operator()(uint32_t var) const
 {
-    return (cc->value(var) == l_Undef && solver->varData[var].removed == Removed::none);
+    return (cc->value(var) == l_Undef && solver->varFlags.removed(var) == Removed::none);
 }
 
 uint64_t Searcher::sumConflicts() const
@@ -2890,7 +3126,7 @@ void Searcher::fill_assumptions_set_from(const vector<AssumptionPair>& fill_from
             if (value(lit) == l_Undef) {
                 std::cerr
                 << "ERROR: Lit " << lit
-                << " varData[lit.var()].removed: " << removed_type_to_string(varData[lit.var()].removed)
+                << " varFlags.removed(lit.var()): " << removed_type_to_string(varFlags.removed(lit.var()))
                 << " value: " << value(lit)
                 << " -- value should NOT be l_Undef"
                 << endl;
@@ -3010,6 +3246,9 @@ void Searcher::write_long_cls(
         if (red) {
             assert(cl.red());
             f.put_struct(cl.stats);
+            #ifdef STATS_NEEDED
+            f.put_struct(cl_alloc.extra_stats(cl));
+            #endif
         }
     }
 }
@@ -3031,16 +3270,25 @@ void Searcher::read_long_cls(
             tmp_cl.push_back(f.get_lit());
         }
         ClauseStats cl_stats;
+        #ifdef STATS_NEEDED
+        ClauseStatsExtra cl_extra;
+        #endif
         if (red) {
             f.get_struct(cl_stats);
+            #ifdef STATS_NEEDED
+            f.get_struct(cl_extra);
+            #endif
         }
 
         Clause* cl = cl_alloc.Clause_new(tmp_cl
         #ifdef STATS_NEEDED
-        , cl_stats.introduced_at_conflict
-        , cl_stats.ID
+        , cl_extra.introduced_at_conflict
+        , cl_extra.ID
         #endif
         );
+        #ifdef STATS_NEEDED
+        cl_alloc.extra_stats(*cl) = cl_extra;
+        #endif
         if (red) {
             cl->makeRed(cl_stats.glue);
         }
@@ -3173,7 +3421,7 @@ void Searcher::load_state(SimpleInFile& f, const lbool status)
 
     f.get_vector(activ_glue);
     for(size_t i = 0; i < nVars(); i++) {
-        if (varData[i].removed == Removed::none
+        if (varFlags.removed(i) == Removed::none
             && value(i) == l_Undef
         ) {
             insertVarOrder(i);
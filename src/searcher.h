@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "minisat_rnd.h"
 #include "simplefile.h"
 #include "searchstats.h"
+#include "bitarray.h"
 
 namespace CMSat {
 
@@ -264,6 +265,15 @@ class Searcher : public HyperEngine
         void update_clause_glue_from_analysis(Clause* cl);
         template<bool update_bogoprops>
         void minimize_learnt_clause();
+        void all_uip_shrink();
+        bool shrink_level_to_uip(
+            const uint32_t level
+            , const size_t num_lits
+            , Lit& uip
+            , int64_t& limit
+        );
+        vector<uint32_t> shrink_marked;
+        vector<Lit> shrink_tmp;
         void watch_based_learnt_minim();
         void minimize_using_permdiff();
         void print_fully_minimized_learnt_clause() const;
@@ -321,6 +331,11 @@ class Searcher : public HyperEngine
         void check_otf_subsume(const ClOffset offset, Clause& cl);
         void create_otf_subsuming_implicit_clause(const Clause& cl);
         void create_otf_subsuming_long_clause(Clause& cl, ClOffset offset);
+
+        //Subsumption of the last few learnt clauses by the newly learnt one
+        vector<ClOffset> recent_learnts;
+        void subsume_recent_learnts(Clause* cl);
+        void remove_red_cl_from_list(const Clause* cl, const ClOffset offset);
         template<bool update_bogoprops>
         Clause* add_literals_from_confl_to_learnt(const PropBy confl, const Lit p);
         void debug_print_resolving_clause(const PropBy confl) const;
@@ -347,6 +362,7 @@ class Searcher : public HyperEngine
         void   binary_based_more_minim(vector<Lit>& cl);
         void   cache_based_more_minim(vector<Lit>& cl);
         void   stamp_based_more_minim(vector<Lit>& cl);
+        BitArray more_minim_lits; ///<Literals of the clause being minimised, one bit each
 
         //Variable activities
         struct VarFilter { ///Filter out vars that have been set or is not decision from heap
@@ -451,7 +467,7 @@ inline void Searcher::insertVarOrder(const uint32_t x)
     ) {
         #ifdef SLOW_DEUG
         //All active varibles are decision variables
-        assert(varData[x].removed == Removed::none);
+        assert(varFlags.removed(x) == Removed::none);
         #endif
 
         order_heap_glue.insert(x);
@@ -482,13 +498,13 @@ inline bool Searcher::check_order_heap_sanity() const
 {
     for(size_t i = 0; i < nVars(); i++)
     {
-        if (varData[i].removed == Removed::none
+        if (varFlags.removed(i) == Removed::none
             && value(i) == l_Undef)
         {
             if (!order_heap_glue.inHeap(i)) {
                 cout << "ERROR var " << i+1 << " not in heap."
                 << " value: " << value(i)
-                << " removed: " << removed_type_to_string(varData[i].removed)
+                << " removed: " << removed_type_to_string(varFlags.removed(i))
                 << endl;
                 return false;
             }
@@ -512,7 +528,7 @@ inline bool Searcher::pickPolarity(const uint32_t var)
             return mtrand.randInt(1);
 
         case PolarityMode::polarmode_automatic:
-            return varData[var].polarity;
+            return varFlags.polarity(var);
 
         default:
             assert(false);
@@ -54,6 +54,9 @@ SearchStats& SearchStats::operator+=(const SearchStats& other)
     moreMinimLitsStart += other.moreMinimLitsStart;
     moreMinimLitsEnd += other.moreMinimLitsEnd;
     recMinimCost += other.recMinimCost;
+    allUIPShrinkAttempt += other.allUIPShrinkAttempt;
+    allUIPShrinkCl += other.allUIPShrinkCl;
+    allUIPShrinkLitRem += other.allUIPShrinkLitRem;
 
     //Red stats
     learntUnits += other.learntUnits;
@@ -64,6 +67,7 @@ SearchStats& SearchStats::operator+=(const SearchStats& other)
     otfSubsumedLong += other.otfSubsumedLong;
     otfSubsumedRed += other.otfSubsumedRed;
     otfSubsumedLitsGained += other.otfSubsumedLitsGained;
+    eagerSubsumed += other.eagerSubsumed;
     guess_different += other.guess_different;
     cache_hit += other.cache_hit;
     red_cl_in_which0 += other.red_cl_in_which0;
@@ -113,6 +117,9 @@ SearchStats& SearchStats::operator-=(const SearchStats& other)
     moreMinimLitsStart -= other.moreMinimLitsStart;
     moreMinimLitsEnd -= other.moreMinimLitsEnd;
     recMinimCost -= other.recMinimCost;
+    allUIPShrinkAttempt -= other.allUIPShrinkAttempt;
+    allUIPShrinkCl -= other.allUIPShrinkCl;
+    allUIPShrinkLitRem -= other.allUIPShrinkLitRem;
 
     //Red stats
     learntUnits -= other.learntUnits;
@@ -123,6 +130,7 @@ SearchStats& SearchStats::operator-=(const SearchStats& other)
     otfSubsumedLong -= other.otfSubsumedLong;
     otfSubsumedRed -= other.otfSubsumedRed;
     otfSubsumedLitsGained -= other.otfSubsumedLitsGained;
+    eagerSubsumed -= other.eagerSubsumed;
     guess_different -= other.guess_different;
     cache_hit -= other.cache_hit;
     red_cl_in_which0 -= other.red_cl_in_which0;
@@ -267,6 +275,12 @@ void SearchStats::print(uint64_t props) const
         , "lits/otf subsume"
     );
 
+    print_stats_line("c eager-subs learnt"
+        , eagerSubsumed
+        , ratio_for_stat(eagerSubsumed, conflStats.numConflicts)
+        , "/conflict"
+    );
+
     print_stats_line("c guess different"
         , guess_different
         , stats_line_percent(guess_different, conflStats.numConflicts)
@@ -354,6 +368,18 @@ void SearchStats::print(uint64_t props) const
         , "% less overall"
     );
 
+    print_stats_line("c all-uip call%"
+        , stats_line_percent(allUIPShrinkAttempt, conflStats.numConflicts)
+        , stats_line_percent(allUIPShrinkCl, allUIPShrinkAttempt)
+        , "% attempt successful"
+    );
+
+    print_stats_line("c all-uip lits"
+        , allUIPShrinkLitRem
+        , stats_line_percent(allUIPShrinkLitRem, litsRedNonMin)
+        , "% less overall"
+    );
+
     print_stats_line("c final avg"
         , ratio_for_stat(litsRedFinal, conflStats.numConflicts)
     );
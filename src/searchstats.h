@@ -72,6 +72,9 @@ public:
     uint64_t moreMinimLitsStart = 0;
     uint64_t moreMinimLitsEnd = 0;
     uint64_t recMinimCost = 0;
+    uint64_t allUIPShrinkAttempt = 0;
+    uint64_t allUIPShrinkCl = 0;
+    uint64_t allUIPShrinkLitRem = 0;
 
     //Learnt clause stats
     uint64_t learntUnits = 0;
@@ -82,6 +85,7 @@ public:
     uint64_t otfSubsumedLong = 0;
     uint64_t otfSubsumedRed = 0;
     uint64_t otfSubsumedLitsGained = 0;
+    uint64_t eagerSubsumed = 0;
     uint64_t guess_different = 0;
     uint64_t cache_hit = 0;
     uint64_t red_cl_in_which0 = 0;
@@ -0,0 +1,358 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __SMALLVEC_H__
+#define __SMALLVEC_H__
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <new>
+#include <algorithm>
+
+namespace CMSat {
+
+/**
+@brief A vec<T> that keeps up to N elements inline, inside the object itself
+
+Only once the N+1th element is pushed is memory allocated on the heap. As with
+vec<T>, T must be relocatable via memcpy/realloc. The object itself has no
+pointers into itself, so a vec<smallvec<T, N> > can still be realloc-ed.
+
+capacity() is N while the elements are inline, and larger when on the heap.
+
+The elements can also be put into memory owned by someone else, see borrow().
+This is used to lay out many lists back-to-back in one allocation. Once such
+a list outgrows its slot, it moves to its own heap memory.
+*/
+template<class T, uint32_t N>
+class smallvec {
+public:
+    smallvec() :
+        sz(0)
+        , cap(N)
+    {}
+
+    ~smallvec()
+    {
+        clear(true);
+    }
+
+    T* begin()
+    {
+        return ptr();
+    }
+    T* end()
+    {
+        return ptr() + sz;
+    }
+    const T* begin() const
+    {
+        return ptr();
+    }
+    const T* end() const
+    {
+        return ptr() + sz;
+    }
+
+    uint32_t size() const
+    {
+        return sz;
+    }
+
+    bool empty() const
+    {
+        return sz == 0;
+    }
+
+    uint32_t capacity() const
+    {
+        return cap & ~borrowed_flag;
+    }
+
+    bool is_inline() const
+    {
+        return cap <= N;
+    }
+
+    bool is_borrowed() const
+    {
+        return cap & borrowed_flag;
+    }
+
+    ///Bytes allocated on the heap by us (i.e. not counting the object itself,
+    ///nor borrowed memory)
+    size_t mem_used_heap() const
+    {
+        return (is_inline() || is_borrowed()) ? 0 : (size_t)cap*sizeof(T);
+    }
+
+    ///Move the elements to "mem", which can hold "n" elements, is not freed
+    ///by us, and must outlive the borrowing (see unborrow())
+    void borrow(T* mem, uint32_t n)
+    {
+        assert(n >= sz && n > N);
+        assert(n < borrowed_flag);
+        memcpy(mem, ptr(), sz*sizeof(T));
+        clear_heap();
+        heap = mem;
+        cap = n | borrowed_flag;
+    }
+
+    ///Move the elements out of borrowed memory, into memory of our own
+    void unborrow()
+    {
+        if (!is_borrowed()) {
+            return;
+        }
+
+        T* mem = heap;
+        if (sz <= N) {
+            memcpy(store, mem, sz*sizeof(T));
+            cap = N;
+            return;
+        }
+
+        T* data2 = (T*)malloc(sz*sizeof(T));
+        if (data2 == NULL) {
+            throw std::bad_alloc();
+        }
+        memcpy(data2, mem, sz*sizeof(T));
+        heap = data2;
+        cap = sz;
+    }
+
+    void capacity(int32_t min_cap);
+
+    void shrink(uint32_t nelems)
+    {
+        assert(nelems <= sz);
+        T* d = ptr();
+        for (uint32_t i = 0; i < nelems; i++) {
+            sz--, d[sz].~T();
+        }
+    }
+
+    void shrink_(uint32_t nelems)
+    {
+        assert(nelems <= sz);
+        sz -= nelems;
+    }
+
+    void growTo(uint32_t size)
+    {
+        if (sz >= size) {
+            return;
+        }
+        capacity(size);
+        T* d = ptr();
+        for (uint32_t i = sz; i < size; i++) {
+            new (&d[i]) T();
+        }
+        sz = size;
+    }
+
+    void resize(uint32_t s)
+    {
+        if (s < sz) {
+            shrink(sz - s);
+        } else {
+            growTo(s);
+        }
+    }
+
+    void clear(bool dealloc = false)
+    {
+        shrink(sz);
+        if (dealloc) {
+            clear_heap();
+        }
+    }
+
+    void push()
+    {
+        if (sz == capacity()) {
+            capacity(sz + 1);
+        }
+        new (&ptr()[sz]) T();
+        sz++;
+    }
+
+    void push(const T& elem)
+    {
+        if (sz == capacity()) {
+            capacity(sz + 1);
+        }
+        ptr()[sz++] = elem;
+    }
+
+    void push_(const T& elem)
+    {
+        assert(sz < capacity());
+        ptr()[sz++] = elem;
+    }
+
+    void pop()
+    {
+        assert(sz > 0);
+        sz--, ptr()[sz].~T();
+    }
+
+    const T& last() const
+    {
+        return ptr()[sz - 1];
+    }
+    T& last()
+    {
+        return ptr()[sz - 1];
+    }
+
+    const T& operator[](uint32_t index) const
+    {
+        return ptr()[index];
+    }
+    T& operator[](uint32_t index)
+    {
+        return ptr()[index];
+    }
+
+    void copyTo(smallvec<T, N>& copy) const
+    {
+        copy.clear();
+        copy.growTo(sz);
+        std::copy(begin(), end(), copy.begin());
+    }
+
+    void moveTo(smallvec<T, N>& dest)
+    {
+        dest.clear(true);
+        swap(dest);
+    }
+
+    void swap(smallvec<T, N>& other)
+    {
+        std::swap_ranges(store, store + sizeof(store), other.store);
+        std::swap(sz, other.sz);
+        std::swap(cap, other.cap);
+    }
+
+    ///Frees the heap memory, moving the elements back inline if they fit
+    void shrink_to_fit()
+    {
+        if (is_inline() || is_borrowed() || sz == cap) {
+            return;
+        }
+
+        if (sz <= N) {
+            T* h = heap;
+            memcpy(store, h, sz*sizeof(T));
+            free(h);
+            cap = N;
+            return;
+        }
+
+        T* data2 = (T*)realloc(heap, sz*sizeof(T));
+        if (data2 == NULL) {
+            //We just keep the size then
+            return;
+        }
+        heap = data2;
+        cap = sz;
+    }
+
+private:
+    //Don't allow copying (error prone)
+    smallvec(const smallvec<T, N>&);
+    smallvec<T, N>& operator=(const smallvec<T, N>&);
+
+    static const uint32_t borrowed_flag = 1U << 31;
+
+    //Frees own heap memory and goes back to inline. Only call when
+    //the elements have been destroyed or moved away
+    void clear_heap()
+    {
+        if (!is_inline() && !is_borrowed()) {
+            free(heap);
+        }
+        cap = N;
+    }
+
+    T* ptr()
+    {
+        return is_inline() ? reinterpret_cast<T*>(store) : heap;
+    }
+    const T* ptr() const
+    {
+        return is_inline() ? reinterpret_cast<const T*>(store) : heap;
+    }
+
+    union {
+        T* heap;
+        alignas(T) char store[N*sizeof(T) > sizeof(T*) ? N*sizeof(T) : sizeof(T*)];
+    };
+    uint32_t sz;
+    uint32_t cap;
+};
+
+template<class T, uint32_t N>
+void smallvec<T, N>::capacity(int32_t min_cap)
+{
+    const uint32_t old_cap = capacity();
+    if ((int32_t)old_cap >= min_cap) {
+        return;
+    }
+
+    //Grow by approximately 3/2, as vec<T> does
+    uint32_t add = std::max<uint32_t>((min_cap - old_cap + 1) & ~1, ((old_cap >> 1) + 2) & ~1);
+    if (add >= borrowed_flag - old_cap) {
+        throw std::bad_alloc();
+    }
+    const uint32_t new_cap = old_cap + add;
+
+    T* data2;
+    if (is_borrowed()) {
+        //Outgrew the borrowed slot, which stays with its owner
+        data2 = (T*)malloc(new_cap*sizeof(T));
+        if (data2 != NULL) {
+            memcpy(data2, heap, sz*sizeof(T));
+        }
+    } else if (is_inline()) {
+        data2 = (T*)malloc(new_cap*sizeof(T));
+        if (data2 != NULL) {
+            memcpy(data2, store, sz*sizeof(T));
+        }
+    } else {
+        data2 = (T*)realloc(heap, new_cap*sizeof(T));
+    }
+    if (data2 == NULL) {
+        throw std::bad_alloc();
+    }
+    heap = data2;
+    cap = new_cap;
+}
+
+} //End of namespace
+
+#endif //__SMALLVEC_H__
@@ -84,7 +84,7 @@ void SolutionExtender::dummyBlocked(const Lit blockedOn)
     #endif
 
     const uint32_t blockedOn_inter = solver->map_outer_to_inter(blockedOn.var());
-    assert(solver->varData[blockedOn_inter].removed == Removed::elimed);
+    assert(solver->varFlags.removed(blockedOn_inter) == Removed::elimed);
 
     //Blocked clauses set its value already
     if (solver->model_value(blockedOn) != l_Undef)
@@ -110,39 +110,11 @@ void SolutionExtender::addClause(const vector<Lit>& lits, const Lit blockedOn)
 {
     #ifdef SLOW_DEBUG
     const uint32_t blocked_on_inter = solver->map_outer_to_inter(blockedOn.var());
-    assert(solver->varData[blocked_on_inter].removed == Removed::elimed);
+    assert(solver->varFlags.removed(blocked_on_inter) == Removed::elimed);
     assert(contains_lit(lits, blockedOn));
     #endif
-    if (satisfied(lits)) {
+    if (satisfied(lits) || satisfy_with_unset_var(lits)) {
         return;
-    } else {
-        //Note: we need to do this even if solver->conf.greedy_undef is FALSE
-        //because the solution we are given (when used as a preprocessor)
-        //may not be full
-
-        //Try to extend through setting variables that have been blocked but
-        //were not required to be set until now
-        for(Lit l: lits) {
-            if (solver->model_value(l) == l_Undef
-                && var_has_been_blocked[l.var()]
-            ) {
-                solver->model[l.var()] = l.sign() ? l_False : l_True;
-                solver->varReplacer->extend_model(l.var());
-                return;
-            }
-        }
-
-        //Try to set var that hasn't been set
-        for(Lit l: lits) {
-            uint32_t v_inter = solver->map_outer_to_inter(l.var());
-            if (solver->model_value(l) == l_Undef
-                && solver->varData[v_inter].removed == Removed::none
-            ) {
-                solver->model[l.var()] = l.sign() ? l_False : l_True;
-                solver->varReplacer->extend_model(l.var());
-                return;
-            }
-        }
     }
 
     #ifdef VERBOSE_DEBUG_SOLUTIONEXTENDER
@@ -150,7 +122,7 @@ void SolutionExtender::addClause(const vector<Lit>& lits, const Lit blockedOn)
         Lit lit_inter = solver->map_outer_to_inter(lit);
         cout
         << lit << ": " << solver->model_value(lit)
-        << "(elim: " << removed_type_to_string(solver->varData[lit_inter.var()].removed) << ")"
+        << "(elim: " << removed_type_to_string(solver->varFlags.removed(lit_inter.var())) << ")"
         << ", ";
     }
     cout << "blocked on: " <<  blockedOn << endl;
@@ -166,7 +138,7 @@ void SolutionExtender::addClause(const vector<Lit>& lits, const Lit blockedOn)
         for(Lit l: lits) {
             uint32_t v_inter = solver->map_outer_to_inter(l.var());
             cout << "Value of " << l << " : " << solver-> model_value(l)
-            << " removed: " << removed_type_to_string(solver->varData[v_inter].removed)
+            << " removed: " << removed_type_to_string(solver->varFlags.removed(v_inter))
             << endl;
         }
     }
@@ -181,6 +153,62 @@ void SolutionExtender::addClause(const vector<Lit>& lits, const Lit blockedOn)
     assert(satisfied(lits));
 }
 
+//The clause was removed by BCE/CCE, so blockedOn's variable is not
+//eliminated and may already be set. Flipping it satisfies the clause
+//without falsifying any clause that was present when it got removed.
+//If it is a representative, the variables it replaces are flipped with it
+void SolutionExtender::addBlockedClause(const vector<Lit>& lits, const Lit blockedOn)
+{
+    #ifdef SLOW_DEBUG
+    assert(contains_lit(lits, blockedOn));
+    #endif
+    if (satisfied(lits) || satisfy_with_unset_var(lits)) {
+        return;
+    }
+
+    if (solver->conf.verbosity >= 10) {
+        cout << "Extending BCE cls. -- flipping model for var "
+        << blockedOn.unsign() << " from " << solver->model_value(blockedOn.var()) << endl;
+    }
+    solver->model[blockedOn.var()] = blockedOn.sign() ? l_False : l_True;
+    solver->varReplacer->extend_model(blockedOn.var(), true);
+
+    assert(satisfied(lits));
+}
+
+bool SolutionExtender::satisfy_with_unset_var(const vector<Lit>& lits)
+{
+    //Note: we need to do this even if solver->conf.greedy_undef is FALSE
+    //because the solution we are given (when used as a preprocessor)
+    //may not be full
+
+    //Try to extend through setting variables that have been blocked but
+    //were not required to be set until now
+    for(Lit l: lits) {
+        if (solver->model_value(l) == l_Undef
+            && var_has_been_blocked[l.var()]
+        ) {
+            solver->model[l.var()] = l.sign() ? l_False : l_True;
+            solver->varReplacer->extend_model(l.var());
+            return true;
+        }
+    }
+
+    //Try to set var that hasn't been set
+    for(Lit l: lits) {
+        uint32_t v_inter = solver->map_outer_to_inter(l.var());
+        if (solver->model_value(l) == l_Undef
+            && solver->varFlags.removed(v_inter) == Removed::none
+        ) {
+            solver->model[l.var()] = l.sign() ? l_False : l_True;
+            solver->varReplacer->extend_model(l.var());
+            return true;
+        }
+    }
+
+    return false;
+}
+
 size_t SolutionExtender::count_num_unset_model() const
 {
     size_t num_unset = 0;
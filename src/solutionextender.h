@@ -42,6 +42,7 @@ class SolutionExtender
         SolutionExtender(Solver* _solver, OccSimplifier* simplifier);
         void extend();
         void addClause(const vector<Lit>& lits, const Lit blockedOn);
+        void addBlockedClause(const vector<Lit>& lits, const Lit blockedOn);
         void dummyBlocked(const Lit blockedOn);
 
     private:
@@ -50,6 +51,7 @@ class SolutionExtender
 
         size_t count_num_unset_model() const;
         bool satisfied(const vector<Lit>& lits) const;
+        bool satisfy_with_unset_var(const vector<Lit>& lits);
         bool contains_lit(
             const vector<Lit>& lits
             , const Lit tocontain
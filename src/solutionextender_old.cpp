@@ -86,7 +86,7 @@ void SolutionExtender::extend()
     for (uint32_t var = 0; var < nVarsOuter(); var++) {
         if (value(var) == l_Undef
             //Don't pick replaced variables
-            && solver->varData[var].removed != Removed::replaced
+            && solver->varFlags.removed(var) != Removed::replaced
         ) {
             Lit toEnqueue = Lit(var, false);
             #ifdef VERBOSE_DEBUG_RECONSTRUCT
@@ -337,7 +337,7 @@ bool SolutionExtender::propagateCl(
 
     assert(
         (solver->varData[blockedOn.var()].level != 0
-            //|| solver->varData[blockedOn.var()].removed == Removed::decomposed
+            //|| solver->varFlags.removed(blockedOn.var()) == Removed::decomposed
         )
         && "We cannot flip 0-level vars"
     );
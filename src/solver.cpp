@@ -39,6 +39,9 @@ THE SOFTWARE.
 #include "occsimplifier.h"
 #include "prober.h"
 #include "distillerallwithall.h"
+#include "sweeper.h"
+#include "transred.h"
+#include "stampsweeper.h"
 #include "clausecleaner.h"
 #include "solutionextender.h"
 #include "varupdatehelper.h"
@@ -98,6 +101,9 @@ Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter
     }
     distill_all_with_all = new DistillerAllWithAll(this);
     dist_long_with_impl = new DistillerLongWithImpl(this);
+    sweeper = new Sweeper(this);
+    trans_red = new TransRed(this);
+    stamp_sweeper = new StampSweeper(this);
     dist_impl_with_impl = new StrImplWImplStamp(this);
     clauseCleaner = new ClauseCleaner(this);
     varReplacer = new VarReplacer(this);
@@ -123,6 +129,9 @@ Solver::~Solver()
     delete occsimplifier;
     delete distill_all_with_all;
     delete dist_long_with_impl;
+    delete sweeper;
+    delete trans_red;
+    delete stamp_sweeper;
     delete dist_impl_with_impl;
     delete clauseCleaner;
     delete varReplacer;
@@ -194,7 +203,7 @@ bool Solver::add_xor_clause_inter(
             //Add and remember as last one to have been added
             ps[j++] = p = ps[i];
 
-            assert(varData[p.var()].removed != Removed::elimed);
+            assert(varFlags.removed(p.var()) != Removed::elimed);
         } else {
             //modify rhs instead of adding
             rhs ^= value(ps[i]) == l_True;
@@ -340,10 +349,10 @@ bool Solver::sort_and_clean_clause(
         } else if (value(ps[i]) != l_False && ps[i] != p) {
             ps[j++] = p = ps[i];
 
-            if (varData[p.var()].removed != Removed::none) {
+            if (varFlags.removed(p.var()) != Removed::none) {
                 cout << "ERROR: clause " << origCl << " contains literal "
                 << p << " whose variable has been removed (removal type: "
-                << removed_type_to_string(varData[p.var()].removed)
+                << removed_type_to_string(varFlags.removed(p.var()))
                 << " var-updated lit: "
                 << varReplacer->get_var_replaced_with(p)
                 << ")"
@@ -352,7 +361,7 @@ bool Solver::sort_and_clean_clause(
 
             //Variables that have been eliminated cannot be added internally
             //as part of a clause. That's a bug
-            assert(varData[p.var()].removed == Removed::none);
+            assert(varFlags.removed(p.var()) == Removed::none);
         }
     }
     ps.resize(ps.size() - (i - j));
@@ -383,11 +392,6 @@ Clause* Solver::add_clause_int(
     cout << "add_clause_int clause " << lits << endl;
     #endif //VERBOSE_DEBUG
 
-    //Make stats sane
-    #ifdef STATS_NEEDED
-    stats.introduced_at_conflict = std::min<uint64_t>(Searcher::sumConflicts(), stats.introduced_at_conflict);
-    #endif
-
     vector<Lit> ps = lits;
     if (!sort_and_clean_clause(ps, lits, red)) {
         return NULL;
@@ -512,6 +516,9 @@ void Solver::attach_bin_clause(
         binTri.irredBins++;
     }
     binTri.numNewBinsSinceSCC++;
+    binTri.numNewBinsSinceStamp++;
+    varReplacer->get_scc_finder()->mark_dirty(lit1.var());
+    varReplacer->get_scc_finder()->mark_dirty(lit2.var());
 
     //Call Solver's function for heavy-lifting
     PropEngine::attach_bin_clause(lit1, lit2, red, checkUnassignedFirst);
@@ -611,7 +618,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     if (compHandler) {
         bool readd = false;
         for (Lit lit: ps) {
-            if (varData[lit.var()].removed == Removed::decomposed) {
+            if (varFlags.removed(lit.var()) == Removed::decomposed) {
                 readd = true;
                 break;
             }
@@ -625,7 +632,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     //Uneliminate vars
     for (const Lit lit: ps) {
         if (conf.perform_occur_based_simp
-            && varData[lit.var()].removed == Removed::elimed
+            && varFlags.removed(lit.var()) == Removed::elimed
         ) {
             #ifdef VERBOSE_DEBUG_RECONSTRUCT
             cout << "Uneliminating var " << lit.var() + 1 << endl;
@@ -635,6 +642,13 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
         }
     }
 
+    //Put back clauses blocked on these vars
+    if (conf.perform_occur_based_simp
+        && !occsimplifier->readd_blocked_clauses_on(ps)
+    ) {
+        return false;
+    }
+
     #ifdef SLOW_DEBUG
     //Check
     for (Lit& lit: ps) {
@@ -648,14 +662,6 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
 
 bool Solver::addClause(const vector<Lit>& lits, bool red)
 {
-    if (conf.perform_occur_based_simp && occsimplifier->getAnythingHasBeenBlocked()) {
-        std::cerr
-        << "ERROR: Cannot add new clauses to the system if blocking was"
-        << " enabled. Turn it off from conf.doBlockClauses"
-        << endl;
-        std::exit(-1);
-    }
-
     #ifdef VERBOSE_DEBUG
     cout << "Adding clause " << lits << endl;
     #endif //VERBOSE_DEBUG
@@ -725,9 +731,9 @@ void Solver::test_renumbering() const
         if (value(i)  != l_Undef)
             uninteresting = true;
 
-        if (varData[i].removed == Removed::elimed
-            || varData[i].removed == Removed::replaced
-            || varData[i].removed == Removed::decomposed
+        if (varFlags.removed(i) == Removed::elimed
+            || varFlags.removed(i) == Removed::replaced
+            || varFlags.removed(i) == Removed::decomposed
         ) {
             uninteresting = true;
             //cout << " removed" << endl;
@@ -736,9 +742,9 @@ void Solver::test_renumbering() const
         }
 
         if (value(i) == l_Undef
-            && varData[i].removed != Removed::elimed
-            && varData[i].removed != Removed::replaced
-            && varData[i].removed != Removed::decomposed
+            && varFlags.removed(i) != Removed::elimed
+            && varFlags.removed(i) != Removed::replaced
+            && varFlags.removed(i) != Removed::decomposed
             && uninteresting
         ) {
             problem = true;
@@ -784,9 +790,9 @@ size_t Solver::calculate_interToOuter_and_outerToInter(
     size_t numEffectiveVars = 0;
     for(size_t i = 0; i < nVars(); i++) {
         if (value(i) != l_Undef
-            || varData[i].removed == Removed::elimed
-            || varData[i].removed == Removed::replaced
-            || varData[i].removed == Removed::decomposed
+            || varFlags.removed(i) == Removed::elimed
+            || varFlags.removed(i) == Removed::replaced
+            || varFlags.removed(i) == Removed::decomposed
         ) {
             useless.push_back(i);
             continue;
@@ -824,9 +830,9 @@ double Solver::calc_renumber_saving()
     uint32_t num_used = 0;
     for(size_t i = 0; i < nVars(); i++) {
         if (value(i) != l_Undef
-            || varData[i].removed == Removed::elimed
-            || varData[i].removed == Removed::replaced
-            || varData[i].removed == Removed::decomposed
+            || varFlags.removed(i) == Removed::elimed
+            || varFlags.removed(i) == Removed::replaced
+            || varFlags.removed(i) == Removed::decomposed
         ) {
             continue;
         }
@@ -1242,6 +1248,7 @@ lbool Solver::solve()
     solveStats.num_solve_calls++;
     conflict.clear();
     check_config_parameters();
+    over_mem_budget = false;
 
     //Parameters for restarts
     max_confl_phase = conf.restart_first;
@@ -1477,6 +1484,7 @@ lbool Solver::iterate_until_solved()
         && !must_interrupt_asap()
         && cpuTime() < conf.maxTime
         && sumSearchStats.conflStats.numConflicts < (uint64_t)conf.maxConfl
+        && !over_mem_budget
     ) {
         iteration_num++;
         if (conf.verbosity && iteration_num >= 2) {
@@ -1524,6 +1532,7 @@ lbool Solver::iterate_until_solved()
         if (sumSearchStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
             || cpuTime() > conf.maxTime
             || must_interrupt_asap()
+            || over_mem_budget
         ) {
             break;
         }
@@ -1596,6 +1605,7 @@ bool Solver::execute_inprocess_strategy(
         if (sumSearchStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
             || cpuTime() > conf.maxTime
             || must_interrupt_asap()
+            || !enforce_mem_budget()
             || nVars() == 0
             || !ok
         ) {
@@ -1693,6 +1703,27 @@ bool Solver::execute_inprocess_strategy(
             if (conf.do_distill_clauses) {
                 distill_all_with_all->distill(conf.distill_queue_by);
             }
+        } else if (token == "distill-red-cls") {
+            //Same as above, but for the learnt clauses. Also removes the ones
+            //that the rest of the clauses propagate anyway
+            if (conf.do_distill_clauses && conf.do_distill_red_clauses) {
+                distill_all_with_all->distill_red(conf.distill_queue_by);
+            }
+        } else if (token == "sweep") {
+            //Finds equivalent literals with random simulation of gates
+            if (conf.do_sweep) {
+                sweeper->sweep();
+            }
+        } else if (token == "trans-red") {
+            //Removes binaries that other binaries imply
+            if (conf.doTransRed) {
+                trans_red->reduce();
+            }
+        } else if (token == "stamp-sweep") {
+            //Removes and strengthens all long clauses with the stamps
+            if (conf.doStamp && conf.do_stamp_sweep) {
+                stamp_sweeper->sweep();
+            }
         } else if (token == "str-impl") {
             //Strengthens BIN&TRI with BIN&TRI
             if (conf.doStrSubImplicit) {
@@ -1972,6 +2003,21 @@ void Solver::print_min_stats(const double cpu_time) const
                     , stats_line_percent(distill_all_with_all->get_stats().time_used, cpu_time)
                     , "% time"
     );
+    print_stats_line("c sweep time"
+                    , sweeper->get_stats().cpu_time
+                    , stats_line_percent(sweeper->get_stats().cpu_time, cpu_time)
+                    , "% time"
+    );
+    print_stats_line("c trans-red time"
+                    , trans_red->get_stats().cpu_time
+                    , stats_line_percent(trans_red->get_stats().cpu_time, cpu_time)
+                    , "% time"
+    );
+    print_stats_line("c stamp-sweep time"
+                    , stamp_sweeper->get_stats().cpu_time
+                    , stats_line_percent(stamp_sweeper->get_stats().cpu_time, cpu_time)
+                    , "% time"
+    );
     print_stats_line("c strength cache-irred time"
                     , dist_long_with_impl->get_stats().irredCacheBased.cpu_time
                     , stats_line_percent(dist_long_with_impl->get_stats().irredCacheBased.cpu_time, cpu_time)
@@ -2062,6 +2108,21 @@ void Solver::print_norm_stats(const double cpu_time) const
                     , stats_line_percent(distill_all_with_all->get_stats().time_used, cpu_time)
                     , "% time"
     );
+    print_stats_line("c sweep time"
+                    , sweeper->get_stats().cpu_time
+                    , stats_line_percent(sweeper->get_stats().cpu_time, cpu_time)
+                    , "% time"
+    );
+    print_stats_line("c trans-red time"
+                    , trans_red->get_stats().cpu_time
+                    , stats_line_percent(trans_red->get_stats().cpu_time, cpu_time)
+                    , "% time"
+    );
+    print_stats_line("c stamp-sweep time"
+                    , stamp_sweeper->get_stats().cpu_time
+                    , stats_line_percent(stamp_sweeper->get_stats().cpu_time, cpu_time)
+                    , "% time"
+    );
     print_stats_line("c strength cache-irred time"
                     , dist_long_with_impl->get_stats().irredCacheBased.cpu_time
                     , stats_line_percent(dist_long_with_impl->get_stats().irredCacheBased.cpu_time, cpu_time)
@@ -2162,6 +2223,27 @@ void Solver::print_full_restart_stat(const double cpu_time) const
                     , "% time");
     distill_all_with_all->get_stats().print(nVars());
 
+    //Sweeper stats
+    print_stats_line("c sweep time"
+                    , sweeper->get_stats().cpu_time
+                    , stats_line_percent(sweeper->get_stats().cpu_time, cpu_time)
+                    , "% time");
+    sweeper->get_stats().print();
+
+    //Transitive reduction stats
+    print_stats_line("c trans-red time"
+                    , trans_red->get_stats().cpu_time
+                    , stats_line_percent(trans_red->get_stats().cpu_time, cpu_time)
+                    , "% time");
+    trans_red->get_stats().print();
+
+    //Stamp sweep stats
+    print_stats_line("c stamp-sweep time"
+                    , stamp_sweeper->get_stats().cpu_time
+                    , stats_line_percent(stamp_sweeper->get_stats().cpu_time, cpu_time)
+                    , "% time");
+    stamp_sweeper->get_stats().print();
+
     print_stats_line("c strength cache-irred time"
                     , dist_long_with_impl->get_stats().irredCacheBased.cpu_time
                     , stats_line_percent(dist_long_with_impl->get_stats().irredCacheBased.cpu_time, cpu_time)
@@ -2225,6 +2307,7 @@ uint64_t Solver::mem_used_vardata() const
     uint64_t mem = 0;
     mem += assigns.capacity()*sizeof(lbool);
     mem += varData.capacity()*sizeof(VarData);
+    mem += varFlags.mem_used();
 
     return mem;
 }
@@ -2365,6 +2448,187 @@ void Solver::print_mem_stats() const
     );
 }
 
+///Same parts as in print_mem_stats(), without reading the RSS. Walking the
+///watch lists is O(#literals), so unless 'recount_watches' is set, their
+///memory is taken from the last recount
+uint64_t Solver::mem_used_accounted(const bool recount_watches)
+{
+    if (recount_watches) {
+        watch_mem_counted = watches.mem_used_alloc();
+    }
+
+    uint64_t mem = 0;
+    mem += mem_used_longclauses();
+    mem += watch_mem_counted;
+    mem += watches.mem_used_array();
+    mem += mem_used_vardata();
+    mem += implCache.mem_used();
+    mem += mem_used_stamp();
+    mem += mem_used();
+    mem += CNF::mem_used_renumberer();
+    if (compHandler) {
+        mem += compHandler->mem_used();
+    }
+    if (occsimplifier) {
+        mem += occsimplifier->mem_used();
+        mem += occsimplifier->mem_used_xor();
+    }
+    mem += varReplacer->mem_used();
+    if (subsumeImplicit) {
+        mem += subsumeImplicit->mem_used();
+    }
+    mem += distill_all_with_all->mem_used();
+    mem += dist_long_with_impl->mem_used();
+    mem += dist_impl_with_impl->mem_used();
+    mem += sweeper->mem_used();
+    mem += trans_red->mem_used();
+    mem += stamp_sweeper->mem_used();
+    if (prober) {
+        mem += prober->mem_used() + intree->mem_used();
+    }
+
+    return mem;
+}
+
+/**
+@brief Frees up memory in escalating steps when close to the memory budget
+
+The steps are: cleaning the redundant clause database, freeing and turning
+off the implication cache, tightening the occurrence-based simplification
+limits and finally consolidating the clause memory. Returns FALSE if the budget
+is still exceeded after all steps. Solving then stops and returns l_Undef.
+
+Once memory use drops well below the budget, the steps that turned something
+off are undone, one per call, latest first.
+
+The watch lists are only recounted every 16th call, or when the estimate is
+over the limit, as walking them is O(#literals).
+*/
+bool Solver::enforce_mem_budget()
+{
+    if (over_mem_budget) {
+        return false;
+    }
+    if (conf.maxMemMB == std::numeric_limits<uint64_t>::max()) {
+        return true;
+    }
+
+    const uint64_t limit = conf.maxMemMB*1024ULL*1024ULL;
+    const uint64_t soft_limit = (double)limit*conf.mem_budget_soft_ratio;
+    const uint64_t undo_limit = (double)limit*conf.mem_budget_undo_ratio;
+    mem_budget_checks++;
+    uint64_t mem = mem_used_accounted(mem_budget_checks % 16 == 1);
+    if (mem > soft_limit) {
+        mem = mem_used_accounted(true);
+    }
+
+    if (mem < undo_limit
+        && (mem_budget_freed_cache || mem_budget_tightened_occ)
+    ) {
+        undo_mem_budget_step();
+        return true;
+    }
+
+    for(unsigned step = 0; step < 4 && mem > soft_limit; step++) {
+        const uint64_t mem_before = mem;
+        string name;
+        switch(step) {
+            case 0:
+                if (longRedCls[1].empty()) {
+                    continue;
+                }
+                name = "clean redundant clauses";
+                reduceDB->reduce_db_and_update_reset_stats();
+                break;
+
+            case 1:
+                if (!conf.doCache) {
+                    continue;
+                }
+                name = "free implication cache";
+                implCache.free();
+                conf.doCache = false;
+                mem_budget_freed_cache = true;
+                break;
+
+            case 2:
+                if (conf.maxOccurIrredMB <= 1 && conf.maxOccurRedMB <= 1) {
+                    continue;
+                }
+                name = "tighten occur limits";
+                if (!mem_budget_tightened_occ) {
+                    orig_maxOccurIrredMB = conf.maxOccurIrredMB;
+                    orig_maxOccurRedMB = conf.maxOccurRedMB;
+                    orig_maxOccurRedLitLinkedM = conf.maxOccurRedLitLinkedM;
+                    mem_budget_tightened_occ = true;
+                }
+                conf.maxOccurIrredMB = std::max(conf.maxOccurIrredMB/2, 1U);
+                conf.maxOccurRedMB = std::max(conf.maxOccurRedMB/2, 1U);
+                conf.maxOccurRedLitLinkedM = std::max(conf.maxOccurRedLitLinkedM/2, 1ULL);
+                break;
+
+            case 3:
+                name = "consolidate";
+                cl_alloc.consolidate(this, true);
+                watches.consolidate();
+                break;
+        }
+        mem = mem_used_accounted(true);
+
+        if (conf.verbosity) {
+            cout
+            << "c [mem-budget] " << name
+            << " mem before: " << mem_before/1024ULL << " KB"
+            << " after: " << mem/1024ULL << " KB"
+            << " budget: " << conf.maxMemMB << " MB"
+            << endl;
+        }
+    }
+
+    if (mem > limit) {
+        if (conf.verbosity) {
+            cout
+            << "c [mem-budget] still over budget after freeing memory, stopping"
+            << endl;
+        }
+        over_mem_budget = true;
+        return false;
+    }
+
+    return true;
+}
+
+void Solver::undo_mem_budget_step()
+{
+    string name;
+    if (mem_budget_tightened_occ) {
+        name = "restore occur limits";
+        conf.maxOccurIrredMB = orig_maxOccurIrredMB;
+        conf.maxOccurRedMB = orig_maxOccurRedMB;
+        conf.maxOccurRedLitLinkedM = orig_maxOccurRedLitLinkedM;
+        mem_budget_tightened_occ = false;
+    } else {
+        assert(mem_budget_freed_cache);
+        mem_budget_freed_cache = false;
+
+        //new_vars() would have turned it off by now
+        if (nVars() > 5ULL*1000ULL*1000ULL) {
+            return;
+        }
+        name = "turn implication cache back on";
+        assert(implCache.size() == 0);
+        implCache.new_vars(nVars());
+        conf.doCache = true;
+    }
+
+    if (conf.verbosity) {
+        cout
+        << "c [mem-budget] " << name
+        << " budget: " << conf.maxMemMB << " MB"
+        << endl;
+    }
+}
+
 void Solver::print_clause_size_distrib()
 {
     size_t size3 = 0;
@@ -2417,14 +2681,14 @@ vector<Lit> Solver::get_zero_assigned_lits() const
 
             //Update to higher-up
             lit = varReplacer->get_lit_replaced_with(lit);
-            if (varData[lit.var()].is_bva == false) {
+            if (varFlags.is_bva(lit.var()) == false) {
                 lits.push_back(map_inter_to_outer(lit));
             }
 
             //Everything it repaces has also been set
             const vector<uint32_t> vars = varReplacer->get_vars_replacing(lit.var());
             for(const uint32_t var: vars) {
-                if (varData[var].is_bva)
+                if (varFlags.is_bva(var))
                     continue;
 
                 Lit tmp_lit = Lit(var, false);
@@ -2704,9 +2968,9 @@ void Solver::free_unused_watches()
         ; ++it, wsLit++
     ) {
         Lit lit = Lit::toLit(wsLit);
-        if (varData[lit.var()].removed == Removed::elimed
-            || varData[lit.var()].removed == Removed::replaced
-            || varData[lit.var()].removed == Removed::decomposed
+        if (varFlags.removed(lit.var()) == Removed::elimed
+            || varFlags.removed(lit.var()) == Removed::replaced
+            || varFlags.removed(lit.var()) == Removed::decomposed
         ) {
             watch_subarray ws = *it;
             assert(ws.empty());
@@ -2734,7 +2998,7 @@ bool Solver::fully_enqueue_this(const Lit lit)
 {
     const lbool val = value(lit);
     if (val == l_Undef) {
-        assert(varData[lit.var()].removed == Removed::none);
+        assert(varFlags.removed(lit.var()) == Removed::none);
         enqueue(lit);
         ok = propagate<true>().isNULL();
 
@@ -2901,18 +3165,18 @@ uint32_t Solver::num_active_vars() const
     uint32_t removed_non_decision = 0;
     for(uint32_t var = 0; var < nVarsOuter(); var++) {
         if (value(var) != l_Undef) {
-            if (varData[var].removed != Removed::none)
+            if (varFlags.removed(var) != Removed::none)
             {
                 cout << "ERROR: var " << var + 1 << " has removed: "
-                << removed_type_to_string(varData[var].removed)
+                << removed_type_to_string(varFlags.removed(var))
                 << " but is set to " << value(var) << endl;
-                assert(varData[var].removed == Removed::none);
+                assert(varFlags.removed(var) == Removed::none);
                 exit(-1);
             }
             removed_set++;
             continue;
         }
-        switch(varData[var].removed) {
+        switch(varFlags.removed(var)) {
             case Removed::decomposed :
                 removed_decomposed++;
                 continue;
@@ -2925,7 +3189,7 @@ uint32_t Solver::num_active_vars() const
             case Removed::none:
                 break;
         }
-        if (varData[var].removed != Removed::none) {
+        if (varFlags.removed(var) != Removed::none) {
             removed_non_decision++;
         }
         numActive++;
@@ -3238,7 +3502,7 @@ void Solver::parse_v_line(A* in, const size_t lineNum)
 
         //Don't overwrite previously computed values
         if (model[var] == l_Undef
-            && varData[var].removed == Removed::none
+            && varFlags.removed(var) == Removed::none
         ) {
             model[var] = parsed_lit < 0 ? l_False : l_True;
             if (conf.verbosity >= 10) {
@@ -3458,7 +3722,7 @@ void Solver::undef_fill_potentials()
         uint32_t v = (*undef->trail_lim_vars)[trail_at];
         if (undef->verbose) cout << "Examining trail var: " << v+1 << endl;
 
-        assert(varData[v].removed == Removed::none);
+        assert(varFlags.removed(v) == Removed::none);
         assert(assumptionsSet.size() > v);
         if (model_value(v) != l_Undef
             && assumptionsSet[v] == false
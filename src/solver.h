@@ -53,6 +53,9 @@ class OccSimplifier;
 class SCCFinder;
 class DistillerAllWithAll;
 class DistillerLongWithImpl;
+class Sweeper;
+class TransRed;
+class StampSweeper;
 class StrImplWImplStamp;
 class CalcDefPolars;
 class SolutionExtender;
@@ -119,6 +122,8 @@ class Solver : public Searcher
         uint32_t num_active_vars() const;
         void print_mem_stats() const;
         uint64_t print_watch_mem_used(uint64_t totalMem) const;
+        uint64_t mem_used_accounted(const bool recount_watches);
+        bool enforce_mem_budget();
         unsigned long get_sql_id() const;
         const SolveStats& get_solve_stats() const;
         const SearchStats& get_stats() const;
@@ -144,6 +149,9 @@ class Solver : public Searcher
         OccSimplifier*         occsimplifier = NULL;
         DistillerAllWithAll*   distill_all_with_all = NULL;
         DistillerLongWithImpl* dist_long_with_impl = NULL;
+        Sweeper*               sweeper = NULL;
+        TransRed*              trans_red = NULL;
+        StampSweeper*          stamp_sweeper = NULL;
         StrImplWImplStamp* dist_impl_with_impl = NULL;
         CompHandler*           compHandler = NULL;
 
@@ -238,6 +246,15 @@ class Solver : public Searcher
         lbool iterate_until_solved();
         uint64_t mem_used_vardata() const;
         SolveFeatures calculate_features() const;
+        bool over_mem_budget = false;
+        uint64_t mem_budget_checks = 0;
+        uint64_t watch_mem_counted = 0; ///<Watch list memory at the last recount
+        bool mem_budget_freed_cache = false;
+        bool mem_budget_tightened_occ = false;
+        unsigned orig_maxOccurIrredMB; ///<Occur limits before the memory budget tightened them
+        unsigned orig_maxOccurRedMB;
+        unsigned long long orig_maxOccurRedLitLinkedM;
+        void undo_mem_budget_step();
         void reconfigure(int val);
 
         vector<Lit> finalCl_tmp;
@@ -461,7 +478,7 @@ inline bool Solver::find_with_stamp_a_or_b(Lit a, const Lit b) const
 
 inline bool Solver::find_with_cache_a_or_b(Lit a, Lit b, int64_t* limit) const
 {
-    const vector<LitExtra>& cache = solver->implCache[a].lits;
+    const CacheLits cache = solver->implCache[a];
     *limit -= cache.size();
     for (LitExtra cacheLit: cache) {
         if (cacheLit.getOnlyIrredBin()
@@ -473,7 +490,7 @@ inline bool Solver::find_with_cache_a_or_b(Lit a, Lit b, int64_t* limit) const
 
     std::swap(a,b);
 
-    const vector<LitExtra>& cache2 = solver->implCache[a].lits;
+    const CacheLits cache2 = solver->implCache[a];
     *limit -= cache2.size();
     for (LitExtra cacheLit: cache) {
         if (cacheLit.getOnlyIrredBin()
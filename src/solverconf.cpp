@@ -70,6 +70,9 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , more_red_minim_limit_cache(400)
         , more_red_minim_limit_binary(200)
         , max_num_lits_more_red_min(1)
+        , doAllUIPShrink(true)
+        , max_size_all_uip_shrink(200)
+        , all_uip_shrink_limit(2000)
         , extra_bump_var_activities_based_on_glue(true)
 
         //Verbosity
@@ -84,6 +87,9 @@ DLL_PUBLIC SolverConf::SolverConf() :
         //Limits
         , maxTime          (std::numeric_limits<double>::max())
         , maxConfl         (std::numeric_limits<long>::max())
+        , maxMemMB         (std::numeric_limits<uint64_t>::max())
+        , mem_budget_soft_ratio(0.9)
+        , mem_budget_undo_ratio(0.5)
 
         //Glues
         , update_glues_on_prop(false)
@@ -94,6 +100,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , doOTFSubsume     (true)
         , doOTFSubsumeOnlyAtOrBelowGlue(5)
         , rewardShortenedClauseWithConfl(5)
+        , eager_subsume_last_k(10)
 
         //SQL
         , dump_individual_search_time(true)
@@ -113,11 +120,13 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , varElimRatioPerIter(0.70)
         , skip_some_bve_resolvents(true)
         , velim_resolvent_too_large(20)
+        , varelim_threads(1)
 
         //Subs, str limits for simplifier
         , subsumption_time_limitM(300)
         , strengthening_time_limitM(300)
         , aggressive_elim_time_limitM(300)
+        , bce_time_limitM(100)
 
         //Bounded variable addition
         , do_bva(true)
@@ -134,6 +143,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , intree_scc_varreplace_time_limitM(30ULL)
         , doBothProp       (true)
         , doTransRed       (true)
+        , trans_red_time_limitM(20ULL)
         , doStamp          (true)
         , doCache          (true)
         , cacheUpdateCutoff(2000)
@@ -141,6 +151,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , otf_hyper_time_limitM(340)
         , otf_hyper_ratio_limit(0.5) //if higher(closer to 1), we allow for less hyper-bin addition, i.e. we are stricter
         , single_probe_time_limit_perc(0.5)
+        , probe_threads(1)
 
         //XOR
         , doFindXors       (true)
@@ -154,7 +165,6 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , doFindAndReplaceEqLits(true)
         , doExtendedSCC         (true)
         , sccFindPercent        (0.04)
-        , max_scc_depth (10000)
 
         //Iterative Alo Scheduling
         , simplify_at_startup(true)
@@ -179,8 +189,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
             "handle-comps,"
             "scc-vrepl, cache-clean, cache-tryboth,"
             "sub-impl, intree-probe, probe,"
-            "sub-str-cls-with-bin, distill-cls,"
-            "scc-vrepl, sub-impl, str-impl, sub-impl,"
+            "sub-str-cls-with-bin, distill-cls, distill-red-cls,"
+            "sweep, scc-vrepl, trans-red, stamp-sweep, sub-impl, str-impl, sub-impl,"
             "occ-backw-sub-str, occ-clean-implicit, occ-bve, occ-bva, "//occ-gates,"
             "occ-xor,"
             "str-impl, cache-clean, sub-str-cls-with-bin, distill-cls,"
@@ -194,7 +204,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
             "handle-comps,"
             "scc-vrepl, cache-clean, cache-tryboth,"
             "sub-impl,"
-            "sub-str-cls-with-bin, distill-cls, scc-vrepl, sub-impl,"
+            "sub-str-cls-with-bin, distill-cls, sweep, scc-vrepl, trans-red, stamp-sweep, sub-impl,"
             "occ-backw-sub-str, occ-xor, occ-clean-implicit, occ-bve, occ-bva,"
             //"occ-gates,"
             "str-impl, cache-clean, sub-str-cls-with-bin, distill-cls, scc-vrepl, sub-impl,"
@@ -211,17 +221,33 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxOccurRedMB    (800)
         , maxOccurRedLitLinkedM(50)
         , subsume_gothrough_multip(10.0)
+        , occ_only_dirty(true)
+        , subsume_threads(1)
 
         //Distillation
         , distill_queue_by(2)
         , do_distill_clauses(true)
         , distill_long_irred_cls_time_limitM(10ULL)
+        , do_distill_red_clauses(true)
+        , distill_red_cls_time_limitM(5ULL)
         , watch_cache_stamp_based_str_time_limitM(30LL)
         , distill_time_limitM(120LL)
 
+        //SAT sweeping
+        , do_sweep(true)
+        , sweep_time_limitM(20ULL)
+
+        //Stamp sweep
+        , do_stamp_sweep(true)
+        , stamp_sweep_time_limitM(30ULL)
+
         //Memory savings
         , doRenumberVars   (true)
         , doSaveMem        (true)
+        , doIncrementalConsolidate (false)
+        , incremental_consolidate_max_used_ratio (0.5)
+        , incremental_consolidate_max_chunks (64)
+        , doLocalityConsolidate (false)
 
         //Component finding
         , doCompHandler    (true)
@@ -192,6 +192,9 @@ class DLL_PUBLIC SolverConf
         unsigned more_red_minim_limit_cache;
         unsigned more_red_minim_limit_binary;
         unsigned max_num_lits_more_red_min;
+        int doAllUIPShrink; ///<Replace same-level literals of learnt clause with their level's UIP
+        unsigned max_size_all_uip_shrink;
+        unsigned all_uip_shrink_limit;
         int extra_bump_var_activities_based_on_glue;
 
         //Verbosity
@@ -206,6 +209,9 @@ class DLL_PUBLIC SolverConf
         //Limits
         double   maxTime;
         long maxConfl;
+        uint64_t maxMemMB; ///<Memory budget, see Solver::enforce_mem_budget()
+        double   mem_budget_soft_ratio; ///<Start freeing memory above this ratio of the budget
+        double   mem_budget_undo_ratio; ///<Undo the steps that freed memory below this ratio of the budget
 
         //Glues
         int       update_glues_on_prop;
@@ -216,6 +222,7 @@ class DLL_PUBLIC SolverConf
         int       doOTFSubsume;
         int       doOTFSubsumeOnlyAtOrBelowGlue;
         int       rewardShortenedClauseWithConfl; //Shortened through OTF subsumption
+        unsigned  eager_subsume_last_k; //Check this many last learnt clauses for subsumption by the new one
 
         //SQL
         bool      dump_individual_search_time;
@@ -235,11 +242,13 @@ class DLL_PUBLIC SolverConf
         double    varElimRatioPerIter;
         int      skip_some_bve_resolvents;
         int velim_resolvent_too_large; //-1 == no limit
+        unsigned varelim_threads; ///<Compute resolvents of independent vars with this many threads
 
         //Subs, str limits for simplifier
         long long subsumption_time_limitM;
         long long strengthening_time_limitM;
         long long aggressive_elim_time_limitM;
+        long long bce_time_limitM; ///<Blocked and covered clause elimination, run by occ-bce and occ-cce
 
         //BVA
         int      do_bva;
@@ -256,6 +265,7 @@ class DLL_PUBLIC SolverConf
         unsigned long long intree_scc_varreplace_time_limitM;
         int      doBothProp;
         int      doTransRed;   ///<Should carry out transitive reduction
+        unsigned long long trans_red_time_limitM;
         int      doStamp;
         int      doCache;
         unsigned   cacheUpdateCutoff;
@@ -263,6 +273,7 @@ class DLL_PUBLIC SolverConf
         unsigned long long otf_hyper_time_limitM;
         double  otf_hyper_ratio_limit;
         double single_probe_time_limit_perc;
+        unsigned probe_threads; ///<Probe disjoint sets of vars with this many threads
 
         //XORs
         int      doFindXors;
@@ -276,7 +287,6 @@ class DLL_PUBLIC SolverConf
         int doFindAndReplaceEqLits;
         int doExtendedSCC;
         double sccFindPercent;
-        int max_scc_depth;
 
         //Iterative Alo Scheduling
         int      simplify_at_startup; //simplify at 1st startup (only)
@@ -299,17 +309,33 @@ class DLL_PUBLIC SolverConf
         unsigned maxOccurRedMB;
         unsigned long long maxOccurRedLitLinkedM;
         double   subsume_gothrough_multip;
+        int      occ_only_dirty; ///<Only revisit parts of the formula that changed since the last round
+        unsigned subsume_threads; ///<Threads to search for subsumed/strengthened clauses with
 
         //Distillation
         uint32_t distill_queue_by;
         int      do_distill_clauses;
         unsigned long long distill_long_irred_cls_time_limitM;
+        int      do_distill_red_clauses;
+        unsigned long long distill_red_cls_time_limitM;
         long watch_cache_stamp_based_str_time_limitM;
         long long distill_time_limitM;
 
+        //SAT sweeping
+        int      do_sweep;
+        unsigned long long sweep_time_limitM;
+
+        //Stamp sweep
+        int      do_stamp_sweep;
+        unsigned long long stamp_sweep_time_limitM;
+
         //Memory savings
         int       doRenumberVars;
         int       doSaveMem;
+        int       doIncrementalConsolidate;
+        double    incremental_consolidate_max_used_ratio;
+        unsigned  incremental_consolidate_max_chunks;
+        int       doLocalityConsolidate;
 
         //Component handling
         int       doCompHandler;
@@ -33,29 +33,39 @@ void Stamp::save_on_var_memory(const uint32_t newNumVars)
 
 bool Stamp::stampBasedClRem(
     const vector<Lit>& lits
+) const {
+    return stampBasedClRem(lits, stampNorm, stampInv);
+}
+
+//Same as above, but with caller-supplied temporaries so multiple threads
+//can call it at the same time
+bool Stamp::stampBasedClRem(
+    const vector<Lit>& lits
+    , vector<Lit>& norm
+    , vector<Lit>& inv
 ) const {
     StampSorter sortNorm(tstamp, STAMP_IRRED, false);
     StampSorterInv sortInv(tstamp, STAMP_IRRED, false);
 
-    stampNorm = lits;
-    stampInv = lits;
+    norm = lits;
+    inv = lits;
 
-    std::sort(stampNorm.begin(), stampNorm.end(), sortNorm);
-    std::sort(stampInv.begin(), stampInv.end(), sortInv);
+    std::sort(norm.begin(), norm.end(), sortNorm);
+    std::sort(inv.begin(), inv.end(), sortInv);
 
     #ifdef DEBUG_STAMPING
-    cout << "NORM sorted clause: " << stampNorm << endl;
+    cout << "NORM sorted clause: " << norm << endl;
     cout << "Timestamps: ";
-    for(Lit l: stampNorm) {
+    for(Lit l: norm) {
         cout
         << " " << tstamp[l.toInt()].start[STAMP_IRRED]
         << "," << tstamp[l.toInt()].end[STAMP_IRRED];
     }
     cout << endl;
 
-    cout << "INV sorted clause: " << stampInv << endl;
+    cout << "INV sorted clause: " << inv << endl;
     cout << "Timestamps: ";
-    for(Lit l: stampInv) {
+    for(Lit l: inv) {
         cout
         << " " << tstamp[l.toInt()].start[STAMP_IRRED]
         << "," << tstamp[l.toInt()].end[STAMP_IRRED];
@@ -64,8 +74,8 @@ bool Stamp::stampBasedClRem(
     #endif
 
     assert(lits.size() > 0);
-    vector<Lit>::const_iterator lpos = stampNorm.begin();
-    vector<Lit>::const_iterator lneg = stampInv.begin();
+    vector<Lit>::const_iterator lpos = norm.begin();
+    vector<Lit>::const_iterator lneg = inv.begin();
 
     while(true) {
         if (tstamp[(~*lneg).toInt()].start[STAMP_IRRED]
@@ -73,14 +83,14 @@ bool Stamp::stampBasedClRem(
         ) {
             lpos++;
 
-            if (lpos == stampNorm.end())
+            if (lpos == norm.end())
                 return false;
         } else if (tstamp[(~*lneg).toInt()].end[STAMP_IRRED]
             <= tstamp[lpos->toInt()].end[STAMP_IRRED]
         ) {
             lneg++;
 
-            if (lneg == stampInv.end())
+            if (lneg == inv.end())
                 return false;
         } else {
             return true;
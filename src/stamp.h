@@ -57,6 +57,11 @@ class Stamp
 {
 public:
     bool stampBasedClRem(const vector<Lit>& lits) const;
+    bool stampBasedClRem(
+        const vector<Lit>& lits
+        , vector<Lit>& norm
+        , vector<Lit>& inv
+    ) const;
     std::pair<size_t, size_t> stampBasedLitRem(
         vector<Lit>& lits
         , StampType stampType
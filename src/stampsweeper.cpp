@@ -0,0 +1,390 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "stampsweeper.h"
+#include "solver.h"
+#include "clausecleaner.h"
+#include "clauseallocator.h"
+#include "time_mem.h"
+#include "sqlstats.h"
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+StampSweeper::StampSweeper(Solver* _solver) :
+    solver(_solver)
+    , last_stamping_time(0)
+    , bins_at_stamping(0)
+{}
+
+bool StampSweeper::out_of_time() const
+{
+    return solver->propStats.bogoProps - orig_bogoprops + extra_time > max_props
+        || solver->must_interrupt_asap();
+}
+
+bool StampSweeper::sweep()
+{
+    assert(solver->ok);
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    runStats.numCalls = 1;
+
+    max_props = solver->conf.stamp_sweep_time_limitM*1000ULL*1000ULL
+        *solver->conf.global_timeout_multiplier;
+    orig_bogoprops = solver->propStats.bogoProps;
+    extra_time = 0;
+
+    solver->clauseCleaner->remove_and_clean_all();
+    if (!solver->ok) {
+        return false;
+    }
+
+    //A restamping cut short leaves correct but incomplete stamps, and will
+    //be done again next time
+    size_t num_long = solver->longIrredCls.size();
+    for(const auto& lredcls: solver->longRedCls) {
+        num_long += lredcls.size();
+    }
+    if (num_long > 0
+        && must_restamp()
+        && restamp(STAMP_IRRED)
+        && restamp(STAMP_RED)
+    ) {
+        last_stamping_time = solver->stamp.stampingTime;
+        bins_at_stamping = solver->binTri.irredBins + solver->binTri.redBins;
+        solver->binTri.numNewBinsSinceStamp = 0;
+        runStats.restamped++;
+    }
+
+    if (sweep_clauses(solver->longIrredCls)) {
+        for(auto& lredcls: solver->longRedCls) {
+            if (!sweep_clauses(lredcls)) {
+                break;
+            }
+        }
+    }
+
+    const bool time_out = out_of_time();
+    const double time_used = cpuTime() - myTime;
+    const double time_remain = 1.0 - float_div(
+        solver->propStats.bogoProps - orig_bogoprops + extra_time, max_props);
+    runStats.timeOut += time_out;
+    runStats.cpu_time = time_used;
+    if (solver->conf.verbosity) {
+        runStats.print_short(solver, time_out, time_remain);
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "stamp-sweep"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+    globalStats += runStats;
+    runStats.clear();
+
+    //Free up memory, this is not run often. The stamps are kept
+    roots.clear();
+    roots.shrink_to_fit();
+    visited.clear();
+    visited.shrink_to_fit();
+    frames.clear();
+    frames.shrink_to_fit();
+
+    return solver->ok;
+}
+
+//The stamps stay correct when binaries are added, they just miss the new
+//implications. When binaries are removed, or probing stamped over a part of
+//the graph, they may also be missing ones they'd have found
+bool StampSweeper::must_restamp() const
+{
+    return solver->stamp.stampingTime == 0
+        || solver->stamp.stampingTime != last_stamping_time
+        || solver->binTri.numNewBinsSinceStamp > 0
+        || solver->binTri.irredBins + solver->binTri.redBins != bins_at_stamping;
+}
+
+//Literals without incoming edges are the best roots, since the whole
+//graph below them gets nested inside their interval. Returns false if it
+//ran out of time
+bool StampSweeper::restamp(const StampType stampType)
+{
+    const uint32_t num_lits = solver->nVars()*2;
+    visited.clear();
+    visited.resize(num_lits, 0);
+    roots.clear();
+    for(uint32_t i = 0; i < num_lits; i++) {
+        const Lit lit = Lit::toLit(i);
+        if (solver->value(lit) != l_Undef
+            || solver->varFlags.removed(lit.var()) != Removed::none
+        ) {
+            visited[i] = 1;
+            continue;
+        }
+
+        //Binary clauses (lit V lit2) mean ~lit2 implies lit
+        bool has_incoming = false;
+        watch_subarray_const ws = solver->watches[lit];
+        extra_time += ws.size()/4 + 1;
+        for(const Watched& w: ws) {
+            if (w.isBin() && (stampType == STAMP_RED || !w.red())) {
+                has_incoming = true;
+                break;
+            }
+        }
+        if (!has_incoming) {
+            roots.push_back(lit);
+        }
+    }
+
+    const size_t num_sources = roots.size();
+    for(uint32_t i = 0; i < num_lits; i++) {
+        if (!visited[i]) {
+            roots.push_back(Lit::toLit(i));
+        }
+    }
+    for(size_t i = 0; i + 1 < num_sources; i++) {
+        std::swap(roots[i], roots[i + solver->mtrand.randInt(num_sources-i)]);
+    }
+    for(size_t i = num_sources; i + 1 < roots.size(); i++) {
+        std::swap(roots[i], roots[i + solver->mtrand.randInt(roots.size()-i)]);
+    }
+
+    for(const Lit root: roots) {
+        if (!visited[root.toInt()]
+            && !stamp_from(root, stampType)
+        ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//When out of time, it stops descending but still closes the open intervals.
+//Every new interval then only contains literals reachable from it, and
+//starts after all the old stamps, so the stamps claim nothing false
+bool StampSweeper::stamp_from(const Lit root, const StampType stampType)
+{
+    Stamp& stamp = solver->stamp;
+    visited[root.toInt()] = 1;
+    stamp.stampingTime++;
+    stamp.tstamp[root.toInt()].start[stampType] = stamp.stampingTime;
+    frames.push_back(Frame{root, 0});
+    bool time_out = false;
+    while(!frames.empty()) {
+        const Lit lit = frames.back().lit;
+        watch_subarray_const ws = solver->watches[~lit];
+        if (!time_out && frames.back().at < ws.size()) {
+            const Watched& w = ws[frames.back().at++];
+            extra_time++;
+            if (!w.isBin()
+                || (stampType == STAMP_IRRED && w.red())
+                || visited[w.lit2().toInt()]
+            ) {
+                continue;
+            }
+
+            visited[w.lit2().toInt()] = 1;
+            stamp.stampingTime++;
+            stamp.tstamp[w.lit2().toInt()].start[stampType] = stamp.stampingTime;
+            frames.push_back(Frame{w.lit2(), 0});
+            time_out = out_of_time();
+            continue;
+        }
+
+        stamp.stampingTime++;
+        stamp.tstamp[lit.toInt()].end[stampType] = stamp.stampingTime;
+        frames.pop_back();
+    }
+
+    return !time_out && !out_of_time();
+}
+
+bool StampSweeper::sweep_clauses(vector<ClOffset>& clauses)
+{
+    size_t i = 0;
+    size_t j = 0;
+    for(const size_t end = clauses.size(); i < end; i++) {
+        ClOffset offset = clauses[i];
+        if (!solver->okay() || out_of_time()) {
+            clauses[j++] = offset;
+            continue;
+        }
+
+        #ifdef USE_GAUSS
+        if (solver->cl_alloc.ptr(offset)->used_in_xor()) {
+            clauses[j++] = offset;
+            continue;
+        }
+        #endif
+
+        if (sweep_clause(offset)) {
+            solver->detachClause(offset);
+            solver->cl_alloc.clauseFree(offset);
+            continue;
+        }
+        clauses[j++] = offset;
+    }
+    clauses.resize(j);
+
+    return solver->okay();
+}
+
+//Returns true if the clause must be removed
+bool StampSweeper::sweep_clause(ClOffset& offset)
+{
+    Clause& cl = *solver->cl_alloc.ptr(offset);
+    runStats.triedCls++;
+    extra_time += cl.size()*3 + 10;
+    lits.assign(cl.begin(), cl.end());
+
+    if (solver->stamp.stampBasedClRem(lits)) {
+        if (cl.red()) {
+            runStats.subsumedRed++;
+        } else {
+            runStats.subsumedIrred++;
+        }
+        return true;
+    }
+
+    //Redundant clauses may be strengthened with redundant binaries too
+    solver->stamp.stampBasedLitRem(lits, STAMP_IRRED);
+    if (cl.red() && lits.size() > 1) {
+        solver->stamp.stampBasedLitRem(lits, STAMP_RED);
+    }
+    if (lits.size() == cl.size()) {
+        return false;
+    }
+
+    if (cl.red()) {
+        runStats.litsRemRed += cl.size() - lits.size();
+    } else {
+        runStats.litsRemIrred += cl.size() - lits.size();
+    }
+    #ifdef STATS_NEEDED
+    const ClauseStatsExtra extra = solver->cl_alloc.extra_stats(cl);
+    #endif
+    Clause* c2 = solver->add_clause_int(lits, cl.red(), cl.stats);
+    if (c2 != NULL) {
+        #ifdef STATS_NEEDED
+        solver->cl_alloc.extra_stats(*c2) = extra;
+        #endif
+        solver->detachClause(offset);
+        solver->cl_alloc.clauseFree(offset);
+        offset = solver->cl_alloc.get_offset(c2);
+        return false;
+    }
+
+    //Became a binary, unit, or empty clause
+    return true;
+}
+
+size_t StampSweeper::mem_used() const
+{
+    size_t mem = 0;
+    mem += roots.capacity()*sizeof(Lit);
+    mem += visited.capacity()*sizeof(char);
+    mem += frames.capacity()*sizeof(Frame);
+    mem += lits.capacity()*sizeof(Lit);
+    return mem;
+}
+
+StampSweeper::Stats& StampSweeper::Stats::operator+=(const Stats& other)
+{
+    cpu_time += other.cpu_time;
+    numCalls += other.numCalls;
+    timeOut += other.timeOut;
+    restamped += other.restamped;
+    triedCls += other.triedCls;
+    subsumedIrred += other.subsumedIrred;
+    subsumedRed += other.subsumedRed;
+    litsRemIrred += other.litsRemIrred;
+    litsRemRed += other.litsRemRed;
+
+    return *this;
+}
+
+void StampSweeper::Stats::print_short(
+    const Solver* solver
+    , const bool time_out
+    , const double time_remain
+) const {
+    cout
+    << "c [stamp-sweep]"
+    << " restamped: " << restamped
+    << " tried: " << triedCls
+    << " sub-irred: " << subsumedIrred
+    << " sub-red: " << subsumedRed
+    << " lit-rem-irred: " << litsRemIrred
+    << " lit-rem-red: " << litsRemRed
+    << solver->conf.print_times(cpu_time, time_out, time_remain)
+    << endl;
+}
+
+void StampSweeper::Stats::print() const
+{
+    cout << "c -------- STAMP-SWEEP STATS --------" << endl;
+    print_stats_line("c time"
+        , cpu_time
+        , ratio_for_stat(cpu_time, numCalls)
+        , "per call"
+    );
+
+    print_stats_line("c timed out"
+        , timeOut
+        , stats_line_percent(timeOut, numCalls)
+        , "% of calls"
+    );
+
+    print_stats_line("c restamped"
+        , restamped
+        , stats_line_percent(restamped, numCalls)
+        , "% of calls"
+    );
+
+    print_stats_line("c tried clauses"
+        , triedCls
+    );
+
+    print_stats_line("c subsumed irred cls"
+        , subsumedIrred
+    );
+
+    print_stats_line("c subsumed red cls"
+        , subsumedRed
+    );
+
+    print_stats_line("c lits rem irred cls"
+        , litsRemIrred
+    );
+
+    print_stats_line("c lits rem red cls"
+        , litsRemRed
+    );
+    cout << "c -------- STAMP-SWEEP STATS END --------" << endl;
+}
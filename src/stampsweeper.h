@@ -0,0 +1,121 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __STAMPSWEEPER_H__
+#define __STAMPSWEEPER_H__
+
+#include <vector>
+#include "constants.h"
+#include "solvertypes.h"
+#include "clause.h"
+#include "stamp.h"
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Removes and strengthens long clauses using the stamps of the binaries
+
+If binaries were added since the last call, or probing stamped over parts
+of the graph, every literal is stamped again through a DFS over the binary
+implication graph. The DFS counts towards the time limit. The DFS roots are taken in random order, so each call
+finds a somewhat different set of implications. Then all long clauses,
+irredundant and redundant, are checked against the stamps. A clause is
+removed if a binary implied by the graph subsumes it, and a literal is
+removed if it implies another literal of the clause. No occurrence lists
+are needed, so this also works on instances too large for OccSimplifier
+*/
+class StampSweeper {
+    public:
+        StampSweeper(Solver* solver);
+        bool sweep();
+
+        struct Stats
+        {
+            void clear()
+            {
+                Stats tmp;
+                *this = tmp;
+            }
+
+            Stats& operator+=(const Stats& other);
+            void print_short(const Solver* solver, const bool time_out, const double time_remain) const;
+            void print() const;
+
+            double cpu_time = 0;
+            uint64_t numCalls = 0;
+            uint64_t timeOut = 0;
+            uint64_t restamped = 0;
+            uint64_t triedCls = 0;
+            uint64_t subsumedIrred = 0;
+            uint64_t subsumedRed = 0;
+            uint64_t litsRemIrred = 0;
+            uint64_t litsRemRed = 0;
+        };
+
+        const Stats& get_stats() const;
+        size_t mem_used() const;
+
+    private:
+        struct Frame {
+            Lit lit;
+            uint32_t at; ///<Next watch to visit
+        };
+
+        bool must_restamp() const;
+        bool restamp(const StampType stampType);
+        bool stamp_from(const Lit root, const StampType stampType);
+        bool sweep_clauses(vector<ClOffset>& clauses);
+        bool sweep_clause(ClOffset& offset);
+        bool out_of_time() const;
+
+        Solver* solver;
+
+        vector<Lit> roots;
+        vector<char> visited;
+        vector<Frame> frames;
+        vector<Lit> lits;
+
+        ///Stamping time at the end of our last restamping
+        uint64_t last_stamping_time;
+        uint64_t bins_at_stamping; ///<Number of binaries right after our last restamping
+
+        //Limits
+        uint64_t max_props;
+        uint64_t orig_bogoprops;
+        uint64_t extra_time;
+
+        Stats runStats;
+        Stats globalStats;
+};
+
+inline const StampSweeper::Stats& StampSweeper::get_stats() const
+{
+    return globalStats;
+}
+
+} //end namespace
+
+#endif //__STAMPSWEEPER_H__
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "solver.h"
 #include "solvertypes.h"
 #include <array>
+#include <thread>
 
 //#define VERBOSE_DEBUG
 
@@ -59,6 +60,13 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
         , cl.abst
     );
 
+    return mark_irred_if_needed(offset, ret);
+}
+
+uint32_t SubsumeStrengthen::mark_irred_if_needed(const ClOffset offset, const Sub0Ret& ret)
+{
+    Clause& cl = *solver->cl_alloc.ptr(offset);
+
     //If irred is subsumed by redundant, make the redundant into irred
     if (cl.red()
         && ret.subsumedIrred
@@ -67,6 +75,7 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
         solver->litStats.redLits -= cl.size();
         solver->litStats.irredLits += cl.size();
         if (!cl.getOccurLinked()) {
+            mark_cl_vars_modified(cl);
             simplifier->linkInClause(cl);
         }
     }
@@ -93,15 +102,36 @@ SubsumeStrengthen::Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     , const cl_abst_type abs
     , const bool removeImplicit
 ) {
-    Sub0Ret ret;
-
     subs.clear();
     find_subsumed(offset, ps, abs, subs, removeImplicit);
 
+    return unlink_subsumed(offset, subs);
+}
+
+SubsumeStrengthen::Sub0Ret SubsumeStrengthen::unlink_subsumed(
+    const ClOffset offset
+    , const vector<ClOffset>& subsumed
+) {
+    #ifndef STATS_NEEDED
+    //Avoid unused parameter warning
+    (void) offset;
+    #endif
+    Sub0Ret ret;
+
     //Go through each clause that can be subsumed
-    for (const ClOffset offs: subs) {
+    for (const ClOffset offs: subsumed) {
         Clause *tmp = solver->cl_alloc.ptr(offs);
+
+        //Removed since it was found (only happens when finding in parallel)
+        if (tmp->getRemoved()) {
+            continue;
+        }
+
         ret.stats = ClauseStats::combineStats(tmp->stats, ret.stats);
+        #ifdef STATS_NEEDED
+        solver->cl_alloc.extra_stats(*solver->cl_alloc.ptr(offset)).combine(
+            solver->cl_alloc.extra_stats(*tmp));
+        #endif
         #ifdef VERBOSE_DEBUG
         cout << "-> subsume removing:" << *tmp << endl;
         #endif
@@ -125,7 +155,6 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
 {
     subs.clear();
     subsLits.clear();
-    Sub1Ret ret;
     Clause& cl = *solver->cl_alloc.ptr(offset);
     assert(!cl.getRemoved());
     assert(!cl.freed());
@@ -139,15 +168,32 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
         , cl.abst
         , subs
         , subsLits
+        , *simplifier->limit_to_decrease
     );
 
+    return apply_strengthened(offset, subs, subsLits);
+}
+
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::apply_strengthened(
+    const ClOffset offset
+    , const vector<ClOffset>& subsumed
+    , const vector<Lit>& lits
+) {
+    Sub1Ret ret;
+    Clause& cl = *solver->cl_alloc.ptr(offset);
     for (size_t j = 0
-        ; j < subs.size() && solver->okay()
+        ; j < subsumed.size() && solver->okay()
         ; j++
     ) {
-        ClOffset offset2 = subs[j];
+        ClOffset offset2 = subsumed[j];
         Clause& cl2 = *solver->cl_alloc.ptr(offset2);
-        if (subsLits[j] == lit_Undef) {  //Subsume
+
+        //Removed since it was found (only happens when finding in parallel)
+        if (cl2.getRemoved()) {
+            continue;
+        }
+
+        if (lits[j] == lit_Undef) {  //Subsume
 
             if (solver->conf.verbosity >= 6)
                 cout << "subsumed clause " << cl2 << endl;
@@ -160,12 +206,16 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
                 solver->litStats.redLits -= cl.size();
                 solver->litStats.irredLits += cl.size();
                 if (!cl.getOccurLinked()) {
+                    mark_cl_vars_modified(cl);
                     simplifier->linkInClause(cl);
                 }
             }
 
             //Update stats
             cl.combineStats(cl2.stats);
+            #ifdef STATS_NEEDED
+            solver->cl_alloc.extra_stats(cl).combine(solver->cl_alloc.extra_stats(cl2));
+            #endif
 
             simplifier->unlink_clause(offset2, true, false, true);
             ret.sub++;
@@ -173,7 +223,8 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
             if (solver->conf.verbosity >= 6) {
                 cout << "strenghtened clause " << cl2 << endl;
             }
-            remove_literal(offset2, subsLits[j]);
+            mark_cl_vars_modified(cl2);
+            remove_literal(offset2, lits[j]);
 
             ret.str++;
             if (!solver->ok)
@@ -202,6 +253,22 @@ void SubsumeStrengthen::randomise_clauses_order()
     }
 }
 
+//A clause that subsumes or strengthens a changed clause has all its
+//variables inside the changed clause, so all of them must be dirty
+bool SubsumeStrengthen::can_sub_str_changed_cl(const Clause& cl) const
+{
+    if (cl.red()) {
+        return true;
+    }
+
+    for(const Lit lit: cl) {
+        if (!simplifier->var_dirty(lit.var())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void SubsumeStrengthen::backward_subsumption_long_with_long()
 {
     //If clauses are empty, the system below segfaults
@@ -215,6 +282,9 @@ void SubsumeStrengthen::backward_subsumption_long_with_long()
     simplifier->limit_to_decrease = &simplifier->subsumption_time_limit;
 
     randomise_clauses_order();
+    if (use_threads()) {
+        subsumed = backward_subsumption_long_with_long_par(wenThrough);
+    }
     while (*simplifier->limit_to_decrease > 0
         && (double)wenThrough < solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size()
     ) {
@@ -236,11 +306,16 @@ void SubsumeStrengthen::backward_subsumption_long_with_long()
         if (cl->freed() || cl->getRemoved())
             continue;
 
+        if (solver->conf.occ_only_dirty)
+            *simplifier->limit_to_decrease -= cl->size()/4;
+        if (!can_sub_str_changed_cl(*cl))
+            continue;
 
         *simplifier->limit_to_decrease -= 10;
         subsumed += subsume_and_unlink_and_markirred(offset);
     }
 
+    all_cls_tried &= wenThrough >= simplifier->clauses.size();
     const double time_used = cpuTime() - myTime;
     const bool time_out = (*simplifier->limit_to_decrease <= 0);
     const double time_remain = float_div(*simplifier->limit_to_decrease, orig_limit);
@@ -280,6 +355,9 @@ bool SubsumeStrengthen::backward_strengthen_long_with_long()
     Sub1Ret ret;
 
     randomise_clauses_order();
+    if (use_threads()) {
+        ret = backward_strengthen_long_with_long_par(wenThrough);
+    }
     while(*simplifier->limit_to_decrease > 0
         && wenThrough < 1.5*(double)2*simplifier->clauses.size()
         && solver->okay()
@@ -302,10 +380,16 @@ bool SubsumeStrengthen::backward_strengthen_long_with_long()
         if (cl->freed() || cl->getRemoved())
             continue;
 
+        if (solver->conf.occ_only_dirty)
+            *simplifier->limit_to_decrease -= cl->size()/4;
+        if (!can_sub_str_changed_cl(*cl))
+            continue;
+
         ret += strengthen_subsume_and_unlink_and_markirred(offset);
 
     }
 
+    all_cls_tried &= wenThrough >= simplifier->clauses.size();
     const double time_used = cpuTime() - myTime;
     const bool time_out = *simplifier->limit_to_decrease <= 0;
     const double time_remain = float_div(*simplifier->limit_to_decrease, orig_limit);
@@ -352,10 +436,11 @@ void inline SubsumeStrengthen::fillSubs(
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
     , const Lit lit
-) {
+    , int64_t& limit
+) const {
     Lit litSub;
     watch_subarray_const cs = solver->watches[lit];
-    *simplifier->limit_to_decrease -= (long)cs.size()*2+ 40;
+    limit -= (long)cs.size()*2+ 40;
     for (const Watched *it = cs.begin(), *end = cs.end()
         ; it != end
         ; ++it
@@ -377,8 +462,8 @@ void inline SubsumeStrengthen::fillSubs(
             continue;
         }
 
-        *simplifier->limit_to_decrease -= (long)((cl.size() + cl2.size())/4);
-        litSub = subset1(cl, cl2);
+        limit -= (long)((cl.size() + cl2.size())/4);
+        litSub = subset1(cl, cl2, limit);
         if (litSub != lit_Error) {
             out_subsumed.push_back(it->get_offset());
             out_lits.push_back(litSub);
@@ -415,7 +500,8 @@ void SubsumeStrengthen::findStrengthened(
     , const cl_abst_type abs
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
-)
+    , int64_t& limit
+) const
 {
     #ifdef VERBOSE_DEBUG
     cout << "findStrengthened: " << cl << endl;
@@ -434,10 +520,10 @@ void SubsumeStrengthen::findStrengthened(
         }
     }
     assert(minVar != var_Undef);
-    *simplifier->limit_to_decrease -= (long)cl.size();
+    limit -= (long)cl.size();
 
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true));
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false));
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true), limit);
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false), limit);
 }
 
 bool SubsumeStrengthen::handle_sub_str_with(size_t orig_limit)
@@ -510,6 +596,9 @@ void SubsumeStrengthen::remove_literal(ClOffset offset, const Lit toRemoveLit)
     #endif
 
     *simplifier->limit_to_decrease -= 5;
+    if (!cl.red()) {
+        simplifier->mark_elim_batch_changed(cl);
+    }
 
     (*solver->drat) << deldelay << cl << fin;
     cl.strengthen(toRemoveLit);
@@ -542,7 +631,7 @@ bool SubsumeStrengthen::subsetAbst(const cl_abst_type A, const cl_abst_type B)
 
 //A subsumes B (A <= B)
 template<class T1, class T2>
-bool SubsumeStrengthen::subset(const T1& A, const T2& B)
+bool SubsumeStrengthen::subset(const T1& A, const T2& B, int64_t& limit)
 {
     #ifdef MORE_DEUBUG
     cout << "A:" << A << endl;
@@ -583,7 +672,7 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
     ret = false;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    limit -= (long)i2*4 + (long)i*4;
     return ret;
 }
 
@@ -601,7 +690,7 @@ clause B
 and returns the literal to remove if (2) is true
 */
 template<class T1, class T2>
-Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
+Lit SubsumeStrengthen::subset1(const T1& A, const T2& B, int64_t& limit)
 {
     Lit retLit = lit_Undef;
 
@@ -633,12 +722,12 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
     retLit = lit_Error;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    limit -= (long)i2*4 + (long)i*4;
     return retLit;
 }
 
 template<class T>
-size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
+size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps, int64_t& limit) const
 {
     size_t min_i = 0;
     size_t min_num = solver->watches[ps[min_i]].size();
@@ -649,7 +738,7 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
             min_num = this_num;
         }
     }
-    *simplifier->limit_to_decrease -= (long)ps.size();
+    limit -= (long)ps.size();
 
     return min_i;
 }
@@ -675,7 +764,12 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     cout << endl;
     #endif
 
-    const size_t smallest = find_smallest_watchlist_for_clause(ps);
+    if (!removeImplicit) {
+        find_subsumed_no_implicit(offset, ps, abs, out_subsumed, *simplifier->limit_to_decrease);
+        return;
+    }
+
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, *simplifier->limit_to_decrease);
 
     //Go through the occur list of the literal that has the smallest occur list
     watch_subarray occ = solver->watches[ps[smallest]];
@@ -729,7 +823,7 @@ template<class T> void SubsumeStrengthen::find_subsumed(
             continue;
 
         *simplifier->limit_to_decrease -= 50;
-        if (subset(ps, cl2)) {
+        if (subset(ps, cl2, *simplifier->limit_to_decrease)) {
             out_subsumed.push_back(offset2);
             #ifdef VERBOSE_DEBUG
             cout << "subsumed cl offset: " << offset2 << endl;
@@ -746,11 +840,310 @@ template void SubsumeStrengthen::find_subsumed(
     , bool removeImplicit
 );
 
+/**
+@brief Same as find_subsumed without removeImplicit, but does not touch the
+occurrence lists, so it can be called from multiple threads at once
+*/
+template<class T> void SubsumeStrengthen::find_subsumed_no_implicit(
+    const ClOffset offset
+    , const T& ps
+    , const cl_abst_type abs
+    , vector<ClOffset>& out_subsumed
+    , int64_t& limit
+) const {
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, limit);
+
+    //Go through the occur list of the literal that has the smallest occur list
+    watch_subarray_const occ = solver->watches[ps[smallest]];
+    limit -= (long)occ.size()*8 + 40;
+
+    for (const Watched *it = occ.begin(), *end = occ.end()
+        ; it != end
+        ; ++it
+    ) {
+        if (!it->isClause()) {
+            continue;
+        }
+
+        limit -= 15;
+
+        if (it->get_offset() == offset
+            || !subsetAbst(abs, it->getAbst())
+        ) {
+            continue;
+        }
+
+        const ClOffset offset2 = it->get_offset();
+        const Clause& cl2 = *solver->cl_alloc.ptr(offset2);
+
+        if (ps.size() > cl2.size() || cl2.getRemoved())
+            continue;
+
+        limit -= 50;
+        if (subset(ps, cl2, limit)) {
+            out_subsumed.push_back(offset2);
+            #ifdef VERBOSE_DEBUG
+            cout << "subsumed cl offset: " << offset2 << endl;
+            #endif
+        }
+    }
+}
+
+namespace CMSat {
+struct OneThreadFindSubs
+{
+    OneThreadFindSubs(
+        SubsumeStrengthen* _sub_str
+        , const vector<ClOffset>& _cands
+        , const bool _strengthen
+        , const size_t _tid
+        , const size_t _num_threads
+    ) :
+        sub_str(_sub_str)
+        , cands(_cands)
+        , strengthen(_strengthen)
+        , tid(_tid)
+        , num_threads(_num_threads)
+    {
+    }
+
+    void operator()()
+    {
+        const Solver* solver = sub_str->solver;
+        for(size_t i = tid; i < cands.size(); i += num_threads) {
+            SubsumeStrengthen::FoundSubs& f = sub_str->found[i];
+            f.done = false;
+            f.cost = 0;
+            f.cls.clear();
+            f.lits.clear();
+
+            const ClOffset offset = cands[i];
+            const Clause& cl = *solver->cl_alloc.ptr(offset);
+            if (cl.freed()
+                || cl.getRemoved()
+                || !sub_str->can_sub_str_changed_cl(cl)
+            ) {
+                continue;
+            }
+
+            if (strengthen) {
+                sub_str->findStrengthened(offset, cl, cl.abst, f.cls, f.lits, f.cost);
+            } else {
+                sub_str->find_subsumed_no_implicit(offset, cl, cl.abst, f.cls, f.cost);
+            }
+            f.done = true;
+        }
+    }
+
+    SubsumeStrengthen* sub_str;
+    const vector<ClOffset>& cands;
+    const bool strengthen;
+    const size_t tid;
+    const size_t num_threads;
+};
+}
+
+bool SubsumeStrengthen::use_threads() const
+{
+    return solver->conf.subsume_threads > 1
+        && simplifier->clauses.size() >= 10ULL*1000ULL;
+}
+
+//Fills found[i] for every candidate using all threads. The occurrence lists
+//and clauses are not modified while the threads run
+void SubsumeStrengthen::find_in_parallel(
+    const vector<ClOffset>& cands
+    , const bool strengthen
+) {
+    const size_t num_threads = solver->conf.subsume_threads;
+    if (found.size() < cands.size()) {
+        found.resize(cands.size());
+    }
+
+    vector<std::thread> thds;
+    for(size_t i = 0; i < num_threads; i++) {
+        thds.push_back(std::thread(OneThreadFindSubs(this, cands, strengthen, i, num_threads)));
+    }
+    for(std::thread& thread : thds) {
+        thread.join();
+    }
+}
+
+//Clauses found in parallel for a candidate can only be out of date if a
+//clause containing all of the candidate's variables changed since
+void SubsumeStrengthen::mark_cl_vars_modified(const Clause& cl)
+{
+    if (var_modified.empty()) {
+        return;
+    }
+
+    for(const Lit lit: cl) {
+        if (!var_modified[lit.var()]) {
+            var_modified[lit.var()] = 1;
+            vars_modified.push_back(lit.var());
+        }
+    }
+}
+
+bool SubsumeStrengthen::find_may_be_stale(const Clause& cl) const
+{
+    if (vars_modified.empty()) {
+        return false;
+    }
+
+    for(const Lit lit: cl) {
+        if (!var_modified[lit.var()]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SubsumeStrengthen::clear_vars_modified()
+{
+    for(const uint32_t var: vars_modified) {
+        var_modified[var] = 0;
+    }
+    vars_modified.clear();
+}
+
+/**
+@brief Parallel version of the loop in backward_subsumption_long_with_long
+
+The candidates are taken in the same order as the serial loop, in batches.
+Each batch is searched for subsumed clauses by all threads, then the results
+are applied one by one in order. The results are the same as the serial
+version's, only the time limit is checked once per candidate and not inside
+the search
+*/
+size_t SubsumeStrengthen::backward_subsumption_long_with_long_par(size_t& wenThrough)
+{
+    size_t subsumed = 0;
+    vector<ClOffset> cands;
+    var_modified.resize(solver->nVars(), 0);
+
+    while (*simplifier->limit_to_decrease > 0
+        && (double)wenThrough < solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size()
+    ) {
+        //The batch is only valid as long as the number of clauses stays the
+        //same, otherwise the serial loop would take other candidates
+        const size_t sz = simplifier->clauses.size();
+        const double max_through = solver->conf.subsume_gothrough_multip*(double)sz;
+        const size_t batch_size = std::min<size_t>(sz, solver->conf.subsume_threads*1000ULL);
+        cands.clear();
+        for(size_t w = wenThrough
+            ; cands.size() < batch_size && (double)w < max_through
+            ; w++
+        ) {
+            cands.push_back(simplifier->clauses[(w+1) % sz]);
+        }
+        find_in_parallel(cands, false);
+
+        for(size_t i = 0
+            ; i < cands.size()
+            && *simplifier->limit_to_decrease > 0
+            && simplifier->clauses.size() == sz
+            ; i++
+        ) {
+            *simplifier->limit_to_decrease -= 3;
+            wenThrough++;
+
+            const ClOffset offset = cands[i];
+            Clause* cl = solver->cl_alloc.ptr(offset);
+            if (cl->freed() || cl->getRemoved())
+                continue;
+
+            if (solver->conf.occ_only_dirty)
+                *simplifier->limit_to_decrease -= cl->size()/4;
+            if (!can_sub_str_changed_cl(*cl))
+                continue;
+
+            *simplifier->limit_to_decrease -= 10;
+            Sub0Ret ret;
+            if (!found[i].done || find_may_be_stale(*cl)) {
+                ret = subsume_and_unlink(offset, *cl, cl->abst);
+            } else {
+                *simplifier->limit_to_decrease += found[i].cost;
+                ret = unlink_subsumed(offset, found[i].cls);
+            }
+            subsumed += mark_irred_if_needed(offset, ret);
+        }
+        clear_vars_modified();
+    }
+    var_modified.clear();
+
+    return subsumed;
+}
+
+//Parallel version of the loop in backward_strengthen_long_with_long
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::backward_strengthen_long_with_long_par(
+    size_t& wenThrough
+) {
+    Sub1Ret ret;
+    vector<ClOffset> cands;
+    var_modified.resize(solver->nVars(), 0);
+
+    while (*simplifier->limit_to_decrease > 0
+        && wenThrough < 1.5*(double)2*simplifier->clauses.size()
+        && solver->okay()
+    ) {
+        //See backward_subsumption_long_with_long_par()
+        const size_t sz = simplifier->clauses.size();
+        const double max_through = 1.5*(double)2*sz;
+        const size_t batch_size = std::min<size_t>(sz, solver->conf.subsume_threads*1000ULL);
+        cands.clear();
+        for(size_t w = wenThrough
+            ; cands.size() < batch_size && w < max_through
+            ; w++
+        ) {
+            cands.push_back(simplifier->clauses[(w+1) % sz]);
+        }
+        find_in_parallel(cands, true);
+
+        for(size_t i = 0
+            ; i < cands.size()
+            && *simplifier->limit_to_decrease > 0
+            && solver->okay()
+            && simplifier->clauses.size() == sz
+            ; i++
+        ) {
+            *simplifier->limit_to_decrease -= 10;
+            wenThrough++;
+
+            const ClOffset offset = cands[i];
+            Clause* cl = solver->cl_alloc.ptr(offset);
+            if (cl->freed() || cl->getRemoved())
+                continue;
+
+            if (solver->conf.occ_only_dirty)
+                *simplifier->limit_to_decrease -= cl->size()/4;
+            if (!can_sub_str_changed_cl(*cl))
+                continue;
+
+            if (!found[i].done || find_may_be_stale(*cl)) {
+                ret += strengthen_subsume_and_unlink_and_markirred(offset);
+            } else {
+                *simplifier->limit_to_decrease += found[i].cost;
+                ret += apply_strengthened(offset, found[i].cls, found[i].lits);
+            }
+        }
+        clear_vars_modified();
+    }
+    var_modified.clear();
+
+    return ret;
+}
+
 size_t SubsumeStrengthen::mem_used() const
 {
     size_t b = 0;
     b += subs.capacity()*sizeof(ClOffset);
     b += subsLits.capacity()*sizeof(Lit);
+    for(const FoundSubs& f: found) {
+        b += f.cls.capacity()*sizeof(ClOffset);
+        b += f.lits.capacity()*sizeof(Lit);
+    }
+    b += found.capacity()*sizeof(FoundSubs);
 
     return b;
 }
@@ -816,6 +1209,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::sub_str_with_implicit(
         , calcAbstraction(lits)
         , subs
         , subsLits
+        , *simplifier->limit_to_decrease
     );
 
     Sub1Ret ret;
@@ -933,6 +1327,9 @@ bool SubsumeStrengthen::backward_sub_str_with_bins_tris()
 
     ) {
         Lit lit = Lit::toLit(upI);
+        if (!simplifier->var_dirty(lit.var())) {
+            continue;
+        }
         if (!backw_sub_str_with_bin_tris_watch(lit)) {
             break;
         }
@@ -41,6 +41,7 @@ class SubsumeStrengthen
 public:
     SubsumeStrengthen(OccSimplifier* simplifier, Solver* solver);
     size_t mem_used() const;
+    bool all_cls_tried = true; ///<Did the long-with-long passes go through every clause?
 
     void backward_subsumption_long_with_long();
     bool backward_strengthen_long_with_long();
@@ -121,10 +122,30 @@ private:
     );
 
     void randomise_clauses_order();
+    bool can_sub_str_changed_cl(const Clause& cl) const;
     void remove_literal(ClOffset c, const Lit toRemoveLit);
 
+    Sub0Ret unlink_subsumed(const ClOffset offset, const vector<ClOffset>& subsumed);
+    uint32_t mark_irred_if_needed(const ClOffset offset, const Sub0Ret& ret);
+    Sub1Ret apply_strengthened(
+        const ClOffset offset
+        , const vector<ClOffset>& subsumed
+        , const vector<Lit>& lits
+    );
+
+    //The finders below only read the occurrence lists, and charge their
+    //cost to 'limit'. They are called from multiple threads
     template<class T>
-    size_t find_smallest_watchlist_for_clause(const T& ps) const;
+    size_t find_smallest_watchlist_for_clause(const T& ps, int64_t& limit) const;
+
+    template<class T>
+    void find_subsumed_no_implicit(
+        const ClOffset offset
+        , const T& ps
+        , const cl_abst_type abs
+        , vector<ClOffset>& out_subsumed
+        , int64_t& limit
+    ) const;
 
     template<class T>
     void findStrengthened(
@@ -133,7 +154,8 @@ private:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
-    );
+        , int64_t& limit
+    ) const;
 
     template<class T>
     void fillSubs(
@@ -143,14 +165,38 @@ private:
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
         , const Lit lit
-    );
+        , int64_t& limit
+    ) const;
 
     template<class T1, class T2>
-    bool subset(const T1& A, const T2& B);
+    static bool subset(const T1& A, const T2& B, int64_t& limit);
 
     template<class T1, class T2>
-    Lit subset1(const T1& A, const T2& B);
-    bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
+    static Lit subset1(const T1& A, const T2& B, int64_t& limit);
+    static bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
+
+    //Parallel backward subsumption and strengthening
+    struct FoundSubs
+    {
+        bool done = false;
+        int64_t cost = 0;
+        vector<ClOffset> cls;
+        vector<Lit> lits;
+    };
+    vector<FoundSubs> found;
+    vector<char> var_modified;
+    vector<uint32_t> vars_modified;
+    void find_in_parallel(
+        const vector<ClOffset>& cands
+        , const bool strengthen
+    );
+    void mark_cl_vars_modified(const Clause& cl);
+    bool find_may_be_stale(const Clause& cl) const;
+    void clear_vars_modified();
+    size_t backward_subsumption_long_with_long_par(size_t& wenThrough);
+    Sub1Ret backward_strengthen_long_with_long_par(size_t& wenThrough);
+    bool use_threads() const;
+    friend struct OneThreadFindSubs;
 
     vector<ClOffset> subs;
     vector<Lit> subsLits;
@@ -0,0 +1,684 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "sweeper.h"
+#include "solver.h"
+#include "clausecleaner.h"
+#include "varreplacer.h"
+#include "time_mem.h"
+#include "sqlstats.h"
+#include "popcnt.h"
+#include "drat.h"
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+const uint32_t Sweeper::gate_none;
+const uint32_t Sweeper::sim_words;
+
+Sweeper::Sweeper(Solver* _solver) :
+    solver(_solver)
+{}
+
+bool Sweeper::out_of_time() const
+{
+    return solver->propStats.bogoProps - orig_bogoprops + extra_time > max_props
+        || solver->must_interrupt_asap();
+}
+
+bool Sweeper::sweep()
+{
+    assert(solver->ok);
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    runStats.numCalls = 1;
+
+    max_props = solver->conf.sweep_time_limitM*1000ULL*1000ULL
+        *solver->conf.global_timeout_multiplier;
+    orig_bogoprops = solver->propStats.bogoProps;
+    extra_time = 0;
+    rnd.seed(solver->mtrand.randInt());
+
+    solver->clauseCleaner->clean_clauses(solver->longIrredCls);
+    if (!solver->ok) {
+        return false;
+    }
+
+    gates.clear();
+    gate_ins.clear();
+    var_gate.clear();
+    var_gate.resize(solver->nVars(), gate_none);
+    find_and_gates(true);
+    find_xor_gates();
+    find_and_gates(false);
+    order_gates();
+    simulate();
+    find_candidates();
+    prove_candidates();
+
+    if (solver->ok
+        && runStats.provedEq > 0
+        && solver->conf.doFindAndReplaceEqLits
+    ) {
+        solver->varReplacer->replace_if_enough_is_found();
+    }
+
+    const bool time_out = out_of_time();
+    const double time_used = cpuTime() - myTime;
+    const double time_remain = 1.0 - float_div(
+        solver->propStats.bogoProps - orig_bogoprops + extra_time, max_props);
+    runStats.timeOut += time_out;
+    runStats.cpu_time = time_used;
+    if (solver->conf.verbosity) {
+        runStats.print_short(solver, time_out, time_remain);
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "sweep"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+    globalStats += runStats;
+    runStats.clear();
+
+    //Free up memory, this is not run often
+    gates.clear();
+    gates.shrink_to_fit();
+    gate_ins.clear();
+    gate_ins.shrink_to_fit();
+    var_gate.clear();
+    var_gate.shrink_to_fit();
+    gate_order.clear();
+    gate_order.shrink_to_fit();
+    var_level.clear();
+    var_level.shrink_to_fit();
+    sim.clear();
+    sim.shrink_to_fit();
+    cands.clear();
+    cands.shrink_to_fit();
+
+    return solver->ok;
+}
+
+void Sweeper::add_gate(const Lit out, const bool is_xor)
+{
+    var_gate[out.var()] = gates.size();
+    gates.push_back(Gate(out, gate_ins.size(), tmp_lits.size(), is_xor));
+    gate_ins.insert(gate_ins.end(), tmp_lits.begin(), tmp_lits.end());
+}
+
+//Long clause (g V ~x1 V ... V ~xn) with binaries (~g V xi) for every i
+//means g = AND(x1..xn). A variable can often be defined in terms of its own
+//fan-out too, which leads to cycles. Tseitin variables usually come after
+//their inputs, so with 'in_order' only such definitions are taken
+void Sweeper::find_and_gates(const bool in_order)
+{
+    for(const ClOffset offset: solver->longIrredCls) {
+        if (out_of_time()) {
+            break;
+        }
+        const Clause& cl = *solver->cl_alloc.ptr(offset);
+        extra_time += cl.size();
+        for(const Lit g: cl) {
+            if (var_gate[g.var()] != gate_none) {
+                continue;
+            }
+
+            const watch_subarray_const ws = solver->watches[~g];
+            extra_time += ws.size();
+            for(const Watched& w: ws) {
+                if (w.isBin() && !w.red()) {
+                    solver->seen[w.lit2().toInt()] = 1;
+                }
+            }
+
+            tmp_lits.clear();
+            for(const Lit l: cl) {
+                if (l == g) {
+                    continue;
+                }
+                if (!solver->seen[(~l).toInt()]
+                    || (in_order && l.var() > g.var())
+                ) {
+                    break;
+                }
+                tmp_lits.push_back(~l);
+            }
+
+            for(const Watched& w: ws) {
+                if (w.isBin()) {
+                    solver->seen[w.lit2().toInt()] = 0;
+                }
+            }
+
+            if (tmp_lits.size() + 1 == cl.size()) {
+                add_gate(g, false);
+                runStats.andGates++;
+                break;
+            }
+        }
+    }
+}
+
+//The 4 clauses over the same 3 variables with the same parity of negations
+//forbid every assignment of that parity, i.e. they encode a 3-long XOR
+void Sweeper::find_xor_gates()
+{
+    struct Tri {
+        std::array<uint32_t, 3> vars;
+        uint32_t signs; ///<Bit i is set if vars[i] is negated
+        uint32_t parity() const
+        {
+            return (signs ^ (signs >> 1) ^ (signs >> 2)) & 1;
+        }
+    };
+    vector<Tri> tris;
+    for(const ClOffset offset: solver->longIrredCls) {
+        const Clause& cl = *solver->cl_alloc.ptr(offset);
+        if (cl.size() != 3) {
+            continue;
+        }
+        std::array<Lit, 3> lits = {{cl[0], cl[1], cl[2]}};
+        std::sort(lits.begin(), lits.end());
+        Tri t;
+        t.signs = 0;
+        for(uint32_t i = 0; i < 3; i++) {
+            t.vars[i] = lits[i].var();
+            t.signs |= (uint32_t)lits[i].sign() << i;
+        }
+        tris.push_back(t);
+    }
+    extra_time += tris.size()*10;
+    std::sort(tris.begin(), tris.end(), [](const Tri& a, const Tri& b) {
+        if (a.vars != b.vars) return a.vars < b.vars;
+        if (a.parity() != b.parity()) return a.parity() < b.parity();
+        return a.signs < b.signs;
+    });
+
+    size_t i = 0;
+    while(i < tris.size()) {
+        const Tri& t = tris[i];
+        const uint32_t parity = t.parity();
+        uint32_t patterns = 0;
+        size_t j = i;
+        for(; j < tris.size()
+            && tris[j].vars == t.vars
+            && tris[j].parity() == parity
+            ; j++
+        ) {
+            patterns |= 1U << tris[j].signs;
+        }
+        i = j;
+        if (my_popcnt(patterns) != 4) {
+            continue;
+        }
+
+        //Allowed assignments have v0^v1^v2 == !parity. The largest
+        //variable is taken as the output, as with AND gates
+        for(int at = 2; at >= 0; at--) {
+            if (var_gate[t.vars[at]] != gate_none) {
+                continue;
+            }
+            tmp_lits.clear();
+            for(int k = 0; k < 3; k++) {
+                if (k != at) {
+                    tmp_lits.push_back(Lit(t.vars[k], false));
+                }
+            }
+            add_gate(Lit(t.vars[at], !parity), true);
+            runStats.xorGates++;
+            break;
+        }
+    }
+}
+
+//Kahn's algorithm. When only gates on cycles are left, the one found last
+//is dropped: its output is simulated as a free input instead
+void Sweeper::order_gates()
+{
+    vector<uint32_t> indeg(gates.size(), 0);
+    vector<uint32_t> users_at(solver->nVars()+1, 0);
+    for(const Gate& g: gates) {
+        for(uint32_t i = g.at; i < g.at + g.size; i++) {
+            users_at[gate_ins[i].var()+1]++;
+        }
+    }
+    for(size_t v = 0; v < solver->nVars(); v++) {
+        users_at[v+1] += users_at[v];
+    }
+    vector<uint32_t> users(users_at.back());
+    vector<uint32_t> fill(users_at.begin(), users_at.end()-1);
+    for(uint32_t gi = 0; gi < gates.size(); gi++) {
+        const Gate& g = gates[gi];
+        for(uint32_t i = g.at; i < g.at + g.size; i++) {
+            const uint32_t v = gate_ins[i].var();
+            users[fill[v]++] = gi;
+            indeg[gi] += var_gate[v] != gate_none;
+        }
+    }
+    extra_time += gate_ins.size()*2;
+
+    gate_order.clear();
+    for(uint32_t gi = 0; gi < gates.size(); gi++) {
+        if (indeg[gi] == 0) {
+            gate_order.push_back(gi);
+        }
+    }
+    var_level.clear();
+    var_level.resize(solver->nVars(), 0);
+    size_t at = 0;
+    uint32_t to_drop = gates.size();
+    uint32_t dropped = 0;
+    while(true) {
+        for(; at < gate_order.size(); at++) {
+            const Gate& g = gates[gate_order[at]];
+            uint32_t level = 0;
+            for(uint32_t i = g.at; i < g.at + g.size; i++) {
+                level = std::max(level, var_level[gate_ins[i].var()]);
+            }
+            const uint32_t out = g.out.var();
+            var_level[out] = level + 1;
+            for(uint32_t i = users_at[out]; i < users_at[out+1]; i++) {
+                if (--indeg[users[i]] == 0) {
+                    gate_order.push_back(users[i]);
+                }
+            }
+        }
+        if (gate_order.size() + dropped == gates.size()) {
+            break;
+        }
+
+        do {
+            to_drop--;
+        } while(indeg[to_drop] == 0
+            || var_gate[gates[to_drop].out.var()] != to_drop);
+        const uint32_t out = gates[to_drop].out.var();
+        var_gate[out] = gate_none;
+        //Never reaches zero, so it is never ordered
+        indeg[to_drop] = gate_none;
+        dropped++;
+        for(uint32_t i = users_at[out]; i < users_at[out+1]; i++) {
+            if (--indeg[users[i]] == 0) {
+                gate_order.push_back(users[i]);
+            }
+        }
+    }
+    runStats.cyclicGates += dropped;
+}
+
+inline uint64_t Sweeper::lit_sim(const Lit lit, const uint32_t w) const
+{
+    return sim[lit.var()*sim_words + w] ^ (lit.sign() ? ~0ULL : 0ULL);
+}
+
+void Sweeper::simulate()
+{
+    sim.resize(solver->nVars()*sim_words);
+    for(uint32_t v = 0; v < solver->nVars(); v++) {
+        const lbool val = solver->value(v);
+        for(uint32_t w = 0; w < sim_words; w++) {
+            if (val == l_Undef) {
+                sim[v*sim_words + w] = rnd();
+            } else {
+                sim[v*sim_words + w] = val == l_True ? ~0ULL : 0ULL;
+            }
+        }
+    }
+
+    for(const uint32_t gi: gate_order) {
+        const Gate& g = gates[gi];
+        if (solver->value(g.out) != l_Undef) {
+            continue;
+        }
+        for(uint32_t w = 0; w < sim_words; w++) {
+            uint64_t val = g.is_xor ? 0ULL : ~0ULL;
+            for(uint32_t i = g.at; i < g.at + g.size; i++) {
+                if (g.is_xor) {
+                    val ^= lit_sim(gate_ins[i], w);
+                } else {
+                    val &= lit_sim(gate_ins[i], w);
+                }
+            }
+            sim[g.out.var()*sim_words + w] = val ^ (g.out.sign() ? ~0ULL : 0ULL);
+        }
+    }
+    extra_time += (gate_ins.size() + solver->nVars())*sim_words;
+}
+
+//Variables whose signatures are equal up to negation are candidates for
+//equivalence. The signature is normalised so bit 0 is always zero
+void Sweeper::find_candidates()
+{
+    vector<uint32_t> vars;
+    vector<char> inv(solver->nVars(), 0);
+    for(const Gate& g: gates) {
+        if (var_gate[g.out.var()] == gate_none) {
+            continue;
+        }
+        for(uint32_t i = g.at; i < g.at + g.size; i++) {
+            solver->seen[gate_ins[i].var()] = 1;
+        }
+        solver->seen[g.out.var()] = 1;
+    }
+    for(uint32_t v = 0; v < solver->nVars(); v++) {
+        if (!solver->seen[v]) {
+            continue;
+        }
+        solver->seen[v] = 0;
+        if (solver->value(v) != l_Undef
+            || solver->varFlags.removed(v) != Removed::none
+        ) {
+            continue;
+        }
+        vars.push_back(v);
+        if (sim[v*sim_words] & 1) {
+            inv[v] = 1;
+            for(uint32_t w = 0; w < sim_words; w++) {
+                sim[v*sim_words + w] = ~sim[v*sim_words + w];
+            }
+        }
+    }
+
+    const uint64_t* s = sim.data();
+    std::sort(vars.begin(), vars.end(), [s](const uint32_t a, const uint32_t b) {
+        return std::lexicographical_compare(
+            s + a*sim_words, s + (a+1)*sim_words
+            , s + b*sim_words, s + (b+1)*sim_words);
+    });
+    extra_time += vars.size()*10;
+
+    cands.clear();
+    size_t i = 0;
+    while(i < vars.size()) {
+        size_t j = i+1;
+        while(j < vars.size()
+            && std::equal(s + vars[i]*sim_words, s + (vars[i]+1)*sim_words
+                , s + vars[j]*sim_words)
+        ) {
+            j++;
+        }
+
+        bool zero = true;
+        for(uint32_t w = 0; w < sim_words; w++) {
+            zero &= s[vars[i]*sim_words + w] == 0;
+        }
+        if (zero) {
+            for(size_t k = i; k < j; k++) {
+                cands.push_back(std::make_pair(lit_Undef, Lit(vars[k], inv[vars[k]])));
+            }
+        } else if (j - i > 1) {
+            uint32_t rep = vars[i];
+            for(size_t k = i+1; k < j; k++) {
+                if (var_level[vars[k]] < var_level[rep]) {
+                    rep = vars[k];
+                }
+            }
+            for(size_t k = i; k < j; k++) {
+                if (vars[k] != rep) {
+                    cands.push_back(std::make_pair(
+                        Lit(rep, inv[rep])
+                        , Lit(vars[k], inv[vars[k]])));
+                }
+            }
+        }
+        i = j;
+    }
+
+    //Lowest first, so proven equivalences of inputs help prove the outputs
+    const vector<uint32_t>& lev = var_level;
+    std::sort(cands.begin(), cands.end(),
+        [&lev](const std::pair<Lit, Lit>& a, const std::pair<Lit, Lit>& b) {
+            return lev[a.second.var()] < lev[b.second.var()];
+    });
+    runStats.candidates += cands.size();
+}
+
+//Whether enqueueing all of 'lits' in order leads to a conflict
+bool Sweeper::fails(const vector<Lit>& lits)
+{
+    bool ret = false;
+    for(const Lit lit: lits) {
+        if (solver->value(lit) == l_False) {
+            ret = true;
+            break;
+        }
+        if (solver->value(lit) == l_True) {
+            continue;
+        }
+        solver->new_decision_level();
+        solver->enqueue(lit);
+        if (!solver->propagate<true>().isNULL()) {
+            ret = true;
+            break;
+        }
+    }
+    solver->cancelUntil<false>(0);
+
+    return ret;
+}
+
+//Whether 'a' implies 'b', or, with 'b' being lit_Undef, 'a' is always false.
+//Propagation alone cannot see through XORs, so if that fails, both values of
+//'split' are tried, and the clauses of the two branches are emitted to DRAT
+//so the final clause is RUP
+bool Sweeper::implies(const Lit a, const Lit b, const Lit split)
+{
+    assumps.clear();
+    assumps.push_back(a);
+    if (b != lit_Undef) {
+        assumps.push_back(~b);
+    }
+    if (fails(assumps)) {
+        return true;
+    }
+    if (split == lit_Undef
+        || split.var() == a.var()
+        || (b != lit_Undef && split.var() == b.var())
+    ) {
+        return false;
+    }
+
+    assumps.push_back(split);
+    if (!fails(assumps)) {
+        return false;
+    }
+    assumps.back() = ~split;
+    if (!fails(assumps)) {
+        return false;
+    }
+    runStats.splitProofs++;
+
+    if (solver->drat->enabled()) {
+        for(uint32_t i = 0; i < 2; i++) {
+            drat_lemmas.push_back(vector<Lit>());
+            vector<Lit>& lemma = drat_lemmas.back();
+            for(const Lit l: assumps) {
+                lemma.push_back(~l);
+            }
+            lemma.back() = i ? split : ~split;
+            (*solver->drat) << lemma << fin;
+        }
+    }
+    return true;
+}
+
+//An input of the gate defining the variable of 'lit', if any
+Lit Sweeper::split_lit(const Lit lit) const
+{
+    const uint32_t gi = var_gate[lit.var()];
+    if (gi == gate_none) {
+        return lit_Undef;
+    }
+    return gate_ins[gates[gi].at];
+}
+
+bool Sweeper::prove_candidates()
+{
+    for(const auto& c: cands) {
+        if (out_of_time()) {
+            break;
+        }
+        const Lit a = c.first;
+        const Lit b = c.second;
+        if (solver->value(b) != l_Undef
+            || (a != lit_Undef && solver->value(a) != l_Undef)
+        ) {
+            continue;
+        }
+
+        drat_lemmas.clear();
+        const Lit split = split_lit(b);
+        if (a == lit_Undef) {
+            if (!implies(b, lit_Undef, split)) {
+                runStats.notProved++;
+                continue;
+            }
+            tmp_lits.clear();
+            tmp_lits.push_back(~b);
+            solver->add_clause_int(tmp_lits);
+            runStats.provedConst++;
+        } else {
+            if (!implies(a, b, split) || !implies(b, a, split)) {
+                runStats.notProved++;
+                for(const vector<Lit>& lemma: drat_lemmas) {
+                    (*solver->drat) << del << lemma << fin;
+                }
+                continue;
+            }
+            tmp_lits.clear();
+            tmp_lits.push_back(~a);
+            tmp_lits.push_back(b);
+            solver->add_clause_int(tmp_lits);
+            if (solver->ok) {
+                tmp_lits.clear();
+                tmp_lits.push_back(a);
+                tmp_lits.push_back(~b);
+                solver->add_clause_int(tmp_lits);
+            }
+            runStats.provedEq++;
+        }
+        for(const vector<Lit>& lemma: drat_lemmas) {
+            (*solver->drat) << del << lemma << fin;
+        }
+        if (!solver->ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t Sweeper::mem_used() const
+{
+    size_t mem = 0;
+    mem += gates.capacity()*sizeof(Gate);
+    mem += gate_ins.capacity()*sizeof(Lit);
+    mem += var_gate.capacity()*sizeof(uint32_t);
+    mem += gate_order.capacity()*sizeof(uint32_t);
+    mem += var_level.capacity()*sizeof(uint32_t);
+    mem += sim.capacity()*sizeof(uint64_t);
+    mem += cands.capacity()*sizeof(std::pair<Lit, Lit>);
+    mem += tmp_lits.capacity()*sizeof(Lit);
+    mem += assumps.capacity()*sizeof(Lit);
+    return mem;
+}
+
+Sweeper::Stats& Sweeper::Stats::operator+=(const Stats& other)
+{
+    cpu_time += other.cpu_time;
+    numCalls += other.numCalls;
+    timeOut += other.timeOut;
+    andGates += other.andGates;
+    xorGates += other.xorGates;
+    cyclicGates += other.cyclicGates;
+    candidates += other.candidates;
+    provedEq += other.provedEq;
+    provedConst += other.provedConst;
+    splitProofs += other.splitProofs;
+    notProved += other.notProved;
+
+    return *this;
+}
+
+void Sweeper::Stats::print_short(
+    const Solver* solver
+    , const bool time_out
+    , const double time_remain
+) const {
+    cout
+    << "c [sweep]"
+    << " and: " << andGates
+    << " xor: " << xorGates
+    << " cyc: " << cyclicGates
+    << " cands: " << candidates
+    << " eq: " << provedEq
+    << " const: " << provedConst
+    << " fail: " << notProved
+    << " split: " << splitProofs
+    << solver->conf.print_times(cpu_time, time_out, time_remain)
+    << endl;
+}
+
+void Sweeper::Stats::print() const
+{
+    cout << "c -------- SWEEP STATS --------" << endl;
+    print_stats_line("c time"
+        , cpu_time
+        , ratio_for_stat(cpu_time, numCalls)
+        , "per call"
+    );
+
+    print_stats_line("c timed out"
+        , timeOut
+        , stats_line_percent(timeOut, numCalls)
+        , "% of calls"
+    );
+
+    print_stats_line("c and/xor/cyclic gates"
+        , andGates
+        , xorGates
+        , cyclicGates
+    );
+
+    print_stats_line("c candidates"
+        , candidates
+    );
+
+    print_stats_line("c proved eq/const/not"
+        , provedEq
+        , provedConst
+        , notProved
+    );
+
+    print_stats_line("c proofs with split"
+        , splitProofs
+    );
+    cout << "c -------- SWEEP STATS END --------" << endl;
+}
@@ -0,0 +1,143 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __SWEEPER_H__
+#define __SWEEPER_H__
+
+#include <vector>
+#include <random>
+#include "constants.h"
+#include "solvertypes.h"
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief SAT sweeping: finds equivalent and constant literals
+
+AND gates (a long clause plus its binaries) and 3-long XORs are extracted
+from the irredundant clauses, and simulated bit-parallel with random
+inputs in topological order. Literals with the same simulation signature
+are proven equivalent through propagation, lowest gates first, so the
+binaries proven for the inputs of a gate help prove its output. Where
+propagation is not enough, e.g. for XORs, one input is split on. Proven
+equivalences are added as binary clauses and handed to VarReplacer
+*/
+class Sweeper {
+    public:
+        Sweeper(Solver* solver);
+        bool sweep();
+
+        struct Stats
+        {
+            void clear()
+            {
+                Stats tmp;
+                *this = tmp;
+            }
+
+            Stats& operator+=(const Stats& other);
+            void print_short(const Solver* solver, const bool time_out, const double time_remain) const;
+            void print() const;
+
+            double cpu_time = 0;
+            uint64_t numCalls = 0;
+            uint64_t timeOut = 0;
+            uint64_t andGates = 0;
+            uint64_t xorGates = 0;
+            uint64_t cyclicGates = 0;
+            uint64_t candidates = 0;
+            uint64_t provedEq = 0;
+            uint64_t provedConst = 0;
+            uint64_t notProved = 0;
+            uint64_t splitProofs = 0;
+        };
+
+        const Stats& get_stats() const;
+        size_t mem_used() const;
+
+    private:
+        ///Value of 'out' is the AND, or the XOR, of the literals in
+        ///ins[at, at+size)
+        struct Gate {
+            Gate(const Lit _out, const uint32_t _at, const uint32_t _size, const bool _is_xor) :
+                out(_out)
+                , at(_at)
+                , size(_size)
+                , is_xor(_is_xor)
+            {}
+
+            Lit out;
+            uint32_t at;
+            uint32_t size;
+            bool is_xor;
+        };
+
+        void find_and_gates(const bool in_order);
+        void find_xor_gates();
+        void add_gate(const Lit out, const bool is_xor);
+        void order_gates();
+        void simulate();
+        void find_candidates();
+        bool prove_candidates();
+        bool fails(const vector<Lit>& lits);
+        bool implies(const Lit a, const Lit b, const Lit split);
+        Lit split_lit(const Lit lit) const;
+        bool out_of_time() const;
+        uint64_t lit_sim(const Lit lit, const uint32_t w) const;
+
+        Solver* solver;
+        std::mt19937_64 rnd;
+
+        vector<Gate> gates;
+        vector<Lit> gate_ins;
+        vector<uint32_t> var_gate; ///<Gate defining the var, or gate_none
+        vector<uint32_t> gate_order;
+        vector<uint32_t> var_level;
+        vector<uint64_t> sim; ///<sim_words words for each var
+        vector<std::pair<Lit, Lit> > cands; ///<Candidate equivalences. First is lit_Undef if second is always false
+        vector<Lit> tmp_lits;
+        vector<Lit> assumps;
+        vector<vector<Lit> > drat_lemmas; ///<Deleted from DRAT once the candidate is done
+        static const uint32_t gate_none = std::numeric_limits<uint32_t>::max();
+        static const uint32_t sim_words = 4;
+
+        //Limits
+        uint64_t max_props;
+        uint64_t orig_bogoprops;
+        uint64_t extra_time;
+
+        Stats runStats;
+        Stats globalStats;
+};
+
+inline const Sweeper::Stats& Sweeper::get_stats() const
+{
+    return globalStats;
+}
+
+} //end namespace
+
+#endif //__SWEEPER_H__
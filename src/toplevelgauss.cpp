@@ -307,7 +307,7 @@ void TopLevelGauss::cutIntoBlocks(const vector<size_t>& xorsToUse)
         //Calc blocks for this XOR
         set<size_t> blocksBelongTo;
         for(uint32_t v: thisXor) {
-            assert(solver->varData[v].removed == Removed::none);
+            assert(solver->varFlags.removed(v) == Removed::none);
             if (varToBlock[v] != std::numeric_limits<uint32_t>::max())
                 blocksBelongTo.insert(varToBlock[v]);
         }
@@ -0,0 +1,592 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "transred.h"
+#include "solver.h"
+#include "watchalgos.h"
+#include "time_mem.h"
+#include "sqlstats.h"
+#include "drat.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+const uint64_t TransRed::max_reach_words;
+
+TransRed::TransRed(Solver* _solver) :
+    solver(_solver)
+    , num_comps(0)
+    , stamp(0)
+{}
+
+bool TransRed::out_of_time() const
+{
+    return solver->propStats.bogoProps - orig_bogoprops + extra_time > max_props
+        || solver->must_interrupt_asap();
+}
+
+bool TransRed::reduce()
+{
+    assert(solver->ok);
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    runStats.numCalls = 1;
+
+    max_props = solver->conf.trans_red_time_limitM*1000ULL*1000ULL
+        *solver->conf.global_timeout_multiplier;
+    orig_bogoprops = solver->propStats.bogoProps;
+    extra_time = 0;
+
+    //Irredundant binaries are only removed if other irredundant ones imply
+    //them, redundant ones may be implied by anything
+    reduce_graph(false);
+    remove_bins();
+    if (!out_of_time()) {
+        reduce_graph(true);
+        remove_bins();
+    }
+
+    const bool time_out = out_of_time();
+    const double time_used = cpuTime() - myTime;
+    const double time_remain = 1.0 - float_div(
+        solver->propStats.bogoProps - orig_bogoprops + extra_time, max_props);
+    runStats.timeOut += time_out;
+    runStats.cpu_time = time_used;
+    if (solver->conf.verbosity) {
+        runStats.print_short(solver, time_out, time_remain);
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "trans-red"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+    globalStats += runStats;
+    runStats.clear();
+
+    //Free up memory, this is not run often
+    lits.clear();
+    lits.shrink_to_fit();
+    lit_edge_at.clear();
+    lit_edge_at.shrink_to_fit();
+    lit_edges.clear();
+    lit_edges.shrink_to_fit();
+    part.clear();
+    part.shrink_to_fit();
+    comp.clear();
+    comp.shrink_to_fit();
+    comp_edge_at.clear();
+    comp_edge_at.shrink_to_fit();
+    comp_edges.clear();
+    comp_edges.shrink_to_fit();
+    part_start.clear();
+    part_start.shrink_to_fit();
+    reach.clear();
+    reach.shrink_to_fit();
+    mark.clear();
+    mark.shrink_to_fit();
+    index.clear();
+    index.shrink_to_fit();
+    lowlink.clear();
+    lowlink.shrink_to_fit();
+    stackIndicator.clear();
+    stackIndicator.shrink_to_fit();
+
+    return solver->ok;
+}
+
+void TransRed::reduce_graph(const bool with_red)
+{
+    build_graph(with_red);
+    if (lits.empty()) {
+        return;
+    }
+    tarjan();
+    build_comp_graph();
+
+    //Nothing outside a weakly connected part can reach into it. Dense parts,
+    //and parts that fit in one window, are done with bitsets. In sparse ones
+    //most components have a single successor, so searching is cheaper
+    mark.clear();
+    mark.resize(num_comps, 0);
+    stamp = 0;
+    for(uint32_t begin = 0; begin < num_comps && !out_of_time(); ) {
+        uint32_t end = begin+1;
+        while(end < num_comps && part_start[end] == begin) {
+            end++;
+        }
+        const uint32_t size = end - begin;
+        const uint32_t num_edges = comp_edge_at[end] - comp_edge_at[begin];
+        if (size <= 64*64 || num_edges >= 2*size) {
+            const uint32_t words = std::max<uint64_t>(1, std::min<uint64_t>(
+                std::min<uint64_t>(64, (size+63)/64), max_reach_words/size));
+            for(uint32_t lo = begin; lo < end && !out_of_time(); lo += words*64) {
+                const uint32_t hi = std::min<uint64_t>(end, (uint64_t)lo + words*64);
+                reduce_window(begin, lo, hi, words, with_red);
+                runStats.windows++;
+            }
+        } else {
+            reduce_sparse(begin, end, with_red);
+        }
+        begin = end;
+    }
+}
+
+//Binary clause (~lit V lit2) means 'lit' implies 'lit2'
+void TransRed::build_graph(const bool with_red)
+{
+    const uint32_t num_lits = solver->nVars()*2;
+    lits.clear();
+    lit_edges.clear();
+    lit_edge_at.clear();
+    lit_edge_at.resize(num_lits+1, 0);
+
+    for(uint32_t i = 0; i < num_lits; i++) {
+        const Lit lit = Lit::toLit(i);
+        lit_edge_at[i] = lit_edges.size();
+        if (solver->value(lit) != l_Undef
+            || solver->varFlags.removed(lit.var()) != Removed::none
+        ) {
+            continue;
+        }
+
+        watch_subarray_const ws = solver->watches[~lit];
+        extra_time += ws.size()/4 + 1;
+        for(const Watched& w: ws) {
+            if (!w.isBin() || (w.red() && !with_red)) {
+                continue;
+            }
+            const Lit lit2 = w.lit2();
+            if (solver->value(lit2) != l_Undef
+                || solver->varFlags.removed(lit2.var()) != Removed::none
+            ) {
+                continue;
+            }
+
+            Edge e;
+            e.lit1 = std::min(~lit, lit2);
+            e.lit2 = std::max(~lit, lit2);
+            e.to = lit2.toInt();
+            e.red = w.red();
+            lit_edges.push_back(e);
+        }
+    }
+    lit_edge_at[num_lits] = lit_edges.size();
+
+    //Every edge has its dual, so a literal has edges iff its negation has
+    part.resize(num_lits);
+    for(uint32_t i = 0; i < num_lits; i += 2) {
+        if (lit_edge_at[i] != lit_edge_at[i+2]) {
+            lits.push_back(i);
+            lits.push_back(i+1);
+            part[i] = i;
+            part[i+1] = i+1;
+        }
+    }
+    for(const uint32_t l: lits) {
+        for(uint32_t at = lit_edge_at[l]; at < lit_edge_at[l+1]; at++) {
+            const uint32_t a = find_part(l);
+            const uint32_t b = find_part(lit_edges[at].to);
+            part[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    //DFS roots in the order of the parts keeps the parts contiguous
+    for(const uint32_t l: lits) {
+        part[l] = find_part(l);
+    }
+    std::sort(lits.begin(), lits.end(), [&](const uint32_t a, const uint32_t b) {
+        return part[a] < part[b] || (part[a] == part[b] && a < b);
+    });
+    extra_time += lits.size() + lit_edges.size();
+}
+
+uint32_t TransRed::find_part(uint32_t lit)
+{
+    while(part[lit] != lit) {
+        part[lit] = part[part[lit]];
+        lit = part[lit];
+    }
+    return lit;
+}
+
+//Components are found in reverse topological order, and a DFS never
+//leaves the weakly connected part of its root
+void TransRed::tarjan()
+{
+    const uint32_t num_lits = solver->nVars()*2;
+    const uint32_t none = std::numeric_limits<uint32_t>::max();
+    uint32_t globalIndex = 0;
+    num_comps = 0;
+    index.clear();
+    index.resize(num_lits, none);
+    lowlink.clear();
+    lowlink.resize(num_lits, none);
+    stackIndicator.clear();
+    stackIndicator.resize(num_lits, false);
+    comp.clear();
+    comp.resize(num_lits, none);
+    assert(stack.empty());
+    assert(frames.empty());
+
+    for(const uint32_t root: lits) {
+        if (index[root] != none) {
+            continue;
+        }
+
+        frames.push_back(Frame{root, lit_edge_at[root]});
+        index[root] = lowlink[root] = globalIndex++;
+        stack.push_back(root);
+        stackIndicator[root] = true;
+        while(!frames.empty()) {
+            const uint32_t lit = frames.back().lit;
+            const uint32_t at = frames.back().at;
+            if (at < lit_edge_at[lit+1]) {
+                frames.back().at++;
+                const uint32_t succ = lit_edges[at].to;
+                if (index[succ] == none) {
+                    frames.push_back(Frame{succ, lit_edge_at[succ]});
+                    index[succ] = lowlink[succ] = globalIndex++;
+                    stack.push_back(succ);
+                    stackIndicator[succ] = true;
+                } else if (stackIndicator[succ]) {
+                    lowlink[lit] = std::min(lowlink[lit], index[succ]);
+                }
+                continue;
+            }
+
+            if (lowlink[lit] == index[lit]) {
+                uint32_t other;
+                do {
+                    other = stack.back();
+                    stack.pop_back();
+                    stackIndicator[other] = false;
+                    comp[other] = num_comps;
+                } while (other != lit);
+                num_comps++;
+            }
+            frames.pop_back();
+            if (!frames.empty()) {
+                const uint32_t parent = frames.back().lit;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[lit]);
+            }
+        }
+    }
+
+    for(const uint32_t l: lits) {
+        comp[l] = num_comps - 1 - comp[l];
+    }
+    runStats.comps += num_comps;
+    extra_time += lits.size() + lit_edges.size();
+}
+
+void TransRed::build_comp_graph()
+{
+    comp_edge_at.clear();
+    comp_edge_at.resize(num_comps+1, 0);
+    part_start.clear();
+    part_start.resize(num_comps);
+    for(const uint32_t l: lits) {
+        part_start[comp[l]] = part[l];
+        for(uint32_t at = lit_edge_at[l]; at < lit_edge_at[l+1]; at++) {
+            if (comp[lit_edges[at].to] != comp[l]) {
+                comp_edge_at[comp[l]+1]++;
+            }
+        }
+    }
+    for(uint32_t t = 0; t < num_comps; t++) {
+        comp_edge_at[t+1] += comp_edge_at[t];
+    }
+
+    comp_edges.resize(comp_edge_at[num_comps]);
+    for(const uint32_t l: lits) {
+        for(uint32_t at = lit_edge_at[l]; at < lit_edge_at[l+1]; at++) {
+            Edge e = lit_edges[at];
+            e.to = comp[e.to];
+            if (e.to != comp[l]) {
+                comp_edges[comp_edge_at[comp[l]]++] = e;
+            }
+        }
+    }
+    for(uint32_t t = num_comps; t > 0; t--) {
+        comp_edge_at[t] = comp_edge_at[t-1];
+    }
+    comp_edge_at[0] = 0;
+
+    //Parallel edges are next to each other, the irredundant ones first. The
+    //order only depends on the clause, so its dual edge is chosen the same
+    for(uint32_t t = 0; t < num_comps; t++) {
+        std::sort(comp_edges.begin() + comp_edge_at[t]
+            , comp_edges.begin() + comp_edge_at[t+1]);
+    }
+
+    //Part IDs to the first component of the part
+    uint32_t start = 0;
+    uint32_t last_part = std::numeric_limits<uint32_t>::max();
+    for(uint32_t t = 0; t < num_comps; t++) {
+        if (part_start[t] != last_part) {
+            last_part = part_start[t];
+            start = t;
+        }
+        part_start[t] = start;
+    }
+    runStats.edges += comp_edges.size();
+    extra_time += comp_edges.size()*2;
+}
+
+//Components are visited in reverse topological order, so the successors'
+//bitsets are ready. Taking the successors closest to the component first,
+//a successor is already in the bitset iff it can be reached some other way
+void TransRed::reduce_window(
+    const uint32_t begin
+    , const uint32_t lo
+    , const uint32_t hi
+    , const uint32_t words
+    , const bool with_red
+) {
+    reach.clear();
+    reach.resize((size_t)(hi-begin)*words, 0);
+
+    for(uint32_t t = hi; t > begin; ) {
+        t--;
+        if (out_of_time()) {
+            return;
+        }
+
+        uint64_t* acc = &reach[(size_t)(t-begin)*words];
+        extra_time++;
+        for(uint32_t at = comp_edge_at[t]; at < comp_edge_at[t+1]; at++) {
+            const Edge& e = comp_edges[at];
+            if (e.to >= hi) {
+                break;
+            }
+
+            if (e.to >= lo) {
+                const uint32_t bit = e.to - lo;
+                if ((acc[bit/64] >> (bit%64)) & 1) {
+                    redundant(comp_edge_at[t], at, with_red);
+                    continue;
+                }
+                acc[bit/64] |= 1ULL << (bit%64);
+            }
+
+            const uint64_t* succ = &reach[(size_t)(e.to-begin)*words];
+            for(uint32_t w = 0; w < words; w++) {
+                acc[w] |= succ[w];
+            }
+            extra_time += 1 + words/8;
+        }
+    }
+}
+
+//Both directions of a clause may go between the same two components, if
+//one is the negation of the other. The second is then not redundant: it is
+//the same clause as the first
+void TransRed::redundant(const uint32_t first, const uint32_t at, const bool with_red)
+{
+    const Edge& e = comp_edges[at];
+    if (at > first) {
+        const Edge& prev = comp_edges[at-1];
+        if (prev.to == e.to
+            && prev.lit1 == e.lit1
+            && prev.lit2 == e.lit2
+            && prev.red == e.red
+        ) {
+            return;
+        }
+    }
+
+    if (e.red || !with_red) {
+        to_remove.push_back(BinaryClause(e.lit1, e.lit2, e.red));
+    }
+}
+
+//Same as reduce_window(), but the set of components reached is built by
+//searching. Nothing beyond the last successor is needed, so the search is
+//cut there, and the last successor itself needs no search
+void TransRed::reduce_sparse(
+    const uint32_t begin
+    , const uint32_t end
+    , const bool with_red
+) {
+    for(uint32_t t = end; t > begin; ) {
+        t--;
+        if (out_of_time()) {
+            return;
+        }
+
+        const uint32_t first = comp_edge_at[t];
+        const uint32_t last = comp_edge_at[t+1];
+        extra_time++;
+        if (last - first < 2) {
+            continue;
+        }
+
+        stamp++;
+        if (stamp == 0) {
+            std::fill(mark.begin(), mark.end(), 0);
+            stamp = 1;
+        }
+        const uint32_t max_to = comp_edges[last-1].to;
+        for(uint32_t at = first; at < last; at++) {
+            const Edge& e = comp_edges[at];
+            if (mark[e.to] == stamp) {
+                redundant(first, at, with_red);
+                continue;
+            }
+            mark[e.to] = stamp;
+            if (e.to == max_to) {
+                continue;
+            }
+
+            stack.push_back(e.to);
+            while(!stack.empty()) {
+                const uint32_t c = stack.back();
+                stack.pop_back();
+                for(uint32_t at2 = comp_edge_at[c]; at2 < comp_edge_at[c+1]; at2++) {
+                    const uint32_t to = comp_edges[at2].to;
+                    extra_time++;
+                    if (to > max_to) {
+                        break;
+                    }
+                    if (mark[to] != stamp) {
+                        mark[to] = stamp;
+                        stack.push_back(to);
+                    }
+                }
+            }
+        }
+    }
+}
+
+//Both directions of a clause are found, and they may be found for the same
+//duplicated clause, too
+void TransRed::remove_bins()
+{
+    std::sort(to_remove.begin(), to_remove.end());
+    to_remove.erase(std::unique(to_remove.begin(), to_remove.end()), to_remove.end());
+    for(const BinaryClause& bin: to_remove) {
+        extra_time += solver->watches[bin.getLit1()].size()/4;
+        extra_time += solver->watches[bin.getLit2()].size()/4;
+        removeWBin(solver->watches, bin.getLit1(), bin.getLit2(), bin.isRed());
+        removeWBin(solver->watches, bin.getLit2(), bin.getLit1(), bin.isRed());
+        if (bin.isRed()) {
+            solver->binTri.redBins--;
+            runStats.removedRed++;
+        } else {
+            solver->binTri.irredBins--;
+            runStats.removedIrred++;
+        }
+        *solver->drat << del << bin.getLit1() << bin.getLit2() << fin;
+    }
+    to_remove.clear();
+}
+
+size_t TransRed::mem_used() const
+{
+    size_t mem = 0;
+    mem += lits.capacity()*sizeof(uint32_t);
+    mem += lit_edge_at.capacity()*sizeof(uint32_t);
+    mem += lit_edges.capacity()*sizeof(Edge);
+    mem += part.capacity()*sizeof(uint32_t);
+    mem += comp.capacity()*sizeof(uint32_t);
+    mem += comp_edge_at.capacity()*sizeof(uint32_t);
+    mem += comp_edges.capacity()*sizeof(Edge);
+    mem += part_start.capacity()*sizeof(uint32_t);
+    mem += reach.capacity()*sizeof(uint64_t);
+    mem += mark.capacity()*sizeof(uint32_t);
+    mem += index.capacity()*sizeof(uint32_t);
+    mem += lowlink.capacity()*sizeof(uint32_t);
+    mem += stack.capacity()*sizeof(uint32_t);
+    mem += stackIndicator.capacity()*sizeof(char);
+    mem += frames.capacity()*sizeof(Frame);
+    mem += to_remove.capacity()*sizeof(BinaryClause);
+    return mem;
+}
+
+TransRed::Stats& TransRed::Stats::operator+=(const Stats& other)
+{
+    cpu_time += other.cpu_time;
+    numCalls += other.numCalls;
+    timeOut += other.timeOut;
+    edges += other.edges;
+    comps += other.comps;
+    windows += other.windows;
+    removedIrred += other.removedIrred;
+    removedRed += other.removedRed;
+
+    return *this;
+}
+
+void TransRed::Stats::print_short(
+    const Solver* solver
+    , const bool time_out
+    , const double time_remain
+) const {
+    cout
+    << "c [trans-red]"
+    << " rem-irred: " << removedIrred
+    << " rem-red: " << removedRed
+    << " comps: " << comps
+    << " edges: " << edges
+    << " windows: " << windows
+    << solver->conf.print_times(cpu_time, time_out, time_remain)
+    << endl;
+}
+
+void TransRed::Stats::print() const
+{
+    cout << "c -------- TRANS-RED STATS --------" << endl;
+    print_stats_line("c time"
+        , cpu_time
+        , ratio_for_stat(cpu_time, numCalls)
+        , "per call"
+    );
+
+    print_stats_line("c timed out"
+        , timeOut
+        , stats_line_percent(timeOut, numCalls)
+        , "% of calls"
+    );
+
+    print_stats_line("c removed irred bins"
+        , removedIrred
+    );
+
+    print_stats_line("c removed red bins"
+        , removedRed
+    );
+
+    print_stats_line("c components/edges/windows"
+        , comps
+        , edges
+        , windows
+    );
+    cout << "c -------- TRANS-RED STATS END --------" << endl;
+}
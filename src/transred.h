@@ -0,0 +1,158 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __TRANSRED_H__
+#define __TRANSRED_H__
+
+#include <vector>
+#include "constants.h"
+#include "solvertypes.h"
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Transitive reduction of the binary implication graph
+
+The binary clauses are copied into a CSR graph and condensed with Tarjan.
+The components are numbered topologically, with each weakly connected part
+of the graph in one contiguous range. An edge between two components is
+redundant if its target is also reachable through another successor of its
+source. This is found with bitsets of reachability, restricted to a window
+of target components at a time, so dense parts of the graph are handled
+64 components per word. Sparse parts are searched instead, cut at the
+topological index of the last successor. Edges inside a component are left
+to VarReplacer.
+
+The irredundant graph is reduced first, then the redundant binaries are
+removed if the whole graph still implies them
+*/
+class TransRed {
+    public:
+        TransRed(Solver* solver);
+        bool reduce();
+
+        struct Stats
+        {
+            void clear()
+            {
+                Stats tmp;
+                *this = tmp;
+            }
+
+            Stats& operator+=(const Stats& other);
+            void print_short(const Solver* solver, const bool time_out, const double time_remain) const;
+            void print() const;
+
+            double cpu_time = 0;
+            uint64_t numCalls = 0;
+            uint64_t timeOut = 0;
+            uint64_t edges = 0;
+            uint64_t comps = 0;
+            uint64_t windows = 0;
+            uint64_t removedIrred = 0;
+            uint64_t removedRed = 0;
+        };
+
+        const Stats& get_stats() const;
+        size_t mem_used() const;
+
+    private:
+        struct Edge {
+            Lit lit1; ///<Clause of the edge, lit1 < lit2
+            Lit lit2;
+            uint32_t to; ///<Topological index of the target component
+            bool red;
+
+            bool operator<(const Edge& other) const
+            {
+                if (to != other.to) return to < other.to;
+                if (red != other.red) return !red;
+                if (lit1 != other.lit1) return lit1 < other.lit1;
+                return lit2 < other.lit2;
+            }
+        };
+
+        struct Frame {
+            uint32_t lit;
+            uint32_t at; ///<Next edge to visit
+        };
+
+        void reduce_graph(const bool with_red);
+        void build_graph(const bool with_red);
+        uint32_t find_part(uint32_t lit);
+        void tarjan();
+        void build_comp_graph();
+        void reduce_window(const uint32_t begin, const uint32_t lo, const uint32_t hi, const uint32_t words, const bool with_red);
+        void reduce_sparse(const uint32_t begin, const uint32_t end, const bool with_red);
+        void redundant(const uint32_t first, const uint32_t at, const bool with_red);
+        void remove_bins();
+        bool out_of_time() const;
+
+        Solver* solver;
+
+        //Implication graph over literals
+        vector<uint32_t> lits; ///<Literals with at least one edge
+        vector<uint32_t> lit_edge_at; ///<Edges of literal 'l' are in lit_edges[lit_edge_at[l], lit_edge_at[l+1])
+        vector<Edge> lit_edges; ///<'to' is the target literal here
+        vector<uint32_t> part; ///<Union-find of the weakly connected parts
+
+        //Condensed graph, in topological order
+        uint32_t num_comps;
+        vector<uint32_t> comp; ///<Per literal, topological index of its component
+        vector<uint32_t> comp_edge_at;
+        vector<Edge> comp_edges; ///<Only between components, sorted by target
+        vector<uint32_t> part_start; ///<Per component, the first component of its weakly connected part
+        vector<uint64_t> reach; ///<Per component, the window's components it reaches
+        vector<uint32_t> mark; ///<Per component, 'stamp' if reached by the current search
+        uint32_t stamp;
+
+        //Tarjan
+        vector<uint32_t> index;
+        vector<uint32_t> lowlink;
+        vector<uint32_t> stack;
+        vector<char> stackIndicator;
+        vector<Frame> frames;
+
+        vector<BinaryClause> to_remove;
+        static const uint64_t max_reach_words = 2ULL*1000ULL*1000ULL;
+
+        //Limits
+        uint64_t max_props;
+        uint64_t orig_bogoprops;
+        uint64_t extra_time;
+
+        Stats runStats;
+        Stats globalStats;
+};
+
+inline const TransRed::Stats& TransRed::get_stats() const
+{
+    return globalStats;
+}
+
+} //end namespace
+
+#endif //__TRANSRED_H__
@@ -26,11 +26,14 @@ THE SOFTWARE.
 #include "constants.h"
 #include "propby.h"
 #include "avgcalc.h"
+#include "solvertypes.h"
+#include "simplefile.h"
 
 namespace CMSat
 {
 using namespace CMSat;
 
+///Per-variable data needed during propagation and conflict analysis
 struct VarData
 {
     ///contains the decision level at which the assignment was made.
@@ -38,13 +41,127 @@ struct VarData
 
     //Reason this got propagated. NULL means decision/toplevel
     PropBy reason = PropBy();
+};
+
+/**
+@brief The rest of the per-variable data
+
+Kept apart from VarData so that conflict analysis only touches level and
+reason. How the variable was removed (var-elim, different component, etc.)
+and whether it's a BVA variable are packed into 4 bits per variable: bits
+0-1 and bit 3. The preferred polarity is written on every enqueue, so it
+has a byte per variable of its own, avoiding a read-modify-write.
+*/
+class VarFlags
+{
+public:
+    Removed removed(const uint32_t var) const
+    {
+        return static_cast<Removed>(get(var) & 3);
+    }
+
+    void set_removed(const uint32_t var, const Removed rem)
+    {
+        set(var, (get(var) & ~3) | static_cast<uint8_t>(rem));
+    }
+
+    bool polarity(const uint32_t var) const
+    {
+        assert(var < num);
+        return pols[var];
+    }
+
+    void set_polarity(const uint32_t var, const bool pol)
+    {
+        assert(var < num);
+        pols[var] = pol;
+    }
+
+    bool is_bva(const uint32_t var) const
+    {
+        return get(var) & 8;
+    }
+
+    void set_is_bva(const uint32_t var, const bool bva)
+    {
+        set(var, (get(var) & ~8) | (bva << 3));
+    }
+
+    size_t size() const
+    {
+        return num;
+    }
+
+    bool empty() const
+    {
+        return num == 0;
+    }
+
+    ///New variables are not removed, have polarity false and are not BVA
+    void resize(const size_t new_num)
+    {
+        num = new_num;
+        data.resize((num+1)/2, 0);
+        if (num % 2) {
+            data.back() &= 0xf;
+        }
+        pols.resize(num, 0);
+    }
+
+    void swap(const uint32_t a, const uint32_t b)
+    {
+        const uint8_t tmp = get(a);
+        set(a, get(b));
+        set(b, tmp);
+        std::swap(pols[a], pols[b]);
+    }
+
+    ///Same as updateArray()
+    void update_vars(const vector<uint32_t>& mapper)
+    {
+        const VarFlags backup = *this;
+        for(size_t i = 0; i < num; i++) {
+            set(i, backup.get(mapper.at(i)));
+            pols[i] = backup.pols[mapper.at(i)];
+        }
+    }
+
+    size_t mem_used() const
+    {
+        return data.capacity()*sizeof(uint8_t) + pols.capacity()*sizeof(uint8_t);
+    }
+
+    void save_state(SimpleOutFile& f) const
+    {
+        f.put_uint64_t(num);
+        f.put_vector(data);
+        f.put_vector(pols);
+    }
+
+    void load_state(SimpleInFile& f)
+    {
+        num = f.get_uint64_t();
+        f.get_vector(data);
+        f.get_vector(pols);
+    }
+
+private:
+    uint8_t get(const uint32_t var) const
+    {
+        assert(var < num);
+        return (data[var/2] >> ((var%2)*4)) & 0xf;
+    }
 
-    ///The preferred polarity of each variable.
-    bool polarity = false;
+    void set(const uint32_t var, const uint8_t val)
+    {
+        assert(var < num);
+        const uint32_t shift = (var%2)*4;
+        data[var/2] = (data[var/2] & ~(0xf << shift)) | (val << shift);
+    }
 
-    ///Whether var has been eliminated (var-elim, different component, etc.)
-    Removed removed = Removed::none;
-    bool is_bva = false;
+    vector<uint8_t> data;
+    vector<uint8_t> pols;
+    size_t num = 0;
 };
 
 }
@@ -69,12 +69,12 @@ void VarReplacer::check_no_replaced_var_set() const
 {
     for(uint32_t var = 0; var < solver->nVarsOuter(); var++) {
         if (solver->value(var) != l_Undef) {
-            if (solver->varData[var].removed != Removed::none)
+            if (solver->varFlags.removed(var) != Removed::none)
             {
                 cout << "ERROR: var " << var + 1 << " has removed: "
-                << removed_type_to_string(solver->varData[var].removed)
+                << removed_type_to_string(solver->varFlags.removed(var))
                 << " but is set to " << solver->value(var) << endl;
-                assert(solver->varData[var].removed == Removed::none);
+                assert(solver->varFlags.removed(var) == Removed::none);
                 exit(-1);
             }
         }
@@ -98,6 +98,8 @@ void VarReplacer::updateVars(
     const std::vector< uint32_t >& /*outerToInter*/
     , const std::vector< uint32_t >& /*interToOuter*/
 ) {
+    //The SCC finder's dirty variables are in the old numbering
+    scc_finder->set_all_dirty();
 
     /*updateArray(table, interToOuter);
     updateLitsMap(table, outerToInter);
@@ -131,21 +133,21 @@ void VarReplacer::update_vardata_and_activities(
 ) {
     //Not replaced_with, or not replaceable, so skip
     if (orig == replaced_with
-        || solver->varData[replaced_with].removed == Removed::decomposed
-        || solver->varData[replaced_with].removed == Removed::elimed
+        || solver->varFlags.removed(replaced_with) == Removed::decomposed
+        || solver->varFlags.removed(replaced_with) == Removed::elimed
     ) {
         return;
     }
 
     //Has already been handled previously, just skip
-    if (solver->varData[orig].removed == Removed::replaced) {
+    if (solver->varFlags.removed(orig) == Removed::replaced) {
         return;
     }
 
     //Okay, so unset decision, and set the other one decision
     assert(orig != replaced_with);
-    solver->varData[orig].removed = Removed::replaced;
-    assert(solver->varData[replaced_with].removed == Removed::none);
+    solver->varFlags.set_removed(orig, Removed::replaced);
+    assert(solver->varFlags.removed(replaced_with) == Removed::none);
     assert(solver->value(replaced_with) == l_Undef);
 
     double orig_act = solver->activ_glue[orig];
@@ -529,7 +531,7 @@ bool VarReplacer::handleUpdatedClause(
     uint32_t i, j;
     const uint32_t origSize = c.size();
     for (i = j = 0, p = lit_Undef; i != origSize; i++) {
-        assert(solver->varData[c[i].var()].removed == Removed::none);
+        assert(solver->varFlags.removed(c[i].var()) == Removed::none);
         if (solver->value(c[i]) == l_True || c[i] == ~p) {
             satisfied = true;
             break;
@@ -615,12 +617,15 @@ bool VarReplacer::handleUpdatedClause(
     release_assert(false);
 }
 
-void VarReplacer::set_sub_var_during_solution_extension(uint32_t var, const uint32_t sub_var)
-{
+void VarReplacer::set_sub_var_during_solution_extension(
+    uint32_t var
+    , const uint32_t sub_var
+    , const bool overwrite
+) {
     const lbool to_set = solver->model[var] ^ table[sub_var].sign();
     const uint32_t sub_var_inter = solver->map_outer_to_inter(sub_var);
-    assert(solver->varData[sub_var_inter].removed == Removed::replaced);
-    assert(solver->model_value(sub_var) == l_Undef);
+    assert(solver->varFlags.removed(sub_var_inter) == Removed::replaced);
+    assert(overwrite || solver->model_value(sub_var) == l_Undef);
 
     if (solver->conf.verbosity > 10) {
         cout << "Varreplace-extend: setting outer " << sub_var+1
@@ -630,7 +635,9 @@ void VarReplacer::set_sub_var_during_solution_extension(uint32_t var, const uint
 }
 
 //NOTE: 'var' is OUTER
-void VarReplacer::extend_model(const uint32_t var)
+//If 'overwrite' is set, the sub-vars may already be set, e.g. because 'var'
+//has been flipped, and they are set again to follow 'var'
+void VarReplacer::extend_model(const uint32_t var, const bool overwrite)
 {
     assert(solver->model[var] != l_Undef);
     auto it = reverseTable.find(var);
@@ -640,7 +647,7 @@ void VarReplacer::extend_model(const uint32_t var)
     assert(it->first == var);
     for(const uint32_t sub_var: it->second)
     {
-        set_sub_var_during_solution_extension(var, sub_var);
+        set_sub_var_during_solution_extension(var, sub_var, overwrite);
     }
 }
 
@@ -687,8 +694,8 @@ void VarReplacer::replaceChecks(const uint32_t var1, const uint32_t var2) const
     assert(solver->value(var1) == l_Undef);
     assert(solver->value(var2) == l_Undef);
 
-    assert(solver->varData[var1].removed == Removed::none);
-    assert(solver->varData[var2].removed == Removed::none);
+    assert(solver->varFlags.removed(var1) == Removed::none);
+    assert(solver->varFlags.removed(var2) == Removed::none);
 }
 
 bool VarReplacer::handleAlreadyReplaced(const Lit lit1, const Lit lit2)
@@ -790,8 +797,8 @@ bool VarReplacer::replace(
     << lit1 << ~lit2 << fin;
 
     //None should be removed, only maybe queued for replacement
-    assert(solver->varData[lit1.var()].removed == Removed::none);
-    assert(solver->varData[lit2.var()].removed == Removed::none);
+    assert(solver->varFlags.removed(lit1.var()) == Removed::none);
+    assert(solver->varFlags.removed(lit2.var()) == Removed::none);
 
     const lbool val1 = solver->value(lit1);
     const lbool val2 = solver->value(lit2);
@@ -863,8 +870,8 @@ void VarReplacer::checkUnsetSanity()
         const Lit repLit = get_lit_replaced_with(Lit(i, false));
         const uint32_t repVar = get_var_replaced_with(i);
 
-        if (solver->varData[i].removed == Removed::none
-            && solver->varData[repVar].removed == Removed::none
+        if (solver->varFlags.removed(i) == Removed::none
+            && solver->varFlags.removed(repVar) == Removed::none
             && solver->value(i) != solver->value(repLit)
         ) {
             cout
@@ -1159,4 +1166,7 @@ void VarReplacer::load_state(SimpleInFile& f)
         f.get_vector(point_to);
         reverseTable[v] = point_to;
     }
+
+    //Binary clauses were loaded without telling the SCC finder
+    scc_finder->set_all_dirty();
 }
@@ -57,10 +57,11 @@ class VarReplacer
         void print_equivalent_literals(std::ostream *os) const;
         void print_some_stats(const double global_cpu_time) const;
         const SCCFinder* get_scc_finder() const;
+        SCCFinder* get_scc_finder();
 
         void extend_model_already_set();
         void extend_model_set_undef();
-        void extend_model(const uint32_t var);
+        void extend_model(const uint32_t var, const bool overwrite = false);
 
         uint32_t get_var_replaced_with(const uint32_t var) const;
         uint32_t get_var_replaced_with(const Lit lit) const;
@@ -138,7 +139,7 @@ class VarReplacer
         bool isReplaced_fast(const Lit lit) const;
 
         size_t getNumTrees() const;
-        void set_sub_var_during_solution_extension(uint32_t var, uint32_t sub_var);
+        void set_sub_var_during_solution_extension(uint32_t var, uint32_t sub_var, bool overwrite = false);
         void checkUnsetSanity();
 
         bool replace_set(vector<ClOffset>& cs);
@@ -296,6 +297,11 @@ inline const SCCFinder* VarReplacer::get_scc_finder() const
     return scc_finder;
 }
 
+inline SCCFinder* VarReplacer::get_scc_finder()
+{
+    return scc_finder;
+}
+
 inline Lit VarReplacer::get_lit_replaced_with_outer(Lit lit) const
 {
     Lit lit2 = table[lit.var()] ^ lit.sign();
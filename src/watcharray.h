@@ -26,22 +26,94 @@ THE SOFTWARE.
 
 #include "watched.h"
 #include "Vec.h"
+#include "smallvec.h"
 #include <vector>
 
 namespace CMSat {
 using namespace CMSat;
 using std::vector;
 
-typedef vec<Watched>& watch_subarray;
-typedef const vec<Watched>& watch_subarray_const;
+//Watch lists with at most this many entries are stored in the watch array
+//itself, needing no separate allocation. With 1, the inline entry shares
+//space with the heap pointer, so a slot is as small as a vec<Watched>
+#ifndef WATCH_INLINE_SIZE
+#define WATCH_INLINE_SIZE 1
+#endif
+
+typedef smallvec<Watched, WATCH_INLINE_SIZE> watch_list;
+typedef watch_list& watch_subarray;
+typedef const watch_list& watch_subarray_const;
 
 class watch_array
 {
 public:
-    vec<vec<Watched> > watches;
+    watch_array()
+    {}
+
+    ~watch_array()
+    {
+        release_pool();
+    }
+
+    vec<watch_list> watches;
     vector<Lit> smudged_list;
     vector<char> smudged;
 
+    /**
+    @brief Lays out the watch lists back-to-back in a single allocation
+
+    Watch list i gets space for its current elements plus extra[i] more,
+    compressed-sparse-row style. A list that grows beyond that moves to its
+    own memory, so this is only a hint.
+    */
+    void reserve_pooled(const vector<uint32_t>& extra)
+    {
+        assert(extra.size() == watches.size());
+        release_pool();
+
+        size_t total = 0;
+        for(size_t i = 0; i < watches.size(); i++) {
+            const size_t need = (size_t)watches[i].size() + extra[i];
+            if (need > WATCH_INLINE_SIZE) {
+                total += need;
+            }
+        }
+        if (total == 0) {
+            return;
+        }
+
+        pool = (Watched*)malloc(total*sizeof(Watched));
+        if (pool == NULL) {
+            throw std::bad_alloc();
+        }
+        pool_size = total;
+
+        Watched* at = pool;
+        for(size_t i = 0; i < watches.size(); i++) {
+            const size_t need = (size_t)watches[i].size() + extra[i];
+            if (need > WATCH_INLINE_SIZE) {
+                watches[i].borrow(at, need);
+                at += need;
+            }
+        }
+        assert(at == pool + total);
+    }
+
+    ///Moves all watch lists to their own memory and frees the pool
+    void release_pool()
+    {
+        if (pool == NULL) {
+            return;
+        }
+
+        for(watch_list& ws: watches) {
+            ws.unborrow();
+        }
+        free(pool);
+        pool = NULL;
+        pool_size = 0;
+    }
+
     void smudge(const Lit lit) {
         if (!smudged[lit.toInt()]) {
             smudged_list.push_back(lit);
@@ -97,13 +169,14 @@ public:
 
     size_t mem_used() const
     {
-        double mem = watches.capacity()*sizeof(vec<Watched>);
+        double mem = watches.capacity()*sizeof(watch_list);
         for(size_t i = 0; i < watches.size(); i++) {
             //1.2 is overhead
-            mem += (double)watches[i].capacity()*(double)sizeof(Watched)*1.2;
+            mem += (double)watches[i].mem_used_heap()*1.2;
         }
         mem += smudged.capacity()*sizeof(char);
         mem += smudged_list.capacity()*sizeof(Lit);
+        mem += pool_size*sizeof(Watched);
         return mem;
     }
 
@@ -114,10 +187,10 @@ public:
 
     void prefetch(const size_t at) const
     {
-        __builtin_prefetch(watches[at].data);
+        __builtin_prefetch(watches[at].begin());
     }
-    typedef vec<Watched>* iterator;
-    typedef const vec<Watched>* const_iterator;
+    typedef watch_list* iterator;
+    typedef const watch_list* const_iterator;
 
     iterator begin()
     {
@@ -155,8 +228,9 @@ public:
     {
         size_t mem = 0;
         for(auto& ws: watches) {
-            mem += ws.capacity()*sizeof(Watched);
+            mem += ws.mem_used_heap();
         }
+        mem += pool_size*sizeof(Watched);
 
         return mem;
     }
@@ -164,10 +238,18 @@ public:
     size_t mem_used_array() const
     {
         size_t mem = 0;
-        mem += watches.capacity()*sizeof(vector<Watched>);
+        mem += watches.capacity()*sizeof(watch_list);
         mem += sizeof(watch_array);
         return mem;
     }
+
+private:
+    //Don't allow copying, the lists may point into the pool
+    watch_array(const watch_array&);
+    watch_array& operator=(const watch_array&);
+
+    Watched* pool = NULL;
+    size_t pool_size = 0;
 };
 
 inline void swap(watch_subarray a, watch_subarray b)
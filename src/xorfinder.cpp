@@ -160,7 +160,7 @@ void XorFinder::add_xors_to_gauss()
     #ifdef SLOW_DEBUG
     for(const Xor& x: xors) {
         for(uint32_t v: x) {
-            assert(solver->varData[v].removed == Removed::none);
+            assert(solver->varFlags.removed(v) == Removed::none);
         }
     }
     #endif
@@ -197,7 +197,7 @@ void XorFinder::findXor(vector<Lit>& lits, const ClOffset offset, cl_abst_type a
         Xor found_xor(lits, poss_xor.getRHS());
         #ifdef SLOW_DEBUG
         for(Lit lit: lits) {
-            assert(solver->varData[lit.var()].removed == Removed::none);
+            assert(solver->varFlags.removed(lit.var()) == Removed::none);
         }
         #endif
 
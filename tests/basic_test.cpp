@@ -23,9 +23,11 @@ THE SOFTWARE.
 #include "gtest/gtest.h"
 
 #include <fstream>
+#include <random>
 
 #include "cryptominisat5/cryptominisat.h"
 #include "src/solverconf.h"
+#include "src/solver.h"
 using namespace CMSat;
 #include <vector>
 using std::vector;
@@ -188,6 +190,191 @@ TEST(normal_interface, logfile2_assumps)
     EXPECT_EQ(line, "c Solver::solve( -2 )");
 }
 
+static void add_random_3sat(SATSolver& s, uint32_t num_vars, uint32_t num_cls)
+{
+    std::mt19937 mtrand(1);
+    s.new_vars(num_vars);
+    for(uint32_t i = 0; i < num_cls; i++) {
+        vector<Lit> cl;
+        for(uint32_t i2 = 0; i2 < 3; i2++) {
+            cl.push_back(Lit(mtrand() % num_vars, mtrand() % 2));
+        }
+        s.add_clause(cl);
+    }
+}
+
+TEST(normal_interface, max_memory_ok)
+{
+    SATSolver s;
+    s.set_max_memory(1000);
+    add_random_3sat(s, 50, 150);
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+}
+
+TEST(normal_interface, max_memory_exceeded)
+{
+    SATSolver s;
+    s.set_max_memory(1);
+    add_random_3sat(s, 20000, 85000);
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_Undef);
+    EXPECT_EQ( s.okay(), true);
+}
+
+TEST(normal_interface, max_memory_steps_undone)
+{
+    SolverConf conf;
+    std::atomic<bool> must_inter(false);
+    Solver s(&conf, &must_inter);
+    std::mt19937 mtrand(1);
+    s.new_vars(1000);
+    for(uint32_t i = 0; i < 3000; i++) {
+        vector<Lit> cl;
+        for(uint32_t i2 = 0; i2 < 3; i2++) {
+            cl.push_back(Lit(mtrand() % 1000, mtrand() % 2));
+        }
+        s.add_clause_outer(cl);
+    }
+    const unsigned occ_mb = s.conf.maxOccurIrredMB;
+
+    //Over the soft limit, but well within the budget
+    s.conf.maxMemMB = 1000;
+    s.conf.mem_budget_soft_ratio = 0;
+    EXPECT_TRUE(s.enforce_mem_budget());
+    EXPECT_FALSE(s.conf.doCache);
+    EXPECT_LT(s.conf.maxOccurIrredMB, occ_mb);
+
+    //Undone one by one once back under
+    s.conf.mem_budget_soft_ratio = 0.9;
+    EXPECT_TRUE(s.enforce_mem_budget());
+    EXPECT_EQ(s.conf.maxOccurIrredMB, occ_mb);
+    EXPECT_FALSE(s.conf.doCache);
+    EXPECT_TRUE(s.enforce_mem_budget());
+    EXPECT_TRUE(s.conf.doCache);
+    EXPECT_EQ(s.solve_with_assumptions(), l_True);
+}
+
+TEST(normal_interface, blocked_clause_readded)
+{
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    conf.simplify_schedule_startup = "occ-bce";
+    SATSolver s(&conf);
+
+    s.new_vars(3);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false), Lit(2, false)});
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+    EXPECT_TRUE( s.get_model()[0] == l_True
+        || s.get_model()[1] == l_True
+        || s.get_model()[2] == l_True);
+
+    s.add_clause(vector<Lit>{Lit(0, true)});
+    s.add_clause(vector<Lit>{Lit(1, true)});
+    s.add_clause(vector<Lit>{Lit(2, true)});
+    ret = s.solve();
+    EXPECT_EQ( ret, l_False);
+}
+
+TEST(normal_interface, blocked_clause_assumps)
+{
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    conf.simplify_schedule_startup = "occ-cce";
+    SATSolver s(&conf);
+
+    s.new_vars(4);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false), Lit(2, false)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(1, false), Lit(3, false)});
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+
+    vector<Lit> assumps{Lit(1, true), Lit(2, true), Lit(3, true)};
+    ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_False);
+
+    assumps = vector<Lit>{Lit(1, true), Lit(2, true)};
+    ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ( s.get_model()[0], l_True);
+}
+
+TEST(normal_interface, blocked_clause_covered_many_resolvents)
+{
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    conf.simplify_schedule_startup = "occ-backw-sub-str, occ-cce";
+    SATSolver s(&conf);
+
+    s.new_vars(5);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false), Lit(2, false)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(3, false), Lit(4, false)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(4, false), Lit(1, false)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(4, false), Lit(1, true)});
+
+    //Covered literal addition must intersect all three resolvents on 1
+    vector<Lit> assumps{Lit(1, true), Lit(2, true), Lit(4, true)};
+    lbool ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_False);
+
+    assumps = vector<Lit>{Lit(1, true), Lit(2, true)};
+    ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ( s.get_model()[0], l_True);
+    EXPECT_EQ( s.get_model()[4], l_True);
+}
+
+//A clause blocked on a variable that replaces others: extending the model
+//may flip the variable, and the replaced ones must follow it
+TEST(normal_interface, blocked_clause_on_replaced_var)
+{
+    for(uint32_t seed = 0; seed < 30; seed++) {
+        SolverConf conf;
+        conf.simplify_at_startup = true;
+        conf.simplify_schedule_startup = "scc-vrepl, occ-bce, occ-cce";
+        conf.simplify_schedule_nonstartup = "scc-vrepl, occ-bce, occ-bve";
+        SATSolver s(&conf);
+        std::mt19937 mtrand(seed);
+
+        const uint32_t num_vars = 30;
+        s.new_vars(num_vars);
+        vector<vector<Lit> > cls;
+        for(uint32_t round = 0; round < 4; round++) {
+            const size_t start = cls.size();
+            for(uint32_t i = 0; i < 10; i++) {
+                const Lit a = Lit(mtrand() % num_vars, mtrand() % 2);
+                const Lit b = Lit(mtrand() % num_vars, mtrand() % 2);
+                if (a.var() == b.var()) {
+                    continue;
+                }
+                if (mtrand() % 3 == 0) {
+                    cls.push_back(vector<Lit>{a, b});
+                    cls.push_back(vector<Lit>{~a, ~b});
+                } else {
+                    cls.push_back(vector<Lit>{a, b, Lit(mtrand() % num_vars, mtrand() % 2)});
+                }
+            }
+            for(size_t i = start; i < cls.size(); i++) {
+                s.add_clause(cls[i]);
+            }
+
+            const lbool ret = s.solve();
+            if (ret == l_False) {
+                break;
+            }
+            ASSERT_EQ(ret, l_True);
+            for(const vector<Lit>& cl: cls) {
+                bool sat = false;
+                for(const Lit l: cl) {
+                    sat |= s.get_model()[l.var()] == (l.sign() ? l_False : l_True);
+                }
+                EXPECT_TRUE(sat);
+            }
+        }
+    }
+}
+
 bool is_critical(const std::range_error&) { return true; }
 
 TEST(xor_interface, xor_check_sat_solution)
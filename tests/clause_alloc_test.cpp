@@ -0,0 +1,256 @@
+/******************************************
+Copyright (c) 2014, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/clauseallocator.h"
+#include "src/solver.h"
+#include <vector>
+
+using namespace CMSat;
+#include "test_helper.h"
+
+struct alloc : public ::testing::Test {
+    Clause* new_cl(const vector<Lit>& lits)
+    {
+        return cl_alloc.Clause_new(lits
+        #ifdef STATS_NEEDED
+        , 0
+        , 0
+        #endif
+        );
+    }
+
+    vector<Lit> make_lits(size_t n)
+    {
+        vector<Lit> lits;
+        for(size_t i = 0; i < n ; i++) {
+            lits.push_back(Lit(i, i&1));
+        }
+        return lits;
+    }
+
+    ClauseAllocator cl_alloc;
+};
+
+TEST_F(alloc, offset_roundtrip)
+{
+    vector<ClOffset> offs;
+    for(size_t i = 3; i < 50; i++) {
+        Clause* cl = new_cl(make_lits(i));
+        offs.push_back(cl_alloc.get_offset(cl));
+        EXPECT_EQ(cl_alloc.ptr(offs.back()), cl);
+    }
+
+    for(size_t i = 0; i < offs.size(); i++) {
+        const Clause& cl = *cl_alloc.ptr(offs[i]);
+        EXPECT_EQ(cl.size(), i+3);
+        EXPECT_EQ(cl[cl.size()-1], Lit(i+2, (i+2)&1));
+    }
+}
+
+TEST_F(alloc, offset_fits_watch)
+{
+    Clause* cl = new_cl(make_lits(10));
+    Clause* cl2 = new_cl(make_lits(5));
+    const ClOffset off = cl_alloc.get_offset(cl2);
+    Watched w(off, Lit(3, false));
+    EXPECT_EQ(w.get_offset(), off);
+    EXPECT_EQ(cl_alloc.ptr(w.get_offset()), cl2);
+    EXPECT_NE(cl, cl2);
+}
+
+struct incremental : public ::testing::Test {
+    incremental()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.doCache = false;
+        conf.doIncrementalConsolidate = true;
+        conf.verbosity = 0;
+        s = new Solver(&conf, &must_inter);
+        s->new_vars(60);
+    }
+    ~incremental()
+    {
+        delete s;
+    }
+
+    //Enough 30-long clauses to fill multiple chunks
+    void add_many(size_t num, uint32_t seed)
+    {
+        for(size_t i = 0; i < num; i++) {
+            vector<Lit> cl;
+            for(uint32_t v = 0; v < 30; v++) {
+                cl.push_back(Lit(v*2 + ((i+v+seed)%7 == 0), (i >> (v%16)) & 1));
+            }
+            s->add_clause_outer(cl);
+        }
+    }
+
+    //Removes 3 out of every 4 clauses
+    void remove_most()
+    {
+        vector<ClOffset> keep;
+        for(size_t i = 0; i < s->longIrredCls.size(); i++) {
+            const ClOffset offs = s->longIrredCls[i];
+            if (i % 4 == 0) {
+                keep.push_back(offs);
+            } else {
+                s->detachClause(offs);
+                s->cl_alloc.clauseFree(offs);
+            }
+        }
+        s->longIrredCls = keep;
+    }
+
+    void check_watches() const
+    {
+        for(uint32_t i = 0; i < s->nVars()*2; i++) {
+            const Lit lit = Lit::toLit(i);
+            for(const Watched& w: s->watches[lit]) {
+                if (!w.isClause()) {
+                    continue;
+                }
+                const Clause& cl = *s->cl_alloc.ptr(w.get_offset());
+                EXPECT_FALSE(cl.freed());
+                EXPECT_FALSE(cl.reloced);
+                EXPECT_TRUE(cl[0] == lit || cl[1] == lit);
+            }
+        }
+    }
+
+    Solver* s = NULL;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(incremental, evacuates_and_reuses)
+{
+    add_many(40000, 0);
+    remove_most();
+    vector<vector<Lit> > before = get_irred_cls(s);
+    s->cl_alloc.consolidate(s);
+    const size_t free_chunks = s->cl_alloc.num_free_chunks();
+    EXPECT_GT(free_chunks, 0U);
+    EXPECT_EQ(s->cl_alloc.num_stale_spills(), 0U);
+    vector<vector<Lit> > after = get_irred_cls(s);
+    check_fuzzy_equal(before, after);
+    check_watches();
+
+    //Reuse
+    add_many(1000, 3);
+    EXPECT_LT(s->cl_alloc.num_free_chunks(), free_chunks);
+    check_watches();
+
+    //Forced consolidation is full
+    s->cl_alloc.consolidate(s, true);
+    EXPECT_EQ(s->cl_alloc.num_free_chunks(), 0U);
+    check_watches();
+}
+
+TEST_F(incremental, shrink_to_empty_then_grow)
+{
+    add_many(1000, 0);
+    for(ClOffset offs: s->longIrredCls) {
+        s->detachClause(offs);
+        s->cl_alloc.clauseFree(offs);
+    }
+    s->longIrredCls.clear();
+    s->cl_alloc.consolidate(s, true);
+    EXPECT_EQ(get_irred_cls(s).size(), 0U);
+
+    add_many(1000, 3);
+    EXPECT_EQ(s->longIrredCls.size(), 1000U);
+    check_watches();
+}
+
+TEST_F(incremental, nothing_to_do)
+{
+    add_many(40000, 0);
+    s->cl_alloc.consolidate(s);
+    EXPECT_EQ(s->cl_alloc.num_free_chunks(), 0U);
+    check_watches();
+}
+
+TEST_F(incremental, locality_puts_hot_red_first)
+{
+    add_many(20000, 0);
+    for(size_t i = 0; i < 50; i++) {
+        vector<Lit> cl;
+        for(uint32_t v = 0; v < 10; v++) {
+            cl.push_back(Lit(v*3 + i%3, (i >> v) & 1));
+        }
+        s->add_clause_outer(cl, true);
+    }
+    for(auto& lredcls: s->longRedCls) {
+        for(ClOffset offs: lredcls) {
+            s->cl_alloc.ptr(offs)->stats.glue = 2;
+        }
+    }
+    std::swap(s->longRedCls[0], s->longRedCls[1]);
+    s->longRedCls[0].insert(s->longRedCls[0].end(), s->longRedCls[1].begin(), s->longRedCls[1].end());
+    s->longRedCls[1].clear();
+    ASSERT_EQ(s->longRedCls[0].size(), 50U);
+
+    vector<vector<Lit> > before = get_irred_cls(s);
+    s->conf.doLocalityConsolidate = true;
+    s->cl_alloc.consolidate(s, true);
+    vector<vector<Lit> > after = get_irred_cls(s);
+    check_fuzzy_equal(before, after);
+    check_watches();
+
+    ClOffset max_red = 0;
+    for(ClOffset offs: s->longRedCls[0]) {
+        max_red = std::max(max_red, offs);
+    }
+    for(ClOffset offs: s->longIrredCls) {
+        EXPECT_GT(offs, max_red);
+    }
+}
+
+#ifdef LARGE_OFFSETS
+//Needs more than 4GB of memory
+TEST_F(alloc, past_32bit_word_limit)
+{
+    const vector<Lit> lits = make_lits(64ULL*1024ULL*1024ULL);
+    const size_t old_limit_words = 1ULL << 30;
+    size_t words = 0;
+    ClOffset last = 0;
+    while(words <= old_limit_words) {
+        Clause* cl = new_cl(lits);
+        last = cl_alloc.get_offset(cl);
+        words = ((size_t)last << CL_OFFSET_SHIFT) + lits.size() + sizeof(Clause)/sizeof(uint32_t);
+    }
+
+    Watched w(last, lits[0]);
+    const Clause& cl = *cl_alloc.ptr(w.get_offset());
+    EXPECT_EQ(cl.size(), lits.size());
+    EXPECT_EQ(cl[0], lits[0]);
+    EXPECT_EQ(cl[lits.size()-1], lits.back());
+    EXPECT_GT(cl_alloc.mem_used(), old_limit_words*sizeof(uint32_t));
+}
+#endif
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
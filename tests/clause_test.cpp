@@ -45,7 +45,6 @@ struct F : public ::testing::Test {
         Clause* c_ptr = new(tmp) Clause(lits
         #ifdef STATS_NEEDED
         , 0
-        , 0
         #endif
         );
         return c_ptr;
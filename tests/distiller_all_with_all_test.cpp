@@ -151,6 +151,71 @@ TEST_F(distill_test, tri_transitive)
     check_irred_cls_contains(s, "1, 2");
 }
 
+//Learnt clauses
+
+TEST_F(distill_test, red_by1)
+{
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("1, -2"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"), true);
+
+    distill_all_with_all->distill_red(1);
+    check_red_cls_contains(s, "1, 3, 4");
+}
+
+TEST_F(distill_test, red_nodistill)
+{
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("-1, -2"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"), true);
+
+    distill_all_with_all->distill_red(1);
+    check_red_cls_contains(s, "1, 2, 3, 4");
+}
+
+TEST_F(distill_test, red_implied)
+{
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("1, 3"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"), true);
+
+    distill_all_with_all->distill_red(1);
+    check_red_cls_doesnt_contain(s, "1, 2, 3, 4");
+    EXPECT_EQ(s->longRedCls[0].size() + s->longRedCls[1].size(), 0u);
+}
+
+TEST_F(distill_test, red_irred_untouched)
+{
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("1, 3"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"));
+
+    distill_all_with_all->distill_red(1);
+    check_irred_cls_contains(s, "1, 2, 3, 4");
+}
+
+TEST_F(distill_test, red_keeps_list_order)
+{
+    s->new_vars(6);
+    s->add_clause_outer(str_to_cl("-1, -2"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"), true);
+    s->add_clause_outer(str_to_cl("1, 2, 4, 5"), true);
+    s->add_clause_outer(str_to_cl("1, 2, 5, 6"), true);
+
+    //Worst first, so distilling best-first would reverse them
+    vector<vector<ClOffset> > before;
+    for(const auto& lredcls: s->longRedCls) {
+        for(size_t i = 0; i < lredcls.size(); i++) {
+            s->cl_alloc.ptr(lredcls[i])->stats.glue = 10 - i;
+        }
+        before.push_back(lredcls);
+    }
+
+    distill_all_with_all->distill_red(1);
+    for(size_t i = 0; i < before.size(); i++) {
+        EXPECT_EQ(s->longRedCls[i], before[i]);
+    }
+}
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
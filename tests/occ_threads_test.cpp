@@ -0,0 +1,222 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <random>
+
+#include "src/solver.h"
+#include "src/solverconf.h"
+#include "src/occsimplifier.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+//Multi-threaded sub/str gives the same result as the serial one. Batched
+//BVE eliminates in a different order than serial BVE, but the result must
+//be equisatisfiable and must not depend on the number of threads
+struct occ_threads : public ::testing::Test {
+    occ_threads()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+    }
+    ~occ_threads()
+    {
+        delete serial;
+        delete par;
+        delete par2;
+    }
+
+    Solver* new_solver(const unsigned threads)
+    {
+        SolverConf conf;
+        conf.doCache = false;
+        conf.subsume_threads = threads;
+        conf.varelim_threads = threads;
+        conf.global_timeout_multiplier = 1000;
+        return new Solver(&conf, &must_inter);
+    }
+
+    //Random clauses, with many subsumed and strengthenable ones planted
+    void add_cls(const uint32_t num_vars, const size_t num_cls)
+    {
+        std::mt19937 rnd(7);
+        cls.clear();
+        while(cls.size() < num_cls) {
+            vector<Lit> cl;
+            if (!cls.empty() && rnd() % 3 == 0) {
+                cl = cls[rnd() % cls.size()];
+                if (rnd() % 2) {
+                    const size_t at = rnd() % cl.size();
+                    cl[at] = ~cl[at];
+                }
+            }
+            const size_t size = std::max<size_t>(cl.size() + 1, 3) + rnd() % 3;
+            while(cl.size() < size) {
+                const Lit lit = Lit(rnd() % num_vars, rnd() % 2);
+                bool dup = false;
+                for(const Lit l: cl) {
+                    dup |= l.var() == lit.var();
+                }
+                if (!dup) {
+                    cl.push_back(lit);
+                }
+            }
+            cls.push_back(cl);
+        }
+        add_to_both(num_vars);
+    }
+
+    //Random 3-SAT clauses, if planted then satisfied by a random assignment.
+    //Also, with a fresh x: (x V a) (-x V b) and (a V b V y) or (a V -b V y).
+    //x is cheap to eliminate, and its resolvent subsumes or strengthens a
+    //clause of y, which may be in the same batch
+    void add_3sat_cls(const uint32_t num_vars, const size_t num_cls, const bool planted)
+    {
+        std::mt19937 rnd(11);
+        vector<bool> sol;
+        for(uint32_t i = 0; i < num_vars; i++) {
+            sol.push_back(rnd() % 2);
+        }
+        const uint32_t num_gadgets = num_cls/10;
+
+        cls.clear();
+        while(cls.size() < num_cls) {
+            vector<Lit> cl;
+            bool sat = false;
+            while(cl.size() < 3) {
+                const Lit lit = Lit(rnd() % num_vars, rnd() % 2);
+                bool dup = false;
+                for(const Lit l: cl) {
+                    dup |= l.var() == lit.var();
+                }
+                if (!dup) {
+                    cl.push_back(lit);
+                    sat |= sol[lit.var()] != lit.sign();
+                }
+            }
+            if (sat || !planted) {
+                cls.push_back(cl);
+            }
+        }
+        for(uint32_t x = num_vars; x < num_vars + num_gadgets; x++) {
+            const uint32_t y = rnd() % num_vars;
+            const Lit a = Lit(rnd() % num_vars, false);
+            const Lit b = Lit(rnd() % num_vars, false);
+            if (a.var() == b.var() || a.var() == y || b.var() == y) {
+                continue;
+            }
+            const Lit true_a = a ^ !sol[a.var()];
+            const Lit true_b = b ^ !sol[b.var()];
+            cls.push_back(vector<Lit>{Lit(x, false), true_a});
+            cls.push_back(vector<Lit>{Lit(x, true), true_b});
+            cls.push_back(vector<Lit>{true_a, true_b ^ (rnd() % 2), Lit(y, rnd() % 2)});
+        }
+        add_to_both(num_vars + num_gadgets);
+    }
+
+    void add_to_both(const uint32_t num_vars)
+    {
+        serial = new_solver(1);
+        par = new_solver(4);
+        par2 = new_solver(2);
+        for(Solver* s: {serial, par, par2}) {
+            s->new_vars(num_vars);
+            for(const vector<Lit>& cl: cls) {
+                s->add_clause_outer(cl);
+            }
+        }
+    }
+
+    void check_model(Solver* s) const
+    {
+        const vector<lbool>& model = s->get_model();
+        for(const vector<Lit>& cl: cls) {
+            bool sat = false;
+            for(const Lit l: cl) {
+                sat |= (model[l.var()] ^ l.sign()) == l_True;
+            }
+            EXPECT_TRUE(sat);
+        }
+    }
+
+    static void simplify(Solver* s, const string& schedule)
+    {
+        s->conf.simplify_schedule_nonstartup = schedule;
+        s->simplify_with_assumptions();
+    }
+
+    static void check_same(const Solver* a, const Solver* b)
+    {
+        ASSERT_EQ(a->okay(), b->okay());
+        vector<vector<Lit> > cls_a = get_irred_cls(a);
+        vector<vector<Lit> > cls_b = get_irred_cls(b);
+        check_fuzzy_equal(cls_a, cls_b);
+    }
+
+    vector<vector<Lit> > cls;
+    Solver* serial = NULL;
+    Solver* par = NULL;
+    Solver* par2 = NULL;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(occ_threads, sub_str_same_as_serial)
+{
+    add_cls(400, 15000);
+    const size_t orig = get_irred_cls(serial).size();
+    simplify(serial, "occ-backw-sub-str");
+    simplify(par, "occ-backw-sub-str");
+
+    EXPECT_LT(get_irred_cls(serial).size(), orig);
+    check_same(serial, par);
+}
+
+TEST_F(occ_threads, bve_sat)
+{
+    add_3sat_cls(300, 900, true);
+    for(Solver* s: {serial, par, par2}) {
+        simplify(s, "occ-bve");
+        EXPECT_GT(s->occsimplifier->get_num_elimed_vars(), 0U);
+    }
+    check_same(par, par2);
+
+    //The models must extend to the eliminated vars
+    for(Solver* s: {serial, par}) {
+        EXPECT_EQ(s->solve_with_assumptions(), l_True);
+        check_model(s);
+    }
+}
+
+TEST_F(occ_threads, bve_unsat)
+{
+    add_3sat_cls(100, 600, false);
+    for(Solver* s: {serial, par}) {
+        simplify(s, "occ-bve");
+        EXPECT_GT(s->occsimplifier->get_num_elimed_vars(), 0U);
+        EXPECT_EQ(s->solve_with_assumptions(), l_False);
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
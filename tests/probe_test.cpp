@@ -355,6 +355,75 @@ TEST_F(probe, imp_cache_longer)
     check_impl_cache_contains(s, "5, 1");
 }
 
+TEST_F(probe, imp_cache_far_vars)
+{
+    s->new_vars(300);
+    s->add_clause_outer(str_to_cl("1, 200"));
+    s->add_clause_outer(str_to_cl("-200, 3"));
+    s->add_clause_outer(str_to_cl("-3, 330"));
+
+    vars = str_to_vars("330, 3, 200, 1");
+    p->probe(&vars);
+    check_impl_cache_contains(s, "330, 1");
+    check_impl_cache_contains(s, "330, -200");
+    check_impl_cache_contains(s, "3, 1");
+}
+
+//Parallel
+
+TEST_F(probe, parallel_fail)
+{
+    s->add_clause_outer(str_to_cl("1, -2"));
+    s->add_clause_outer(str_to_cl("1, -3"));
+    s->add_clause_outer(str_to_cl("1, -4"));
+    s->add_clause_outer(str_to_cl("1, -5"));
+    s->add_clause_outer(str_to_cl("2, 3, 4, 5, 6"));
+    s->add_clause_outer(str_to_cl("2, 3, 4, 5, -6"));
+
+    s->conf.probe_threads = 2;
+    s->conf.doBothProp = false;
+    vars = str_to_vars("1, 7");
+    p->probe(&vars);
+
+    //deepest common ancestor
+    check_zero_assigned_lits_eq(s, "1");
+}
+
+TEST_F(probe, parallel_both_prop)
+{
+    s->add_clause_outer(str_to_cl("1, 2"));
+    s->add_clause_outer(str_to_cl("-1, 3"));
+    s->add_clause_outer(str_to_cl("-2, 4"));
+    s->add_clause_outer(str_to_cl("-3, 4"));
+
+    s->conf.probe_threads = 3;
+    s->conf.doBothProp = true;
+    s->conf.otfHyperbin = false;
+    vars = str_to_vars("1, 5, 6");
+    p->probe(&vars);
+    check_zero_assigned_lits_eq(s, "4");
+}
+
+TEST_F(probe, parallel_hyper_bin)
+{
+    s->add_clause_outer(str_to_cl("1, 2"));
+    s->add_clause_outer(str_to_cl("1, 3"));
+    s->add_clause_outer(str_to_cl("1, -4"));
+    s->add_clause_outer(str_to_cl("-2, -3, 4, 5"));
+    s->add_clause_outer(str_to_cl("-5, 6"));
+    s->add_clause_outer(str_to_cl("-5, 7"));
+    s->add_clause_outer(str_to_cl("-5, 8"));
+    s->add_clause_outer(str_to_cl("-6, -7, -8, 9"));
+
+    s->conf.probe_threads = 2;
+    s->conf.doBothProp = false;
+    s->conf.otfHyperbin = true;
+    vars = str_to_vars("1");
+    p->probe(&vars);
+    check_red_cls_contains(s, "1, 5");
+    check_red_cls_contains(s, "-5, 9");
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -26,6 +26,7 @@ THE SOFTWARE.
 
 #include "src/solver.h"
 #include "src/sccfinder.h"
+#include "src/varreplacer.h"
 #include "src/solverconf.h"
 using namespace CMSat;
 #include "test_helper.h"
@@ -132,10 +133,9 @@ TEST(scc_test, find_0)
 }
 
 
-TEST(scc_test, limit_test4)
+TEST(scc_test, circle_3_long)
 {
     SolverConf conf;
-    conf.max_scc_depth = 4;
 
     Solver s(&conf, new std::atomic<bool>(false));
     s.new_vars(4);
@@ -148,36 +148,47 @@ TEST(scc_test, limit_test4)
     EXPECT_EQ(scc.get_binxors().size(), 3);
 }
 
-TEST(scc_test, limit_test3)
+TEST(scc_test, deep_circle)
 {
     SolverConf conf;
-    conf.max_scc_depth = 3;
+    conf.doCache = false;
 
+    //Would overflow the stack with a recursive search
+    const uint32_t num = 300000;
     Solver s(&conf, new std::atomic<bool>(false));
-    s.new_vars(4);
-    s.add_clause_outer(str_to_cl("1, 2"));
-    s.add_clause_outer(str_to_cl("-2, 3"));
-    s.add_clause_outer(str_to_cl("-3, -1"));
+    s.new_vars(num);
+    for(uint32_t i = 0; i < num; i++) {
+        s.add_clause_outer(vector<Lit>{Lit(i, false), Lit((i+1) % num, true)});
+    }
 
     SCCFinder scc(&s);
     scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 0);
+    EXPECT_GE(scc.get_binxors().size(), num-1);
 }
 
-TEST(scc_test, limit_test2)
+TEST(scc_test, only_new_bins_checked)
 {
     SolverConf conf;
-    conf.max_scc_depth = 2;
+    conf.doCache = false;
 
     Solver s(&conf, new std::atomic<bool>(false));
-    s.new_vars(4);
-    s.add_clause_outer(str_to_cl("1, 2"));
-    s.add_clause_outer(str_to_cl("-2, 3"));
-    s.add_clause_outer(str_to_cl("-3, -1"));
+    s.new_vars(6);
+    s.add_clause_outer(str_to_cl("1, -2"));
+    s.add_clause_outer(str_to_cl("4, -5"));
+    s.add_clause_outer(str_to_cl("5, -6"));
 
-    SCCFinder scc(&s);
-    scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 0);
+    SCCFinder* scc = s.varReplacer->get_scc_finder();
+    scc->performSCC();
+    EXPECT_EQ(scc->get_binxors().size(), 0);
+    scc->clear_binxors();
+
+    //Vars 1 and 2 become equivalent, 4, 5 and 6 are not looked at
+    s.add_clause_outer(str_to_cl("-1, 2"));
+    scc->performSCC();
+    EXPECT_EQ(scc->get_binxors().size(), 1);
+    EXPECT_EQ(scc->get_stats().partialCalls, 1);
+    EXPECT_EQ(scc->get_stats().vertices, 12 + 4);
+    scc->clear_binxors();
 }
 
 int main(int argc, char **argv) {
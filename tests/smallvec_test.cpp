@@ -0,0 +1,159 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/smallvec.h"
+#include "src/Vec.h"
+
+using CMSat::smallvec;
+using CMSat::vec;
+
+TEST(smallvec_test, inline_until_full)
+{
+    smallvec<uint32_t, 4> v;
+    EXPECT_TRUE(v.is_inline());
+    for(uint32_t i = 0; i < 4; i++) {
+        v.push(i);
+    }
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.mem_used_heap(), 0u);
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_EQ(v[3], 3u);
+}
+
+TEST(smallvec_test, spill_to_heap)
+{
+    smallvec<uint32_t, 4> v;
+    for(uint32_t i = 0; i < 100; i++) {
+        v.push(i);
+    }
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(v.size(), 100u);
+    for(uint32_t i = 0; i < 100; i++) {
+        EXPECT_EQ(v[i], i);
+    }
+}
+
+TEST(smallvec_test, shrink_to_fit_back_inline)
+{
+    smallvec<uint32_t, 4> v;
+    for(uint32_t i = 0; i < 10; i++) {
+        v.push(i);
+    }
+    v.shrink_(7);
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[0], 0u);
+    EXPECT_EQ(v[2], 2u);
+}
+
+TEST(smallvec_test, swap_inline_and_heap)
+{
+    smallvec<uint32_t, 4> a;
+    smallvec<uint32_t, 4> b;
+    a.push(1);
+    for(uint32_t i = 0; i < 10; i++) {
+        b.push(i);
+    }
+    a.swap(b);
+    EXPECT_EQ(a.size(), 10u);
+    EXPECT_FALSE(a.is_inline());
+    EXPECT_EQ(a[9], 9u);
+    EXPECT_EQ(b.size(), 1u);
+    EXPECT_TRUE(b.is_inline());
+    EXPECT_EQ(b[0], 1u);
+}
+
+TEST(smallvec_test, relocated_by_vec)
+{
+    vec<smallvec<uint32_t, 4> > vs;
+    vs.growTo(2);
+    vs[0].push(5);
+    for(uint32_t i = 0; i < 10; i++) {
+        vs[1].push(i);
+    }
+    vs.growTo(1000);
+    EXPECT_EQ(vs[0].size(), 1u);
+    EXPECT_EQ(vs[0][0], 5u);
+    EXPECT_EQ(vs[1].size(), 10u);
+    EXPECT_EQ(vs[1][9], 9u);
+}
+
+TEST(smallvec_test, borrow_and_overflow)
+{
+    uint32_t mem[8];
+    smallvec<uint32_t, 4> v;
+    v.push(1);
+    v.push(2);
+    v.borrow(mem, 8);
+    EXPECT_TRUE(v.is_borrowed());
+    EXPECT_EQ(v.capacity(), 8u);
+    EXPECT_EQ(v.mem_used_heap(), 0u);
+    EXPECT_EQ(v.begin(), mem);
+    for(uint32_t i = 2; i < 8; i++) {
+        v.push(i+1);
+    }
+    EXPECT_TRUE(v.is_borrowed());
+
+    //Outgrows the slot
+    v.push(9);
+    EXPECT_FALSE(v.is_borrowed());
+    EXPECT_NE(v.begin(), mem);
+    EXPECT_EQ(v.size(), 9u);
+    for(uint32_t i = 0; i < 9; i++) {
+        EXPECT_EQ(v[i], i+1);
+    }
+}
+
+TEST(smallvec_test, unborrow)
+{
+    uint32_t mem[16];
+    smallvec<uint32_t, 4> a;
+    smallvec<uint32_t, 4> b;
+    for(uint32_t i = 0; i < 6; i++) {
+        a.push(i);
+    }
+    b.push(7);
+    a.borrow(mem, 8);
+    b.borrow(mem+8, 8);
+    b.shrink_to_fit();
+    EXPECT_TRUE(b.is_borrowed());
+
+    a.unborrow();
+    b.unborrow();
+    for(uint32_t i = 0; i < 16; i++) {
+        mem[i] = 100;
+    }
+    EXPECT_FALSE(a.is_borrowed());
+    EXPECT_FALSE(a.is_inline());
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_EQ(a[5], 5u);
+    EXPECT_TRUE(b.is_inline());
+    EXPECT_EQ(b[0], 7u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/solver.h"
+#include "src/stampsweeper.h"
+#include "src/solverconf.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct stamp_sweep_test : public ::testing::Test {
+    stamp_sweep_test()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        //conf.verbosity = 20;
+        s = new Solver(&conf, &must_inter);
+        stamp_sweeper = s->stamp_sweeper;
+    }
+    ~stamp_sweep_test()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    StampSweeper* stamp_sweeper;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(stamp_sweep_test, subsume)
+{
+    //1 -> 4 -> 2, so (-1 V 2) subsumes
+    s->new_vars(5);
+    s->add_clause_outer(str_to_cl("-1, 4"));
+    s->add_clause_outer(str_to_cl("-4, 2"));
+    s->add_clause_outer(str_to_cl("-1, 2, 3, 5"));
+
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().subsumedIrred, 1u);
+    check_irred_cls_eq(s, "-1, 4; -4, 2");
+}
+
+TEST_F(stamp_sweep_test, strengthen)
+{
+    //1 -> 4 -> 2, so 1 can be removed
+    s->new_vars(6);
+    s->add_clause_outer(str_to_cl("-1, 4"));
+    s->add_clause_outer(str_to_cl("-4, 2"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 5, 6"));
+
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().litsRemIrred, 1u);
+    check_irred_cls_contains(s, "2, 3, 5, 6");
+    check_irred_cls_doesnt_contain(s, "1, 2, 3, 5, 6");
+}
+
+TEST_F(stamp_sweep_test, red_bins_only_for_red)
+{
+    s->new_vars(7);
+    s->add_clause_outer(str_to_cl("-1, 4"), true);
+    s->add_clause_outer(str_to_cl("-4, 2"), true);
+    s->add_clause_outer(str_to_cl("1, 2, 3, 5"));
+    s->add_clause_outer(str_to_cl("1, 2, 6, 7"), true);
+
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().litsRemIrred, 0u);
+    EXPECT_EQ(stamp_sweeper->get_stats().litsRemRed, 1u);
+    check_irred_cls_contains(s, "1, 2, 3, 5");
+    check_red_cls_contains(s, "2, 6, 7");
+}
+
+TEST_F(stamp_sweep_test, restamp_only_if_changed)
+{
+    s->new_vars(5);
+    s->add_clause_outer(str_to_cl("-1, 4"));
+    s->add_clause_outer(str_to_cl("-4, 2"));
+    s->add_clause_outer(str_to_cl("-1, 2, 3, 5"));
+    s->add_clause_outer(str_to_cl("1, 3, 4, 5"));
+
+    stamp_sweeper->sweep();
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().restamped, 1u);
+
+    s->add_clause_outer(str_to_cl("-2, 3"));
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().restamped, 2u);
+}
+
+TEST_F(stamp_sweep_test, restamp_time_out)
+{
+    s->new_vars(5);
+    s->add_clause_outer(str_to_cl("-1, 4"));
+    s->add_clause_outer(str_to_cl("-4, 2"));
+    s->add_clause_outer(str_to_cl("-1, 2, 3, 5"));
+
+    s->conf.stamp_sweep_time_limitM = 0;
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().restamped, 0u);
+    EXPECT_EQ(stamp_sweeper->get_stats().timeOut, 1u);
+    check_irred_cls_eq(s, "-1, 4; -4, 2; -1, 2, 3, 5");
+
+    //Cut short, so it must restamp next time
+    s->conf.stamp_sweep_time_limitM = 30;
+    stamp_sweeper->sweep();
+    EXPECT_EQ(stamp_sweeper->get_stats().restamped, 1u);
+    check_irred_cls_eq(s, "-1, 4; -4, 2");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
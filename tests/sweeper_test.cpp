@@ -0,0 +1,160 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/solver.h"
+#include "src/sweeper.h"
+#include "src/varreplacer.h"
+#include "src/solverconf.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct sweep_test : public ::testing::Test {
+    sweep_test()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        //conf.verbosity = 20;
+        s = new Solver(&conf, &must_inter);
+        sweeper = s->sweeper;
+    }
+    ~sweep_test()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    Sweeper* sweeper;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(sweep_test, and_gates_eq)
+{
+    //3 = AND(1, 2), 4 = AND(1, 2)
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("-3, 1"));
+    s->add_clause_outer(str_to_cl("-3, 2"));
+    s->add_clause_outer(str_to_cl("3, -1, -2"));
+    s->add_clause_outer(str_to_cl("-4, 1"));
+    s->add_clause_outer(str_to_cl("-4, 2"));
+    s->add_clause_outer(str_to_cl("4, -1, -2"));
+
+    sweeper->sweep();
+    EXPECT_EQ(sweeper->get_stats().andGates, 2u);
+    EXPECT_EQ(sweeper->get_stats().provedEq, 1u);
+    EXPECT_EQ(s->varReplacer->get_num_replaced_vars(), 1u);
+}
+
+TEST_F(sweep_test, and_gates_eq_inverted)
+{
+    //3 = AND(1, 2), 4 = OR(-1, -2)
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("-3, 1"));
+    s->add_clause_outer(str_to_cl("-3, 2"));
+    s->add_clause_outer(str_to_cl("3, -1, -2"));
+    s->add_clause_outer(str_to_cl("4, 1"));
+    s->add_clause_outer(str_to_cl("4, 2"));
+    s->add_clause_outer(str_to_cl("-4, -1, -2"));
+
+    sweeper->sweep();
+    EXPECT_EQ(sweeper->get_stats().provedEq, 1u);
+    EXPECT_EQ(s->varReplacer->get_num_replaced_vars(), 1u);
+}
+
+TEST_F(sweep_test, congruence_through_levels)
+{
+    //3 = AND(1, 2), 4 = AND(1, 2), 5 = AND(3, 1), 6 = AND(4, 1)
+    s->new_vars(6);
+    s->add_clause_outer(str_to_cl("-3, 1"));
+    s->add_clause_outer(str_to_cl("-3, 2"));
+    s->add_clause_outer(str_to_cl("3, -1, -2"));
+    s->add_clause_outer(str_to_cl("-4, 1"));
+    s->add_clause_outer(str_to_cl("-4, 2"));
+    s->add_clause_outer(str_to_cl("4, -1, -2"));
+    s->add_clause_outer(str_to_cl("-5, 3"));
+    s->add_clause_outer(str_to_cl("-5, 1"));
+    s->add_clause_outer(str_to_cl("5, -3, -1"));
+    s->add_clause_outer(str_to_cl("-6, 4"));
+    s->add_clause_outer(str_to_cl("-6, 1"));
+    s->add_clause_outer(str_to_cl("6, -4, -1"));
+
+    sweeper->sweep();
+    EXPECT_EQ(s->varReplacer->get_num_replaced_vars(), 3u);
+}
+
+TEST_F(sweep_test, xor_gates_eq)
+{
+    //3 = 1 XOR 2, 4 = 1 XOR 2
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("-3, 1, 2"));
+    s->add_clause_outer(str_to_cl("-3, -1, -2"));
+    s->add_clause_outer(str_to_cl("3, -1, 2"));
+    s->add_clause_outer(str_to_cl("3, 1, -2"));
+    s->add_clause_outer(str_to_cl("-4, 1, 2"));
+    s->add_clause_outer(str_to_cl("-4, -1, -2"));
+    s->add_clause_outer(str_to_cl("4, -1, 2"));
+    s->add_clause_outer(str_to_cl("4, 1, -2"));
+
+    sweeper->sweep();
+    EXPECT_EQ(sweeper->get_stats().xorGates, 2u);
+    EXPECT_EQ(sweeper->get_stats().provedEq, 1u);
+    EXPECT_EQ(s->varReplacer->get_num_replaced_vars(), 1u);
+}
+
+TEST_F(sweep_test, const_gate)
+{
+    //3 = AND(-1, 2), 4 = AND(1, 3) is always false
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("-3, -1"));
+    s->add_clause_outer(str_to_cl("-3, 2"));
+    s->add_clause_outer(str_to_cl("3, 1, -2"));
+    s->add_clause_outer(str_to_cl("-4, 1"));
+    s->add_clause_outer(str_to_cl("-4, 3"));
+    s->add_clause_outer(str_to_cl("4, -1, -3"));
+
+    sweeper->sweep();
+    EXPECT_EQ(sweeper->get_stats().provedConst, 1u);
+    check_set_lits(s, "-4");
+}
+
+TEST_F(sweep_test, and_or_not_eq)
+{
+    //3 = AND(1, 2), 4 = OR(1, 2)
+    s->new_vars(4);
+    s->add_clause_outer(str_to_cl("-3, 1"));
+    s->add_clause_outer(str_to_cl("-3, 2"));
+    s->add_clause_outer(str_to_cl("3, -1, -2"));
+    s->add_clause_outer(str_to_cl("4, -1"));
+    s->add_clause_outer(str_to_cl("4, -2"));
+    s->add_clause_outer(str_to_cl("-4, 1, 2"));
+
+    sweeper->sweep();
+    EXPECT_EQ(sweeper->get_stats().provedEq, 0u);
+    EXPECT_EQ(s->varReplacer->get_num_replaced_vars(), 0u);
+    EXPECT_EQ(s->okay(), true);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -206,7 +206,9 @@ vector<vector<Lit> > get_irred_cls(const Solver* s)
 vector<vector<Lit> > get_red_cls(const Solver* s)
 {
     vector<vector<Lit> > ret;
-    add_cls(ret, s, s->longRedCls[0]);
+    for(const auto& lredcls: s->longRedCls) {
+        add_cls(ret, s, lredcls);
+    }
     add_impl_cls(ret, s, false, true);
 
     return ret;
@@ -440,7 +442,7 @@ void check_xors_contains(const vector<Xor>& got_data, const std::string& expecte
     EXPECT_TRUE(found);
 }
 
-string print_cache(const vector<LitExtra>& c)
+string print_cache(const CacheLits& c)
 {
     std::stringstream ss;
     for(LitExtra a: c) {
@@ -454,14 +456,14 @@ void check_impl_cache_contains(const Solver* s, const std::string& data)
     vector<Lit> lits = str_to_cl(data);
     assert(lits.size() == 2);
 
-    const vector<LitExtra>& cache_lits = s->implCache[lits[0]].lits;
-    /*cout << "cache[0]: " << print_cache(s->implCache[Lit(0, false)].lits) << endl;
-    cout << "cache[1]: " << print_cache(s->implCache[Lit(1, false)].lits) << endl;
-    cout << "cache[2]: " << print_cache(s->implCache[Lit(2, false)].lits) << endl;
+    const CacheLits cache_lits = s->implCache[lits[0]];
+    /*cout << "cache[0]: " << print_cache(s->implCache[Lit(0, false)]) << endl;
+    cout << "cache[1]: " << print_cache(s->implCache[Lit(1, false)]) << endl;
+    cout << "cache[2]: " << print_cache(s->implCache[Lit(2, false)]) << endl;
 
-    cout << "cache[~0]: " << print_cache(s->implCache[Lit(0, true)].lits) << endl;
-    cout << "cache[~1]: " << print_cache(s->implCache[Lit(1, true)].lits) << endl;
-    cout << "cache[~2]: " << print_cache(s->implCache[Lit(2, true)].lits) << endl;
+    cout << "cache[~0]: " << print_cache(s->implCache[Lit(0, true)]) << endl;
+    cout << "cache[~1]: " << print_cache(s->implCache[Lit(1, true)]) << endl;
+    cout << "cache[~2]: " << print_cache(s->implCache[Lit(2, true)]) << endl;
     */
     bool inside = false;
     for(LitExtra l: cache_lits) {
@@ -477,8 +479,8 @@ void add_to_cache_irred(Solver* s, const string& data)
     assert(lits.size() == 2);
     assert(s->implCache.size() > lits[0].toInt());
     assert(s->implCache.size() > lits[1].toInt());
-    s->implCache[lits[0]].lits.push_back(LitExtra(lits[1], true));
-    s->implCache[lits[1]].lits.push_back(LitExtra(lits[0], true));
+    s->implCache.merge(lits[0], vector<Lit>(), lits[1], false, lits[0].var(), s->seen);
+    s->implCache.merge(lits[1], vector<Lit>(), lits[0], false, lits[1].var(), s->seen);
 }
 
 void add_to_stamp_irred(Solver* s, const string& data)
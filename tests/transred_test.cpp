@@ -0,0 +1,135 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/solver.h"
+#include "src/transred.h"
+#include "src/solverconf.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct trans_red_test : public ::testing::Test {
+    trans_red_test()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        //conf.verbosity = 20;
+        s = new Solver(&conf, &must_inter);
+        trans_red = s->trans_red;
+    }
+    ~trans_red_test()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    TransRed* trans_red;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(trans_red_test, shortcut)
+{
+    s->new_vars(3);
+    s->add_clause_outer(str_to_cl("-1, 2"));
+    s->add_clause_outer(str_to_cl("-2, 3"));
+    s->add_clause_outer(str_to_cl("-1, 3"));
+
+    trans_red->reduce();
+    EXPECT_EQ(trans_red->get_stats().removedIrred, 1u);
+    check_irred_cls_eq(s, "-1, 2; -2, 3");
+}
+
+TEST_F(trans_red_test, red_shortcut)
+{
+    s->new_vars(3);
+    s->add_clause_outer(str_to_cl("-1, 2"));
+    s->add_clause_outer(str_to_cl("-2, 3"));
+    s->add_clause_outer(str_to_cl("-1, 3"), true);
+
+    trans_red->reduce();
+    EXPECT_EQ(trans_red->get_stats().removedRed, 1u);
+    check_irred_cls_eq(s, "-1, 2; -2, 3");
+    check_red_cls_eq(s, "");
+}
+
+TEST_F(trans_red_test, irred_not_through_red)
+{
+    s->new_vars(3);
+    s->add_clause_outer(str_to_cl("-1, 2"), true);
+    s->add_clause_outer(str_to_cl("-2, 3"), true);
+    s->add_clause_outer(str_to_cl("-1, 3"));
+
+    trans_red->reduce();
+    EXPECT_EQ(trans_red->get_stats().removedIrred, 0u);
+    EXPECT_EQ(trans_red->get_stats().removedRed, 0u);
+    check_irred_cls_eq(s, "-1, 3");
+}
+
+TEST_F(trans_red_test, through_scc)
+{
+    //1 = 2, both imply 3
+    s->new_vars(3);
+    s->add_clause_outer(str_to_cl("-1, 2"));
+    s->add_clause_outer(str_to_cl("-2, 1"));
+    s->add_clause_outer(str_to_cl("-1, 3"));
+    s->add_clause_outer(str_to_cl("-2, 3"));
+
+    trans_red->reduce();
+    EXPECT_EQ(trans_red->get_stats().removedIrred, 1u);
+    EXPECT_EQ(s->binTri.irredBins, 3u);
+}
+
+TEST_F(trans_red_test, dense)
+{
+    //Transitive closure of a chain of 10
+    s->new_vars(10);
+    for(uint32_t i = 0; i < 10; i++) {
+        for(uint32_t j = i+1; j < 10; j++) {
+            s->add_clause_outer(vector<Lit>{Lit(i, true), Lit(j, false)});
+        }
+    }
+
+    trans_red->reduce();
+    EXPECT_EQ(trans_red->get_stats().removedIrred, 36u);
+    check_irred_cls_eq(s, "-1, 2; -2, 3; -3, 4; -4, 5; -5, 6; -6, 7; -7, 8; -8, 9; -9, 10");
+}
+
+TEST_F(trans_red_test, long_sparse_chain)
+{
+    s->new_vars(10000);
+    for(uint32_t i = 0; i+1 < 10000; i++) {
+        s->add_clause_outer(vector<Lit>{Lit(i, true), Lit(i+1, false)});
+    }
+    s->add_clause_outer(str_to_cl("-1, 10000"));
+    s->add_clause_outer(str_to_cl("-10, 12"));
+
+    trans_red->reduce();
+    EXPECT_EQ(trans_red->get_stats().removedIrred, 2u);
+    check_irred_cls_doesnt_contain(s, "-1, 10000");
+    check_irred_cls_doesnt_contain(s, "-10, 12");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}